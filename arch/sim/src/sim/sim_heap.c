@@ -613,6 +613,19 @@ struct mallinfo_task mm_mallinfo_task(struct mm_heap_s *heap,
   return info;
 }
 
+/****************************************************************************
+ * Name: mm_fraginfo
+ *
+ * Description:
+ *   The host heap doesn't expose its free chunks, report nothing.
+ *
+ ****************************************************************************/
+
+void mm_fraginfo(struct mm_heap_s *heap, struct mm_fraginfo_s *info)
+{
+  memset(info, 0, sizeof(struct mm_fraginfo_s));
+}
+
 /****************************************************************************
  * Name: mm_memdump
  *
@@ -36,9 +36,13 @@
 #include <nuttx/kthread.h>
 #include <nuttx/mm/iob.h>
 #include <nuttx/net/can.h>
+#include <nuttx/net/icmp.h>
+#include <nuttx/net/icmpv6.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/netdev_lowerhalf.h>
 #include <nuttx/net/pkt.h>
+#include <nuttx/net/tcp.h>
+#include <nuttx/net/udp.h>
 #include <nuttx/net/vlan.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/spinlock.h>
@@ -63,6 +67,22 @@ struct netdev_vlan_entry_s
 };
 #endif
 
+#ifdef CONFIG_NETDEV_GRO
+/* The TCP segment that the following in-order segments of the same flow
+ * are coalesced into while draining the lower half.
+ */
+
+struct netdev_gro_s
+{
+  FAR netpkt_t *head;    /* The segment held back, NULL if none */
+  uint32_t      nextseq; /* Sequence number of the next in-order segment */
+  uint16_t      csum;    /* Sum of the payloads, from the TCP checksums */
+  uint16_t      nsegs;   /* Number of segments coalesced into head */
+  uint8_t       iplen;   /* Size of the IP header of the flow */
+  uint8_t       flags;   /* TCP flags of the last segment coalesced */
+};
+#endif
+
 struct netdev_thread_s
 {
   pid_t tid;
@@ -102,6 +122,9 @@ struct netdev_upperhalf_s
  ****************************************************************************/
 
 static int netdev_upper_txavail(FAR struct net_driver_s *dev);
+#ifdef CONFIG_NET_TCP_GSO
+static int netdev_upper_txpoll(FAR struct net_driver_s *dev);
+#endif
 
 /****************************************************************************
  * Private Functions
@@ -255,6 +278,64 @@ static inline bool netdev_upper_can_tx(FAR struct netdev_upperhalf_s *upper)
   return quota > 0;
 }
 
+#ifdef CONFIG_NET_TCP_GSO
+/****************************************************************************
+ * Name: netdev_upper_txseg
+ *
+ * Description:
+ *   Send one segment of an oversized TCP packet.  The segments beyond the
+ *   TX quota of the lower half are queued to txq, and sent first by the
+ *   next netdev_upper_tx() once the lower half reports txdone.
+ *
+ * Input Parameters:
+ *   dev - Reference to the NuttX driver state structure
+ *
+ * Returned Value:
+ *   Negated errno value - Error number that occurs.
+ *   NETDEV_TX_CONTINUE  - The segment was sent or queued.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+static int netdev_upper_txseg(FAR struct net_driver_s *dev)
+{
+  FAR struct netdev_upperhalf_s *upper = dev->d_private;
+  int ret;
+
+#if CONFIG_IOB_NCHAINS > 0
+  /* Keep the order of the segments once one of them is queued */
+
+  if (IOB_QEMPTY(&upper->txq) && netdev_upper_can_tx(upper))
+    {
+      return netdev_upper_txpoll(dev);
+    }
+
+  ret = iob_tryadd_queue(dev->d_iob, &upper->txq);
+  if (ret >= 0)
+    {
+      netdev_iob_clear(dev);
+      return NETDEV_TX_CONTINUE;
+    }
+#else
+  if (netdev_upper_can_tx(upper))
+    {
+      return netdev_upper_txpoll(dev);
+    }
+
+  ret = -EBUSY;
+#endif
+
+  /* The rest of the packet is dropped and retransmitted by TCP */
+
+  NETDEV_TXERRORS(dev);
+  nwarn("WARNING: Failed to queue TCP segment, dropping: %d\n", ret);
+  netdev_iob_release(dev);
+  return ret;
+}
+#endif
+
 /****************************************************************************
  * Name: netdev_upper_txpoll
  *
@@ -289,6 +370,17 @@ static int netdev_upper_txpoll(FAR struct net_driver_s *dev)
 
   DEBUGASSERT(dev->d_len > 0);
 
+#ifdef CONFIG_NET_TCP_GSO
+  /* Split an oversized TCP packet into segments, each of them comes back
+   * here on its own as long as the TX quota allows.
+   */
+
+  if (dev->d_gso_size > 0 && (dev->d_features & NETDEV_TSO) == 0)
+    {
+      return tcp_gso_segment(dev, netdev_upper_txseg);
+    }
+#endif
+
   NETDEV_TXPACKETS(dev);
 
 #ifdef CONFIG_NET_PKT
@@ -299,7 +391,11 @@ static int netdev_upper_txpoll(FAR struct net_driver_s *dev)
 
   pkt = netpkt_get(dev, NETPKT_TX);
 
-  if (netpkt_getdatalen(lower, pkt) > NETDEV_PKTSIZE(dev))
+  if (netpkt_getdatalen(lower, pkt) > NETDEV_PKTSIZE(dev)
+#ifdef CONFIG_NET_TCP_GSO
+      && dev->d_gso_size == 0
+#endif
+     )
     {
       nerr("ERROR: Packet too long to send!\n");
       ret = -EMSGSIZE;
@@ -687,6 +783,468 @@ static void ip_input(FAR struct net_driver_s *dev)
 }
 #endif
 
+/****************************************************************************
+ * Name: netdev_upper_input
+ *
+ * Description:
+ *   Pass the packet in d_iob to the input logic of its link type.
+ *
+ * Input Parameters:
+ *   dev - Reference to the NuttX network driver state structure
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+static void netdev_upper_input(FAR struct net_driver_s *dev)
+{
+  switch (dev->d_lltype)
+    {
+#ifdef CONFIG_NET_LOOPBACK
+      case NET_LL_LOOPBACK:
+#endif
+#ifdef CONFIG_NET_ETHERNET
+      case NET_LL_ETHERNET:
+#endif
+#ifdef CONFIG_DRIVERS_IEEE80211
+      case NET_LL_IEEE80211:
+#endif
+#if defined(CONFIG_NET_LOOPBACK) || defined(CONFIG_NET_ETHERNET) || \
+    defined(CONFIG_DRIVERS_IEEE80211)
+        eth_input(dev);
+        break;
+#endif
+#ifdef CONFIG_NET_MBIM
+      case NET_LL_MBIM:
+        ip_input(dev);
+        break;
+#endif
+#ifdef CONFIG_NET_CAN
+      case NET_LL_CAN:
+        ninfo("CAN frame");
+        can_input(dev);
+        break;
+#endif
+      default:
+        nerr("Unknown link type %d\n", dev->d_lltype);
+        break;
+    }
+}
+
+#ifdef CONFIG_NETDEV_GRO
+/****************************************************************************
+ * Name: netdev_gro_getseq
+ *
+ * Description:
+ *   Get the TCP sequence number in host order.
+ *
+ ****************************************************************************/
+
+static inline uint32_t netdev_gro_getseq(FAR const uint8_t *seqno)
+{
+  return ((uint32_t)seqno[0] << 24) | ((uint32_t)seqno[1] << 16) |
+         ((uint32_t)seqno[2] << 8) | seqno[3];
+}
+
+/****************************************************************************
+ * Name: netdev_gro_csum_add
+ *
+ * Description:
+ *   One's complement addition of two partial checksums.
+ *
+ ****************************************************************************/
+
+static inline uint16_t netdev_gro_csum_add(uint16_t a, uint16_t b)
+{
+  uint32_t sum = (uint32_t)a + b;
+
+  return (sum & 0xffff) + (sum >> 16);
+}
+
+/****************************************************************************
+ * Name: netdev_gro_hdrsum
+ *
+ * Description:
+ *   Sum the TCP pseudo header and the TCP header (including the checksum
+ *   field) of a packet.  As the checksum of a valid segment sums up to
+ *   0xffff, the complement of this is the sum of its payload, which lets
+ *   the checksum of coalesced segments be made up from their headers only.
+ *   A corrupted segment still yields a bad checksum after coalescing.
+ *
+ ****************************************************************************/
+
+static uint16_t netdev_gro_hdrsum(FAR netpkt_t *pkt, unsigned int iplen,
+                                  FAR struct tcp_hdr_s *tcp)
+{
+  FAR uint8_t *ip = IOB_DATA(pkt);
+  uint16_t sum = pkt->io_pktlen - iplen + IP_PROTO_TCP;
+
+#ifdef CONFIG_NET_IPv4
+  if ((ip[0] & IP_VERSION_MASK) == IPv4_VERSION)
+    {
+      FAR struct ipv4_hdr_s *ipv4 = (FAR struct ipv4_hdr_s *)ip;
+
+      sum = chksum(sum, (FAR uint8_t *)ipv4->srcipaddr,
+                   2 * sizeof(in_addr_t));
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv6
+  if ((ip[0] & IP_VERSION_MASK) == IPv6_VERSION)
+    {
+      FAR struct ipv6_hdr_s *ipv6 = (FAR struct ipv6_hdr_s *)ip;
+
+      sum = chksum(sum, (FAR uint8_t *)ipv6->srcipaddr,
+                   2 * sizeof(net_ipv6addr_t));
+    }
+#endif
+
+  return chksum(sum, (FAR uint8_t *)tcp, (tcp->tcpoffset >> 4) << 2);
+}
+
+/****************************************************************************
+ * Name: netdev_gro_tcp
+ *
+ * Description:
+ *   Check whether a received packet may be coalesced: an Ethernet frame
+ *   with an unfragmented IPv4 packet without options or an IPv6 packet
+ *   without extension headers, carrying a TCP segment with payload and no
+ *   other flag than ACK and PSH.  A segment with ECE or CWR set is passed
+ *   on alone, so that its congestion signal is not lost or repeated over
+ *   the coalesced segments.  Only the packets addressed to the device
+ *   itself are coalesced, a forwarded one must keep its size to pass the
+ *   MTU of the next hop.
+ *
+ * Input Parameters:
+ *   dev   - Reference to the NuttX network driver state structure
+ *   pkt   - The received packet
+ *   iplen - Location to return the size of the IP header
+ *
+ * Returned Value:
+ *   The TCP header of the packet, or NULL if it can not be coalesced.
+ *
+ ****************************************************************************/
+
+static FAR struct tcp_hdr_s *
+netdev_gro_tcp(FAR struct net_driver_s *dev, FAR netpkt_t *pkt,
+               FAR unsigned int *iplen)
+{
+  FAR struct eth_hdr_s *eth = (FAR struct eth_hdr_s *)NETLLBUF;
+  FAR uint8_t *ip = IOB_DATA(pkt);
+  FAR struct tcp_hdr_s *tcp;
+  unsigned int hdrlen;
+  unsigned int len = 0;
+
+  if (dev->d_lltype != NET_LL_ETHERNET)
+    {
+      return NULL;
+    }
+
+#ifdef CONFIG_NET_IPv4
+  if (eth->type == HTONS(ETHTYPE_IP))
+    {
+      FAR struct ipv4_hdr_s *ipv4 = (FAR struct ipv4_hdr_s *)ip;
+
+      if (pkt->io_len < IPv4_HDRLEN + TCP_HDRLEN ||
+          ipv4->vhl != (IPv4_VERSION | (IPv4_HDRLEN >> 2)) ||
+          ipv4->proto != IP_PROTO_TCP ||
+          (ipv4->ipoffset[0] & ~(IP_FLAG_DONTFRAG >> 8)) != 0 ||
+          ipv4->ipoffset[1] != 0 ||
+          !net_ipv4addr_cmp(net_ip4addr_conv32(ipv4->destipaddr),
+                            dev->d_ipaddr))
+        {
+          return NULL;
+        }
+
+      *iplen = IPv4_HDRLEN;
+      len    = ((uint16_t)ipv4->len[0] << 8) + ipv4->len[1];
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv6
+  if (eth->type == HTONS(ETHTYPE_IP6))
+    {
+      FAR struct ipv6_hdr_s *ipv6 = (FAR struct ipv6_hdr_s *)ip;
+
+      if (pkt->io_len < IPv6_HDRLEN + TCP_HDRLEN ||
+          (ipv6->vtc & IP_VERSION_MASK) != IPv6_VERSION ||
+          ipv6->proto != IP_PROTO_TCP ||
+          !NETDEV_IS_MY_V6ADDR(dev, ipv6->destipaddr))
+        {
+          return NULL;
+        }
+
+      *iplen = IPv6_HDRLEN;
+      len    = IPv6_HDRLEN + ((uint16_t)ipv6->len[0] << 8) + ipv6->len[1];
+    }
+#endif
+
+  /* The IP length must match the frame, which is not padded then */
+
+  if (len == 0 || len != pkt->io_pktlen)
+    {
+      return NULL;
+    }
+
+  tcp    = (FAR struct tcp_hdr_s *)(ip + *iplen);
+  hdrlen = *iplen + ((tcp->tcpoffset >> 4) << 2);
+
+  if ((tcp->flags & ~TCP_PSH) != TCP_ACK ||
+      hdrlen < *iplen + TCP_HDRLEN || hdrlen > pkt->io_len ||
+      hdrlen >= len)
+    {
+      return NULL;
+    }
+
+  return tcp;
+}
+
+/****************************************************************************
+ * Name: netdev_gro_match
+ *
+ * Description:
+ *   Check whether the segment continues the one held back in sequence and
+ *   belongs to the same flow, with identical headers otherwise.
+ *
+ ****************************************************************************/
+
+static bool netdev_gro_match(FAR struct netdev_gro_s *gro,
+                             FAR netpkt_t *pkt, unsigned int iplen,
+                             FAR struct tcp_hdr_s *tcp)
+{
+  FAR uint8_t *hip = IOB_DATA(gro->head);
+  FAR uint8_t *ip = IOB_DATA(pkt);
+  FAR struct tcp_hdr_s *htcp = (FAR struct tcp_hdr_s *)(hip + iplen);
+  unsigned int tcplen = (tcp->tcpoffset >> 4) << 2;
+  unsigned int paylen = gro->head->io_pktlen - iplen - tcplen;
+
+  /* The segment held back must not have been pushed, must carry the same
+   * flags otherwise, must be of even length to keep the payload sums
+   * aligned and must have room left.
+   */
+
+  if ((gro->flags & TCP_PSH) != 0 ||
+      (gro->flags & ~TCP_PSH) != (tcp->flags & ~TCP_PSH) ||
+      (paylen & 1) != 0 ||
+      iplen != gro->iplen ||
+      gro->head->io_pktlen + pkt->io_pktlen - iplen - tcplen >
+      CONFIG_NETDEV_GRO_MAXSIZE)
+    {
+      return false;
+    }
+
+  /* Same link layer addresses, same IP header except for the length, the
+   * ID and the checksum.
+   */
+
+  if (memcmp(hip - ETH_HDRLEN, ip - ETH_HDRLEN, ETH_HDRLEN) != 0)
+    {
+      return false;
+    }
+
+#ifdef CONFIG_NET_IPv4
+  if ((ip[0] & IP_VERSION_MASK) == IPv4_VERSION)
+    {
+      FAR struct ipv4_hdr_s *hipv4 = (FAR struct ipv4_hdr_s *)hip;
+      FAR struct ipv4_hdr_s *ipv4 = (FAR struct ipv4_hdr_s *)ip;
+
+      if (hipv4->tos != ipv4->tos || hipv4->ttl != ipv4->ttl ||
+          memcmp(hipv4->srcipaddr, ipv4->srcipaddr,
+                 2 * sizeof(in_addr_t)) != 0)
+        {
+          return false;
+        }
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv6
+  if ((ip[0] & IP_VERSION_MASK) == IPv6_VERSION)
+    {
+      FAR struct ipv6_hdr_s *hipv6 = (FAR struct ipv6_hdr_s *)hip;
+      FAR struct ipv6_hdr_s *ipv6 = (FAR struct ipv6_hdr_s *)ip;
+
+      if (hipv6->vtc != ipv6->vtc || hipv6->tcf != ipv6->tcf ||
+          hipv6->flow != ipv6->flow || hipv6->ttl != ipv6->ttl ||
+          memcmp(hipv6->srcipaddr, ipv6->srcipaddr,
+                 2 * sizeof(net_ipv6addr_t)) != 0)
+        {
+          return false;
+        }
+    }
+#endif
+
+  /* Same ports, acknowledgement, window and options, next in sequence */
+
+  return htcp->srcport == tcp->srcport && htcp->destport == tcp->destport &&
+         memcmp(htcp->ackno, tcp->ackno, 4) == 0 &&
+         htcp->tcpoffset == tcp->tcpoffset &&
+         memcmp(htcp->wnd, tcp->wnd, 2) == 0 &&
+         memcmp(htcp->optdata, tcp->optdata, tcplen - TCP_HDRLEN) == 0 &&
+         netdev_gro_getseq(tcp->seqno) == gro->nextseq;
+}
+
+/****************************************************************************
+ * Name: netdev_gro_finish
+ *
+ * Description:
+ *   Update the IP length, the TCP flags and the checksums of the segment
+ *   that others have been coalesced into.
+ *
+ ****************************************************************************/
+
+static void netdev_gro_finish(FAR struct netdev_gro_s *gro)
+{
+  FAR netpkt_t *head = gro->head;
+  FAR uint8_t *ip = IOB_DATA(head);
+  FAR struct tcp_hdr_s *tcp = (FAR struct tcp_hdr_s *)(ip + gro->iplen);
+  uint16_t sum;
+
+#ifdef CONFIG_NET_IPv4
+  if ((ip[0] & IP_VERSION_MASK) == IPv4_VERSION)
+    {
+      FAR struct ipv4_hdr_s *ipv4 = (FAR struct ipv4_hdr_s *)ip;
+
+      ipv4->len[0]   = head->io_pktlen >> 8;
+      ipv4->len[1]   = head->io_pktlen & 0xff;
+      ipv4->ipchksum = 0;
+      ipv4->ipchksum = ~ipv4_chksum(ipv4);
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv6
+  if ((ip[0] & IP_VERSION_MASK) == IPv6_VERSION)
+    {
+      FAR struct ipv6_hdr_s *ipv6 = (FAR struct ipv6_hdr_s *)ip;
+
+      ipv6->len[0] = (head->io_pktlen - IPv6_HDRLEN) >> 8;
+      ipv6->len[1] = (head->io_pktlen - IPv6_HDRLEN) & 0xff;
+    }
+#endif
+
+  tcp->flags     = gro->flags;
+  tcp->tcpchksum = 0;
+
+  sum = netdev_gro_csum_add(netdev_gro_hdrsum(head, gro->iplen, tcp),
+                            gro->csum);
+  tcp->tcpchksum = HTONS((uint16_t)~sum);
+}
+
+/****************************************************************************
+ * Name: netdev_upper_gro_flush
+ *
+ * Description:
+ *   Pass the segment held back to the network, the packet in d_iob (if
+ *   any) is put back afterwards.
+ *
+ * Input Parameters:
+ *   dev - Reference to the NuttX network driver state structure
+ *   gro - The coalescing state
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+static void netdev_upper_gro_flush(FAR struct net_driver_s *dev,
+                                   FAR struct netdev_gro_s *gro)
+{
+  FAR netpkt_t *pkt = dev->d_iob;
+
+  if (gro->head == NULL)
+    {
+      return;
+    }
+
+  if (gro->nsegs > 1)
+    {
+      netdev_gro_finish(gro);
+    }
+
+  netdev_iob_clear(dev);
+  netdev_iob_replace_l2(dev, gro->head);
+  gro->head = NULL;
+
+  netdev_upper_input(dev);
+
+  if (pkt != NULL)
+    {
+      netdev_iob_replace_l2(dev, pkt);
+    }
+}
+
+/****************************************************************************
+ * Name: netdev_upper_gro
+ *
+ * Description:
+ *   Coalesce the TCP segment in d_iob with the segment held back, or hold
+ *   it back itself.  Anything else flushes the held segment first so that
+ *   packets are not reordered.
+ *
+ * Input Parameters:
+ *   dev - Reference to the NuttX network driver state structure
+ *   gro - The coalescing state
+ *
+ * Returned Value:
+ *   True if the packet was taken over, false if it is still in d_iob and
+ *   has to be passed to the network.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+static bool netdev_upper_gro(FAR struct net_driver_s *dev,
+                             FAR struct netdev_gro_s *gro)
+{
+  FAR netpkt_t *pkt = dev->d_iob;
+  FAR struct tcp_hdr_s *tcp;
+  unsigned int hdrlen;
+  unsigned int iplen;
+
+  tcp = netdev_gro_tcp(dev, pkt, &iplen);
+  if (tcp == NULL)
+    {
+      netdev_upper_gro_flush(dev, gro);
+      return false;
+    }
+
+  hdrlen = iplen + ((tcp->tcpoffset >> 4) << 2);
+
+  if (gro->head != NULL && netdev_gro_match(gro, pkt, iplen, tcp))
+    {
+      gro->csum     = netdev_gro_csum_add(gro->csum,
+                        ~netdev_gro_hdrsum(pkt, iplen, tcp));
+      gro->nextseq += pkt->io_pktlen - hdrlen;
+      gro->flags    = tcp->flags;
+      gro->nsegs++;
+
+      /* Chain the payload to the held segment.  With the IOB size
+       * classes, iob_concat() copies it into a large tail buffer that has
+       * room left instead.  The checksum is never computed over it.
+       */
+
+      netdev_iob_clear(dev);
+      iob_concat(gro->head, iob_trimhead(pkt, hdrlen));
+      return true;
+    }
+
+  /* Start over from this segment */
+
+  netdev_upper_gro_flush(dev, gro);
+
+  gro->head    = pkt;
+  gro->nextseq = netdev_gro_getseq(tcp->seqno) + pkt->io_pktlen - hdrlen;
+  gro->csum    = ~netdev_gro_hdrsum(pkt, iplen, tcp);
+  gro->nsegs   = 1;
+  gro->iplen   = iplen;
+  gro->flags   = tcp->flags;
+
+  netdev_iob_clear(dev);
+  return true;
+}
+#endif /* CONFIG_NETDEV_GRO */
+
 /****************************************************************************
  * Function: netdev_upper_rxpoll_work
  *
@@ -707,6 +1265,11 @@ static void netdev_upper_rxpoll_work(FAR struct netdev_upperhalf_s *upper)
   FAR struct netdev_lowerhalf_s *lower = upper->lower;
   FAR struct net_driver_s       *dev   = &lower->netdev;
   FAR netpkt_t                  *pkt;
+#ifdef CONFIG_NETDEV_GRO
+  struct netdev_gro_s            gro;
+
+  gro.head = NULL;
+#endif
 
   /* Loop while receive() successfully retrieves valid Ethernet frames. */
 
@@ -732,39 +1295,23 @@ static void netdev_upper_rxpoll_work(FAR struct netdev_upperhalf_s *upper)
       pkt_input(dev);
 #endif
 
-      switch (dev->d_lltype)
+#ifdef CONFIG_NETDEV_GRO
+      /* Hold TCP segments back to coalesce them with the following ones */
+
+      if (netdev_upper_gro(dev, &gro))
         {
-#ifdef CONFIG_NET_LOOPBACK
-        case NET_LL_LOOPBACK:
-#endif
-#ifdef CONFIG_NET_ETHERNET
-        case NET_LL_ETHERNET:
-#endif
-#ifdef CONFIG_DRIVERS_IEEE80211
-        case NET_LL_IEEE80211:
-#endif
-#if defined(CONFIG_NET_LOOPBACK) || defined(CONFIG_NET_ETHERNET) || \
-    defined(CONFIG_DRIVERS_IEEE80211)
-          eth_input(dev);
-          break;
-#endif
-#ifdef CONFIG_NET_MBIM
-        case NET_LL_MBIM:
-          ip_input(dev);
-          break;
-#endif
-#ifdef CONFIG_NET_CAN
-        case NET_LL_CAN:
-          ninfo("CAN frame");
-          can_input(dev);
-          break;
-#endif
-        default:
-          nerr("Unknown link type %d\n", dev->d_lltype);
-          break;
+          continue;
         }
+#endif
+
+      netdev_upper_input(dev);
     }
 
+#ifdef CONFIG_NETDEV_GRO
+  netdev_iob_release(dev);
+  netdev_upper_gro_flush(dev, &gro);
+#endif
+
   netdev_unlock(dev);
 }
 
@@ -1431,6 +1978,14 @@ int netdev_lower_register(FAR struct netdev_lowerhalf_s *dev,
 #endif
   dev->netdev.d_private = upper;
 
+#ifdef CONFIG_NET_TCP_GSO
+  /* Oversized TCP packets are split into segments by netdev_upper_txpoll,
+   * unless the lower half advertises NETDEV_TSO.
+   */
+
+  dev->netdev.d_features |= NETDEV_GSO;
+#endif
+
   ret = netdev_register(&dev->netdev, lltype);
   if (ret < 0)
     {
@@ -1969,3 +2524,130 @@ int netpkt_to_iov(FAR struct netdev_lowerhalf_s *dev, FAR netpkt_t *pkt,
 
   return i;
 }
+
+/****************************************************************************
+ * Name: netpkt_csum_partial
+ *
+ * Description:
+ *   Prepare an outgoing packet for a device with NETDEV_TX_CSUM_PARTIAL,
+ *   which sums the packet from the start offset to its end and stores the
+ *   complement at start + offset.  The sum of the pseudo header is stored
+ *   into the checksum field of the TCP, UDP, ICMP or ICMPv6 header.
+ *
+ * Input Parameters:
+ *   dev    - The lower half device driver structure
+ *   pkt    - The net packet
+ *   start  - Returns the offset of the upper layer header in the frame
+ *   offset - Returns the offset of the checksum in the upper layer header
+ *
+ * Returned Value:
+ *   OK on success, a negated errno value if the packet has no checksum to
+ *   be completed by the device.
+ *
+ ****************************************************************************/
+
+int netpkt_csum_partial(FAR struct netdev_lowerhalf_s *dev,
+                        FAR netpkt_t *pkt, FAR uint16_t *start,
+                        FAR uint16_t *offset)
+{
+  FAR uint8_t *ip = IOB_DATA(pkt);
+  FAR uint8_t *field;
+  unsigned int iplen;
+  uint16_t sum = 0;
+  uint8_t proto;
+
+  if (pkt->io_len < 1)
+    {
+      return -EINVAL;
+    }
+
+#ifdef CONFIG_NET_IPv4
+  if ((ip[0] & IP_VERSION_MASK) == IPv4_VERSION)
+    {
+      FAR struct ipv4_hdr_s *ipv4 = (FAR struct ipv4_hdr_s *)ip;
+
+      /* A fragment does not carry the whole upper layer payload */
+
+      iplen = (ipv4->vhl & IPv4_HLMASK) << 2;
+      if (iplen > pkt->io_len ||
+          (ipv4->ipoffset[0] & ~(IP_FLAG_DONTFRAG >> 8)) != 0 ||
+          ipv4->ipoffset[1] != 0)
+        {
+          return -EINVAL;
+        }
+
+      /* ICMP has no pseudo header */
+
+      proto = ipv4->proto;
+      if (proto != IP_PROTO_ICMP)
+        {
+          sum = ((uint16_t)ipv4->len[0] << 8) + ipv4->len[1] - iplen +
+                proto;
+          sum = chksum(sum, (FAR uint8_t *)ipv4->srcipaddr,
+                       2 * sizeof(in_addr_t));
+        }
+    }
+  else
+#endif
+#ifdef CONFIG_NET_IPv6
+  if ((ip[0] & IP_VERSION_MASK) == IPv6_VERSION)
+    {
+      FAR struct ipv6_hdr_s *ipv6 = (FAR struct ipv6_hdr_s *)ip;
+
+      /* Packets with extension headers are not offloaded */
+
+      iplen = IPv6_HDRLEN;
+      if (iplen > pkt->io_len)
+        {
+          return -EINVAL;
+        }
+
+      proto = ipv6->proto;
+      sum   = ((uint16_t)ipv6->len[0] << 8) + ipv6->len[1] + proto;
+      sum   = chksum(sum, (FAR uint8_t *)ipv6->srcipaddr,
+                     2 * sizeof(net_ipv6addr_t));
+    }
+  else
+#endif
+    {
+      return -EINVAL;
+    }
+
+  switch (proto)
+    {
+#ifdef CONFIG_NET_TCP
+      case IP_PROTO_TCP:
+        *offset = offsetof(struct tcp_hdr_s, tcpchksum);
+        break;
+#endif
+#ifdef CONFIG_NET_UDP
+      case IP_PROTO_UDP:
+        *offset = offsetof(struct udp_hdr_s, udpchksum);
+        break;
+#endif
+#ifdef CONFIG_NET_ICMP
+      case IP_PROTO_ICMP:
+        *offset = offsetof(struct icmp_hdr_s, icmpchksum);
+        break;
+#endif
+#ifdef CONFIG_NET_ICMPv6
+      case IP_PROTO_ICMP6:
+        *offset = offsetof(struct icmpv6_hdr_s, chksum);
+        break;
+#endif
+      default:
+        return -EINVAL;
+    }
+
+  if (iplen + *offset + sizeof(uint16_t) > pkt->io_len)
+    {
+      return -EINVAL;
+    }
+
+  field    = ip + iplen + *offset;
+  field[0] = sum >> 8;
+  field[1] = sum & 0xff;
+
+  *start = NET_LL_HDRLEN(&dev->netdev) + iplen;
+  return OK;
+}
@@ -45,8 +45,13 @@
 
 /* Virtio net feature bits */
 
+#define VIRTIO_NET_F_CSUM     0
 #define VIRTIO_NET_F_MAC      5
 
+/* Virtio net header flags */
+
+#define VIRTIO_NET_HDR_F_NEEDS_CSUM 1
+
 /* Virtio net header size and packet buffer size */
 
 #define VIRTIO_NET_HDRSIZE    (sizeof(struct virtio_net_hdr_s))
@@ -68,8 +73,8 @@
  * Private Types
  ****************************************************************************/
 
-/* Virtio net header, just define it here for further, now only use it
- * to calculate the virto net header size, see marco VIRTIO_NET_HDRSIZE
+/* Virtio net header, only the checksum offload fields are used for now,
+ * see marco VIRTIO_NET_HDRSIZE for the header size.
  */
 
 begin_packed_struct struct virtio_net_hdr_s
@@ -218,6 +223,8 @@ static int virtio_net_addbuffer(FAR struct netdev_lowerhalf_s *dev,
   FAR struct virtio_net_llhdr_s *hdr;
   struct virtqueue_buf vb[VIRTIO_NET_MAX_NIOB + 1];
   struct iovec iov[VIRTIO_NET_MAX_NIOB];
+  uint16_t csum_offset;
+  uint16_t csum_start;
   int iov_cnt;
   int i;
 
@@ -233,6 +240,17 @@ static int virtio_net_addbuffer(FAR struct netdev_lowerhalf_s *dev,
   memset(&hdr->vhdr, 0, sizeof(hdr->vhdr));
   hdr->pkt = pkt;
 
+  /* Let the device complete the checksum of the outgoing packet */
+
+  if (vq_id == VIRTIO_NET_TX &&
+      (dev->netdev.d_features & NETDEV_TX_CSUM_PARTIAL) != 0 &&
+      netpkt_csum_partial(dev, pkt, &csum_start, &csum_offset) >= 0)
+    {
+      hdr->vhdr.flags       = VIRTIO_NET_HDR_F_NEEDS_CSUM;
+      hdr->vhdr.csum_start  = csum_start;
+      hdr->vhdr.csum_offset = csum_offset;
+    }
+
   /* Prepare buffers depends on the feature VIRTIO_F_ANY_LAYOUT */
 
   if (virtio_has_feature(priv->vdev, VIRTIO_F_ANY_LAYOUT))
@@ -571,7 +589,8 @@ static int virtio_net_init(FAR struct virtio_net_priv_s *priv,
   /* Initialize the virtio device */
 
   virtio_set_status(vdev, VIRTIO_CONFIG_STATUS_DRIVER);
-  virtio_negotiate_features(vdev, (1UL << VIRTIO_NET_F_MAC) |
+  virtio_negotiate_features(vdev, (1UL << VIRTIO_NET_F_CSUM) |
+                                  (1UL << VIRTIO_NET_F_MAC) |
                                   (1UL << VIRTIO_F_ANY_LAYOUT), NULL);
   virtio_set_status(vdev, VIRTIO_CONFIG_FEATURES_OK);
 
@@ -661,6 +680,13 @@ static int virtio_net_probe(FAR struct virtio_device *vdev)
   netdev->quota[NETPKT_TX] = priv->bufnum;
   netdev->ops = &g_virtio_net_ops;
 
+  /* The device completes the checksums from a partial sum */
+
+  if (virtio_has_feature(vdev, VIRTIO_NET_F_CSUM))
+    {
+      netdev->netdev.d_features |= NETDEV_TX_CSUM | NETDEV_TX_CSUM_PARTIAL;
+    }
+
 #ifdef CONFIG_DRIVERS_WIFI_SIM
   /* If the WiFi interfaces has reached the setting value,
    * no more WiFi interfaces will be created.
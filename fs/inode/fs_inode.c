@@ -41,7 +41,12 @@
  * Private Data
  ****************************************************************************/
 
-static rw_semaphore_t g_inode_lock = RWSEM_INITIALIZER;
+/* The inode tree is looked up on every open and stat, but rarely modified,
+ * so a per-CPU read-write-lock keeps concurrent lookups from bouncing the
+ * lock between CPUs.
+ */
+
+static percpu_rw_semaphore_t g_inode_lock = PERCPU_RWSEM_INITIALIZER;
 
 /****************************************************************************
  * Public Functions
@@ -73,7 +78,7 @@ void inode_initialize(void)
 
 void inode_lock(void)
 {
-  down_write(&g_inode_lock);
+  percpu_down_write(&g_inode_lock);
 }
 
 /****************************************************************************
@@ -86,7 +91,7 @@ void inode_lock(void)
 
 void inode_rlock(void)
 {
-  down_read(&g_inode_lock);
+  percpu_down_read(&g_inode_lock);
 }
 
 /****************************************************************************
@@ -99,7 +104,7 @@ void inode_rlock(void)
 
 void inode_unlock(void)
 {
-  up_write(&g_inode_lock);
+  percpu_up_write(&g_inode_lock);
 }
 
 /****************************************************************************
@@ -112,5 +117,5 @@ void inode_unlock(void)
 
 void inode_runlock(void)
 {
-  up_read(&g_inode_lock);
+  percpu_up_read(&g_inode_lock);
 }
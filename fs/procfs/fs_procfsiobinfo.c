@@ -223,6 +223,35 @@ static ssize_t iobinfo_read(FAR struct file *filep, FAR char *buffer,
                              &offset);
   totalsize += copysize;
 
+#ifdef CONFIG_IOB_PERCPU_CACHE
+  buffer    += copysize;
+  buflen    -= copysize;
+
+  /* Then the statistics of the per-CPU caches */
+
+  linesize   = procfs_snprintf(iobfile->line, IOBINFO_LINELEN,
+                               "%10s%12s%12s%10s\n",
+                               "ncached", "nhits", "nmisses", "hitrate");
+
+  copysize   = procfs_memcpy(iobfile->line, linesize, buffer, buflen,
+                             &offset);
+  totalsize += copysize;
+
+  buffer    += copysize;
+  buflen    -= copysize;
+
+  linesize   = procfs_snprintf(iobfile->line, IOBINFO_LINELEN,
+                               "%10d%12lu%12lu%9lu%%\n",
+                               stats.ncached, stats.nhits, stats.nmisses,
+                               stats.nhits + stats.nmisses == 0 ? 0 :
+                               stats.nhits * 100 /
+                               (stats.nhits + stats.nmisses));
+
+  copysize   = procfs_memcpy(iobfile->line, linesize, buffer, buflen,
+                             &offset);
+  totalsize += copysize;
+#endif
+
   /* Update the file offset */
 
   filep->f_pos += totalsize;
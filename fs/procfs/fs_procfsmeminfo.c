@@ -108,6 +108,15 @@ static ssize_t memdump_write(FAR struct file *filep, FAR const char *buffer,
 #endif
 static ssize_t meminfo_read(FAR struct file *filep, FAR char *buffer,
                  size_t buflen);
+#ifndef CONFIG_FS_PROCFS_EXCLUDE_MEMFRAG
+static ssize_t memfrag_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+#endif
+#if defined(CONFIG_MM_HEAP_LOCKSTAT) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_MEMLOCK)
+static ssize_t memlock_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+#endif
 static int     meminfo_dup(FAR const struct file *oldp,
                  FAR struct file *newp);
 static int     meminfo_stat(FAR const char *relpath, FAR struct stat *buf);
@@ -153,6 +162,41 @@ const struct procfs_operations g_memdump_operations =
 };
 #endif
 
+#ifndef CONFIG_FS_PROCFS_EXCLUDE_MEMFRAG
+const struct procfs_operations g_memfrag_operations =
+{
+  meminfo_open,   /* open */
+  meminfo_close,  /* close */
+  memfrag_read,   /* read */
+  NULL,           /* write */
+  NULL,           /* poll */
+  meminfo_dup,    /* dup */
+  NULL,           /* opendir */
+  NULL,           /* closedir */
+  NULL,           /* readdir */
+  NULL,           /* rewinddir */
+  meminfo_stat    /* stat */
+};
+#endif
+
+#if defined(CONFIG_MM_HEAP_LOCKSTAT) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_MEMLOCK)
+const struct procfs_operations g_memlock_operations =
+{
+  meminfo_open,   /* open */
+  meminfo_close,  /* close */
+  memlock_read,   /* read */
+  NULL,           /* write */
+  NULL,           /* poll */
+  meminfo_dup,    /* dup */
+  NULL,           /* opendir */
+  NULL,           /* closedir */
+  NULL,           /* readdir */
+  NULL,           /* rewinddir */
+  meminfo_stat    /* stat */
+};
+#endif
+
 static FAR struct procfs_meminfo_entry_s *g_procfs_meminfo = NULL;
 
 /****************************************************************************
@@ -345,6 +389,47 @@ static ssize_t meminfo_read(FAR struct file *filep, FAR char *buffer,
         }
     }
 
+#ifdef CONFIG_MM_HEAP_PERCPU_CACHE
+  /* Followed by the statistics of the per-CPU chunk caches */
+
+  if (buflen > 0)
+    {
+      buffer    += copysize;
+      buflen    -= copysize;
+
+      linesize   = procfs_snprintf(procfile->line, MEMINFO_LINELEN,
+                                   "%11s%11s%11s%11s%11s%7s%s\n",
+                                   "cachehit", "cachemiss", "cachefree",
+                                   "drains", "cached", "nblks", " name");
+      copysize   = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                                 &offset);
+      totalsize += copysize;
+    }
+
+  for (entry = g_procfs_meminfo; entry != NULL; entry = entry->next)
+    {
+      if (buflen > 0)
+        {
+          struct mm_cacheinfo_s info;
+
+          buffer    += copysize;
+          buflen    -= copysize;
+
+          mm_cacheinfo(entry->heap, &info);
+          linesize   = procfs_snprintf(procfile->line, MEMINFO_LINELEN,
+                                       "%11lu%11lu%11lu%11lu%11lu%7lu %s\n",
+                                       info.hits, info.misses, info.frees,
+                                       info.drains,
+                                       (unsigned long)info.cached,
+                                       (unsigned long)info.nblks,
+                                       entry->name);
+          copysize   = procfs_memcpy(procfile->line, linesize, buffer,
+                                     buflen, &offset);
+          totalsize += copysize;
+        }
+    }
+#endif
+
 #ifdef CONFIG_MM_PGALLOC
   if (buflen > 0)
     {
@@ -409,6 +494,214 @@ static ssize_t meminfo_read(FAR struct file *filep, FAR char *buffer,
   return totalsize;
 }
 
+/****************************************************************************
+ * Name: memfrag_read
+ ****************************************************************************/
+
+#ifndef CONFIG_FS_PROCFS_EXCLUDE_MEMFRAG
+static ssize_t memfrag_read(FAR struct file *filep, FAR char *buffer,
+                            size_t buflen)
+{
+  FAR const struct procfs_meminfo_entry_s *entry;
+  FAR struct meminfo_file_s *procfile;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  off_t offset;
+  int i;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  DEBUGASSERT(buffer != NULL && buflen > 0);
+  offset = filep->f_pos;
+
+  /* Recover our private data from the struct file instance */
+
+  procfile = (FAR struct meminfo_file_s *)filep->f_priv;
+  DEBUGASSERT(procfile);
+
+  totalsize = 0;
+  copysize  = 0;
+
+  /* Every heap starts with its summary, the pinned chunks are allocated
+   * chunks with free chunks on both sides, followed by the size
+   * distribution of its free chunks.
+   */
+
+  for (entry = g_procfs_meminfo; entry != NULL; entry = entry->next)
+    {
+      struct mm_fraginfo_s info;
+      unsigned long frag = 0;
+
+      if (buflen == 0)
+        {
+          break;
+        }
+
+      mm_free_delaylist(entry->heap);
+      mm_fraginfo(entry->heap, &info);
+      if (info.totalfree > 0)
+        {
+          frag = 100 - (unsigned long)((uint64_t)info.largest * 100 /
+                                       info.totalfree);
+        }
+
+      buffer    += copysize;
+      buflen    -= copysize;
+
+      linesize   = procfs_snprintf(procfile->line, MEMINFO_LINELEN,
+                                   "%s:\n%11s%11s%6s%11s%11s\n"
+                                   "%11lu%11lu%5lu%%%11lu%11lu\n"
+                                   "%11s%11s%11s\n",
+                                   entry->name, "free", "largest",
+                                   "frag", "pinned", "pinsize",
+                                   (unsigned long)info.totalfree,
+                                   (unsigned long)info.largest, frag,
+                                   info.npinned,
+                                   (unsigned long)info.spinned,
+                                   "below", "nfree", "sfree");
+      copysize   = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                                 &offset);
+      totalsize += copysize;
+
+      for (i = 0; i < MM_FRAG_NBUCKETS && buflen > 0; i++)
+        {
+          buffer    += copysize;
+          buflen    -= copysize;
+
+          if (i < MM_FRAG_NBUCKETS - 1)
+            {
+              linesize = procfs_snprintf(procfile->line, MEMINFO_LINELEN,
+                                         "%11lu",
+                                         (unsigned long)MM_FRAG_LIMIT(i));
+            }
+          else
+            {
+              linesize = procfs_snprintf(procfile->line, MEMINFO_LINELEN,
+                                         "%11s", "-");
+            }
+
+          linesize  += procfs_snprintf(procfile->line + linesize,
+                                       MEMINFO_LINELEN - linesize,
+                                       "%11lu%11lu\n", info.nfree[i],
+                                       (unsigned long)info.sfree[i]);
+          copysize   = procfs_memcpy(procfile->line, linesize, buffer,
+                                     buflen, &offset);
+          totalsize += copysize;
+        }
+    }
+
+  /* Update the file offset */
+
+  filep->f_pos += totalsize;
+  return totalsize;
+}
+#endif
+
+/****************************************************************************
+ * Name: memlock_read
+ ****************************************************************************/
+
+#if defined(CONFIG_MM_HEAP_LOCKSTAT) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_MEMLOCK)
+static ssize_t memlock_read(FAR struct file *filep, FAR char *buffer,
+                            size_t buflen)
+{
+  FAR const struct procfs_meminfo_entry_s *entry;
+  FAR struct meminfo_file_s *procfile;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  off_t offset;
+  int i;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  DEBUGASSERT(buffer != NULL && buflen > 0);
+  offset = filep->f_pos;
+
+  /* Recover our private data from the struct file instance */
+
+  procfile = (FAR struct meminfo_file_s *)filep->f_priv;
+  DEBUGASSERT(procfile);
+
+  totalsize = 0;
+  copysize  = 0;
+
+  /* Every heap starts with the mutex statistics and the allocation latency
+   * percentiles, all the times in microseconds, followed by the tasks
+   * which waited the longest for the mutex.
+   */
+
+  for (entry = g_procfs_meminfo; entry != NULL; entry = entry->next)
+    {
+      struct mm_lockinfo_s info;
+
+      if (buflen == 0)
+        {
+          break;
+        }
+
+      mm_lockinfo(entry->heap, &info);
+
+      buffer    += copysize;
+      buflen    -= copysize;
+
+      linesize   = procfs_snprintf(procfile->line, MEMINFO_LINELEN,
+                                   "%s:\n%11s%11s%11s%11s%11s%11s\n"
+                                   "%11lu%11lu%11llu%11llu%11llu%11llu\n"
+                                   "%11s%11s%11s\n%11lu%11lu%11lu\n"
+                                   "%11s%11s%11s\n",
+                                   entry->name, "nlock", "contended",
+                                   "wait", "waitmax", "hold", "holdmax",
+                                   info.nlock, info.ncontended,
+                                   (unsigned long long)
+                                   (info.waittime / NSEC_PER_USEC),
+                                   (unsigned long long)
+                                   (info.waitmax / NSEC_PER_USEC),
+                                   (unsigned long long)
+                                   (info.holdtime / NSEC_PER_USEC),
+                                   (unsigned long long)
+                                   (info.holdmax / NSEC_PER_USEC),
+                                   "p50", "p90", "p99",
+                                   info.p50 / NSEC_PER_USEC,
+                                   info.p90 / NSEC_PER_USEC,
+                                   info.p99 / NSEC_PER_USEC,
+                                   "pid", "count", "wait");
+      copysize   = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                                 &offset);
+      totalsize += copysize;
+
+      for (i = 0; i < CONFIG_MM_HEAP_LOCKSTAT_NTASKS && buflen > 0; i++)
+        {
+          if (info.waiter[i].count == 0)
+            {
+              continue;
+            }
+
+          buffer    += copysize;
+          buflen    -= copysize;
+
+          linesize   = procfs_snprintf(procfile->line, MEMINFO_LINELEN,
+                                       "%11d%11lu%11llu\n",
+                                       (int)info.waiter[i].pid,
+                                       info.waiter[i].count,
+                                       (unsigned long long)
+                                       (info.waiter[i].waittime /
+                                        NSEC_PER_USEC));
+          copysize   = procfs_memcpy(procfile->line, linesize, buffer,
+                                     buflen, &offset);
+          totalsize += copysize;
+        }
+    }
+
+  /* Update the file offset */
+
+  filep->f_pos += totalsize;
+  return totalsize;
+}
+#endif
+
 /****************************************************************************
  * Name: memdump_read
  ****************************************************************************/
@@ -433,7 +726,7 @@ static ssize_t memdump_read(FAR struct file *filep, FAR char *buffer,
   DEBUGASSERT(procfile);
 
   linesize  = procfs_snprintf(procfile->line, MEMINFO_LINELEN,
-                 "usage: <used/free/orphan"
+                 "usage: <used/free/orphan/frag"
 #if CONFIG_MM_HEAP_MEMPOOL_THRESHOLD > 0
                  "/mempool"
 #endif
@@ -450,6 +743,7 @@ static ssize_t memdump_read(FAR struct file *filep, FAR char *buffer,
                  "used: dump all allocated node\n"
                  "free: dump all free node\n"
                  "orphan: dump allocated free neighbored node\n"
+                 "frag: dump fragmentation and pinned node\n"
 #if CONFIG_MM_HEAP_MEMPOOL_THRESHOLD > 0
                  "mempool: dump all mempool alloc node\n"
 #endif
@@ -568,7 +862,14 @@ static ssize_t memdump_write(FAR struct file *filep, FAR const char *buffer,
         break;
 
       case 'f':
-        dump.pid = PID_MM_FREE;
+        if (strncmp(buffer, "frag", 4) == 0)
+          {
+            dump.pid = PID_MM_FRAG;
+          }
+        else
+          {
+            dump.pid = PID_MM_FREE;
+          }
 
 #if CONFIG_MM_BACKTRACE >= 0
         p = (FAR char *)buffer + 4;
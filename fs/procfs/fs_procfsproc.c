@@ -161,9 +161,9 @@ struct proc_envinfo_s
  * Private Data
  ****************************************************************************/
 
-static FAR const char * const g_policy[4] =
+static FAR const char * const g_policy[8] =
 {
-  "SCHED_FIFO", "SCHED_RR", "SCHED_SPORADIC"
+  "SCHED_FIFO", "SCHED_RR", "SCHED_SPORADIC", "SCHED_DEADLINE", "SCHED_FAIR"
 };
 
 /****************************************************************************
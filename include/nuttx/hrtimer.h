@@ -88,6 +88,9 @@ typedef struct hrtimer_s
   hrtimer_node_t node;   /* Container node for sorted insertion */
   hrtimer_entry_t func;  /* Expiration callback function */
   uint64_t expired;      /* Absolute expiration time (ns) */
+#ifdef CONFIG_SMP
+  uint8_t cpu;           /* CPU whose queue holds the timer */
+#endif
 } hrtimer_t;
 
 /****************************************************************************
@@ -192,6 +195,29 @@ int hrtimer_start(FAR hrtimer_t *hrtimer, hrtimer_entry_t func,
                   uint64_t expired,
                   enum hrtimer_mode_e mode);
 
+/****************************************************************************
+ * Name: hrtimer_start_on
+ *
+ * Description:
+ *   Start a high-resolution timer like hrtimer_start(), but queue it on
+ *   the given CPU so that its callback runs there.  hrtimer_start() uses
+ *   the calling CPU.
+ *
+ * Input Parameters:
+ *   hrtimer - Timer instance to start
+ *   func    - Expiration callback function
+ *   expired - Expiration time in nanoseconds
+ *   mode    - HRTIMER_MODE_ABS or HRTIMER_MODE_REL
+ *   cpu     - The CPU that expires the timer
+ *
+ * Returned Value:
+ *   OK on success; a negated errno value on failure.
+ ****************************************************************************/
+
+int hrtimer_start_on(FAR hrtimer_t *hrtimer, hrtimer_entry_t func,
+                     uint64_t expired, enum hrtimer_mode_e mode,
+                     int cpu);
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -80,7 +80,7 @@
 /* IOB helpers */
 
 #define IOB_DATA(p)      (&(p)->io_data[(p)->io_offset])
-#define IOB_FREESPACE(p) (CONFIG_IOB_BUFSIZE - (p)->io_len - (p)->io_offset)
+#define IOB_FREESPACE(p) (IOB_BUFSIZE(p) - (p)->io_len - (p)->io_offset)
 
 #if CONFIG_IOB_NCHAINS > 0
 /* Queue helpers */
@@ -167,6 +167,11 @@ struct iob_stats_s
   int nfree;
   int nwait;
   int nthrottle;
+#ifdef CONFIG_IOB_PERCPU_CACHE
+  int ncached;           /* Free I/O buffers held by the per-CPU caches */
+  unsigned long nhits;   /* Allocations served by the per-CPU caches */
+  unsigned long nmisses; /* Allocations which took the global lock */
+#endif
 };
 
 /****************************************************************************
@@ -220,6 +225,43 @@ FAR struct iob_s *iob_alloc(bool throttled);
 
 FAR struct iob_s *iob_tryalloc(bool throttled);
 
+/****************************************************************************
+ * Name: iob_alloc_chain
+ *
+ * Description:
+ *   Allocate n I/O buffers, waiting as necessary.  As many buffers as
+ *   possible are taken with a single round trip of the lock.  The buffers
+ *   are linked by io_flink but carry no packet, they are meant to be
+ *   consumed one by one, e.g. while copying a large packet in.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_alloc_chain(unsigned int n, bool throttled);
+
+/****************************************************************************
+ * Name: iob_tryalloc_chain
+ *
+ * Description:
+ *   Allocate up to n I/O buffers like iob_alloc_chain(), but without
+ *   waiting.  NULL is returned if no buffer is available.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_tryalloc_chain(unsigned int n, bool throttled);
+
+/****************************************************************************
+ * Name: iob_tryalloc_size
+ *
+ * Description:
+ *   Allocate an I/O buffer which holds at least size bytes, without
+ *   waiting.  A buffer of the large size classes is returned if size
+ *   exceeds CONFIG_IOB_BUFSIZE (see CONFIG_IOB_SIZE_CLASSES).  NULL is
+ *   returned if no such buffer is available.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_tryalloc_size(unsigned int size, bool throttled);
+
 #ifdef CONFIG_IOB_ALLOC
 /****************************************************************************
  * Name: iob_alloc_dynamic
@@ -373,7 +415,8 @@ void iob_notifier_teardown(int key);
  *
  * Description:
  *   Free an entire buffer chain, starting at the beginning of the I/O
- *   buffer chain
+ *   buffer chain.  The buffers are returned with a single round trip of
+ *   the lock.
  *
  ****************************************************************************/
 
@@ -49,6 +49,10 @@
 #  define MEMPOOL_REALBLOCKSIZE(pool) ((pool)->blocksize)
 #endif
 
+/* Every chunk of blocks carries a header to queue it in the pool */
+
+#define MEMPOOL_HEADER_SIZE (sizeof(sq_entry_t) + CONFIG_MM_NODE_GUARDSIZE)
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -87,6 +91,16 @@ struct mempool_procfs_entry_s
 };
 #endif
 
+#ifdef CONFIG_MM_MEMPOOL_PERCPU_CACHE
+/* This structure describes the free blocks cached by one CPU */
+
+struct mempool_cache_s
+{
+  FAR sq_entry_t *head;  /* The LIFO of the cached free blocks */
+  size_t          nfree; /* The number of blocks in the LIFO */
+};
+#endif
+
 /* This structure describes memory buffer pool */
 
 struct mempool_s
@@ -110,6 +124,10 @@ struct mempool_s
   size_t     nalloc;  /* The number of used block in mempool */
   spinlock_t lock;    /* The protect lock to mempool */
   sem_t      waitsem; /* The semaphore of waiter get free block */
+#ifdef CONFIG_MM_MEMPOOL_PERCPU_CACHE
+  struct mempool_cache_s cache[CONFIG_SMP_NCPUS]; /* The per-CPU free block
+                                                   * caches */
+#endif
 #if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_MEMPOOL)
   struct mempool_procfs_entry_s procfs; /* The entry of procfs */
 #endif
@@ -255,6 +273,21 @@ void mempool_memdump(FAR struct mempool_s *pool,
 
 int mempool_deinit(FAR struct mempool_s *pool);
 
+/****************************************************************************
+ * Name: mempool_reclaim
+ *
+ * Description:
+ *   Give the expanded chunks whose blocks are all free back to the heap.
+ *
+ * Input Parameters:
+ *   pool    - Address of the memory pool to be used.
+ *
+ * Returned Value:
+ *   The number of bytes given back to the heap.
+ ****************************************************************************/
+
+size_t mempool_reclaim(FAR struct mempool_s *pool);
+
 /****************************************************************************
  * Name: mempool_info_task
  *
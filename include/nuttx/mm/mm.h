@@ -172,6 +172,19 @@
 #define MM_ALLOC_MAGIC   0xaa
 #define MM_FREE_MAGIC    0x55
 
+/* Bucket i of the allocation latency histogram counts the allocations
+ * which took less than 2^i perf ticks, the last bucket takes the rest.
+ */
+
+#define MM_LATENCY_NBUCKETS 24
+
+/* Bucket i of the free chunk size distribution counts the free chunks
+ * smaller than 64 << 2i bytes, the last bucket takes the rest.
+ */
+
+#define MM_FRAG_NBUCKETS    8
+#define MM_FRAG_LIMIT(i)    ((size_t)64 << (2 * (i)))
+
 #ifdef CONFIG_MM_BACKTRACE_SEQNO
 #  define MM_INCSEQNO(p) ((p)->seqno = g_mm_seqno++)
 #else
@@ -208,6 +221,66 @@ struct mempool_init_s
   size_t            dict_expendsize;
 };
 
+#ifdef CONFIG_MM_HEAP_PERCPU_CACHE
+struct mm_cacheinfo_s
+{
+  unsigned long hits;   /* Allocations served by the per-CPU caches */
+  unsigned long misses; /* Allocations which fell back to the heap */
+  unsigned long frees;  /* Frees absorbed by the per-CPU caches */
+  unsigned long drains; /* Times the cached chunks returned to the heap */
+  size_t        nblks;  /* Number of chunks currently cached */
+  size_t        cached; /* Total size of the chunks currently cached */
+};
+#endif
+
+struct mm_fraginfo_s
+{
+  unsigned long nfree[MM_FRAG_NBUCKETS]; /* Free chunks in each bucket */
+  size_t        sfree[MM_FRAG_NBUCKETS]; /* Total size of each bucket */
+  size_t        totalfree;               /* Total size of the free chunks */
+  size_t        largest;                 /* Size of the largest free chunk */
+  unsigned long npinned;                 /* Chunks pinned between free ones */
+  size_t        spinned;                 /* Total size of the pinned chunks */
+};
+
+#ifdef CONFIG_MM_HEAP_LATENCY_HISTOGRAM
+struct mm_latencyinfo_s
+{
+  unsigned long count[MM_LATENCY_NBUCKETS]; /* Allocations in each bucket */
+  unsigned long limit[MM_LATENCY_NBUCKETS]; /* Upper bound of each bucket
+                                             * in nanoseconds */
+};
+#endif
+
+#ifdef CONFIG_MM_HEAP_LOCKSTAT
+struct mm_lockwaiter_s
+{
+  pid_t         pid;      /* Task which found the heap mutex held */
+  unsigned long count;    /* Number of times it had to wait */
+  uint64_t      waittime; /* Total time it waited */
+};
+
+struct mm_lockinfo_s
+{
+  unsigned long nlock;      /* Number of times the heap mutex was taken */
+  unsigned long ncontended; /* Number of times it was found held */
+  uint64_t      waittime;   /* Total time spent waiting for the mutex */
+  uint64_t      waitmax;    /* Longest single wait */
+  uint64_t      holdtime;   /* Total time the mutex was held */
+  uint64_t      holdmax;    /* Longest single hold */
+  unsigned long p50;        /* Median allocation latency */
+  unsigned long p90;        /* 90th percentile of the allocation latency */
+  unsigned long p99;        /* 99th percentile of the allocation latency */
+
+  /* The tasks which waited the longest, unused entries have a zero count.
+   * All the times are in nanoseconds, the percentiles are the upper bound
+   * of the latency histogram bucket they fall in.
+   */
+
+  struct mm_lockwaiter_s waiter[CONFIG_MM_HEAP_LOCKSTAT_NTASKS];
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -447,6 +520,40 @@ struct mallinfo_task mm_mallinfo_task(FAR struct mm_heap_s *heap,
 
 size_t mm_heapfree(FAR struct mm_heap_s *heap);
 size_t mm_heapfree_largest(FAR struct mm_heap_s *heap);
+void mm_fraginfo(FAR struct mm_heap_s *heap,
+                 FAR struct mm_fraginfo_s *info);
+
+/* Return the bucket of the free chunk size distribution for a chunk */
+
+static inline_function int mm_fragndx(size_t size)
+{
+  int ndx = 0;
+
+  while (ndx < MM_FRAG_NBUCKETS - 1 && size >= MM_FRAG_LIMIT(ndx))
+    {
+      ndx++;
+    }
+
+  return ndx;
+}
+
+#ifdef CONFIG_MM_HEAP_LATENCY_HISTOGRAM
+void mm_mallinfo_latency(FAR struct mm_heap_s *heap,
+                         FAR struct mm_latencyinfo_s *info);
+#endif
+
+/* Functions contained in mm_lock.c *****************************************/
+
+#ifdef CONFIG_MM_HEAP_LOCKSTAT
+void mm_lockinfo(FAR struct mm_heap_s *heap, FAR struct mm_lockinfo_s *info);
+#endif
+
+/* Functions contained in mm_cache.c ****************************************/
+
+#ifdef CONFIG_MM_HEAP_PERCPU_CACHE
+void mm_cacheinfo(FAR struct mm_heap_s *heap,
+                  FAR struct mm_cacheinfo_s *info);
+#endif
 
 /* Functions contained in kmm_mallinfo.c ************************************/
 
@@ -0,0 +1,182 @@
+/****************************************************************************
+ * include/nuttx/mm/objcache.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_MM_OBJCACHE_H
+#define __INCLUDE_NUTTX_MM_OBJCACHE_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+
+#include <nuttx/list.h>
+#include <nuttx/mm/mempool.h>
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+typedef CODE void (*objcache_ctor_t)(FAR void *obj, FAR void *arg);
+typedef CODE void (*objcache_dtor_t)(FAR void *obj, FAR void *arg);
+
+/* This structure describes a cache of objects of one type.  The objects
+ * are carved from the chunks of a mempool, so they share its per-CPU
+ * caches, and every object is aligned to the alignment of the cache.
+ */
+
+struct objcache_s
+{
+  struct mempool_s pool;  /* The pool which the objects are carved from */
+  size_t           align; /* The alignment of every object */
+  objcache_ctor_t  ctor;  /* Called on every allocated object, or NULL */
+  objcache_dtor_t  dtor;  /* Called on every freed object, or NULL */
+  FAR void        *arg;   /* The argument of ctor and dtor */
+  struct list_node node;  /* The entry in the list of all object caches */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#undef EXTERN
+#if defined(__cplusplus)
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: objcache_init
+ *
+ * Description:
+ *   Initialize a cache of objects of the given size.  The free objects
+ *   hold the link of the pool, so unlike the slab caches of other systems
+ *   they are not kept constructed: ctor is called on every allocation and
+ *   dtor on every free.
+ *
+ * Input Parameters:
+ *   cache - Address of the object cache to be initialized.
+ *   name  - The name of the object cache.
+ *   size  - The size of every object.
+ *   align - The alignment of every object, a power of two.  Zero aligns
+ *           the objects to the data cache lines, so that no two objects
+ *           share a line.
+ *   ctor  - Prepares every allocated object, may be NULL.
+ *   dtor  - Tears down every freed object, may be NULL.
+ *   arg   - The argument of ctor and dtor.
+ *
+ * Returned Value:
+ *   Zero on success; A negated errno value is returned on any failure.
+ *
+ ****************************************************************************/
+
+int objcache_init(FAR struct objcache_s *cache, FAR const char *name,
+                  size_t size, size_t align, objcache_ctor_t ctor,
+                  objcache_dtor_t dtor, FAR void *arg);
+
+/****************************************************************************
+ * Name: objcache_alloc
+ *
+ * Description:
+ *   Allocate an object from the cache, the cache grows when it is empty.
+ *
+ * Input Parameters:
+ *   cache - Address of the object cache to be used.
+ *
+ * Returned Value:
+ *   The pointer to the allocated object on success; NULL on any failure.
+ *
+ ****************************************************************************/
+
+FAR void *objcache_alloc(FAR struct objcache_s *cache);
+
+/****************************************************************************
+ * Name: objcache_free
+ *
+ * Description:
+ *   Return an object to the cache.
+ *
+ * Input Parameters:
+ *   cache - Address of the object cache to be used.
+ *   obj   - The object allocated by objcache_alloc().
+ *
+ ****************************************************************************/
+
+void objcache_free(FAR struct objcache_s *cache, FAR void *obj);
+
+/****************************************************************************
+ * Name: objcache_reclaim
+ *
+ * Description:
+ *   Give the memory of the free objects of the cache back to the heap,
+ *   where possible.
+ *
+ * Input Parameters:
+ *   cache - Address of the object cache to be used.
+ *
+ * Returned Value:
+ *   The number of bytes given back to the heap.
+ *
+ ****************************************************************************/
+
+size_t objcache_reclaim(FAR struct objcache_s *cache);
+
+/****************************************************************************
+ * Name: objcache_reclaim_all
+ *
+ * Description:
+ *   Call objcache_reclaim() on every initialized object cache.
+ *
+ * Returned Value:
+ *   The number of bytes given back to the heap.
+ *
+ ****************************************************************************/
+
+size_t objcache_reclaim_all(void);
+
+/****************************************************************************
+ * Name: objcache_deinit
+ *
+ * Description:
+ *   Deinitialize an object cache, all its objects must have been freed.
+ *
+ * Input Parameters:
+ *   cache - Address of the object cache to be deinitialized.
+ *
+ * Returned Value:
+ *   Zero on success; -EBUSY if some objects are still allocated.
+ *
+ ****************************************************************************/
+
+int objcache_deinit(FAR struct objcache_s *cache);
+
+#undef EXTERN
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* __INCLUDE_NUTTX_MM_OBJCACHE_H */
@@ -0,0 +1,166 @@
+/****************************************************************************
+ * include/nuttx/mm/shrinker.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_MM_SHRINKER_H
+#define __INCLUDE_NUTTX_MM_SHRINKER_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+
+#include <nuttx/list.h>
+#include <nuttx/wqueue.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The shrinkers run in the kernel, the userspace copy of the heap in the
+ * protected and kernel builds doesn't call them.
+ */
+
+#if defined(CONFIG_MM_SHRINKER) && \
+    (defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__))
+#  define MM_SHRINKER
+#endif
+
+#ifdef MM_SHRINKER
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+struct mm_heap_s;
+struct mm_shrinker_s;
+
+/* Give memory back to the heaps.  size is the number of bytes still
+ * wanted, a shrinker may free less or more.  It is called from the task
+ * whose allocation failed, or from the low priority work queue, never from
+ * an interrupt handler.  It may sleep, but it must not wait for memory.
+ * It returns the number of bytes freed.
+ */
+
+typedef CODE size_t (*mm_shrink_t)(FAR struct mm_shrinker_s *shrinker,
+                                   FAR struct mm_heap_s *heap, size_t size);
+
+/* This describes one reclaim callback, registered by the subsystems which
+ * keep memory that they can release on demand (caches, pools...).
+ */
+
+struct mm_shrinker_s
+{
+  struct list_node  node;   /* The entry in the list of all shrinkers */
+  FAR const char   *name;   /* The name of the shrinker */
+  mm_shrink_t       shrink; /* The reclaim callback */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#undef EXTERN
+#if defined(__cplusplus)
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: mm_shrinker_register
+ *
+ * Description:
+ *   Register a shrinker, it is called when memory runs low.  Registering
+ *   a shrinker which is already registered does nothing.
+ *
+ * Input Parameters:
+ *   shrinker - The shrinker, with its name and callback filled in.
+ *
+ ****************************************************************************/
+
+void mm_shrinker_register(FAR struct mm_shrinker_s *shrinker);
+
+/****************************************************************************
+ * Name: mm_shrinker_unregister
+ *
+ * Description:
+ *   Unregister a shrinker.  It is not called anymore when this returns.
+ *
+ * Input Parameters:
+ *   shrinker - The registered shrinker.
+ *
+ ****************************************************************************/
+
+void mm_shrinker_unregister(FAR struct mm_shrinker_s *shrinker);
+
+/****************************************************************************
+ * Name: mm_shrink
+ *
+ * Description:
+ *   Call the shrinkers, in the order of registration, until size bytes are
+ *   freed.  The heap allocators call it before failing an allocation.
+ *   Nothing is done from an interrupt handler or while a shrinker runs.
+ *
+ * Input Parameters:
+ *   heap - The heap which runs low, for the information of the shrinkers.
+ *   size - The number of bytes wanted.
+ *
+ * Returned Value:
+ *   The number of bytes freed.
+ *
+ ****************************************************************************/
+
+size_t mm_shrink(FAR struct mm_heap_s *heap, size_t size);
+
+/****************************************************************************
+ * Name: mm_shrink_watermark
+ *
+ * Description:
+ *   Called by the heap allocators after every allocation.  If less than
+ *   CONFIG_MM_SHRINKER_WATERMARK bytes are left free, the shrinkers are
+ *   called from the low priority work queue to free the difference.
+ *
+ * Input Parameters:
+ *   heap - The heap which served the allocation.
+ *   work - The work of the heap, so that every heap is queued separately.
+ *
+ ****************************************************************************/
+
+#if CONFIG_MM_SHRINKER_WATERMARK > 0
+void mm_shrink_watermark(FAR struct mm_heap_s *heap,
+                         FAR struct work_s *work);
+#else
+#  define mm_shrink_watermark(heap, work)
+#endif
+
+#undef EXTERN
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* MM_SHRINKER */
+#endif /* __INCLUDE_NUTTX_MM_SHRINKER_H */
@@ -339,7 +339,10 @@ ssize_t net_ioctl_arglen(uint8_t domain, int cmd);
  * Name: net_lock
  *
  * Description:
- *   Take the network lock
+ *   Take the network lock.  The network stack itself is protected by the
+ *   per-connection (conn_lock()), per-device (netdev_lock()) and per-table
+ *   locks; this lock only remains for legacy drivers that still serialize
+ *   against each other with it.
  *
  * Input Parameters:
  *   None
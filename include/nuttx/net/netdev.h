@@ -84,6 +84,17 @@
 
 #define NETDEV_TX_CSUM  (1 << 1) /* Netdev support hardware tx checksum */
 #define NETDEV_RX_CSUM  (1 << 2) /* Netdev support hardware rx checksum */
+#define NETDEV_TSO      (1 << 3) /* Netdev support hardware tcp segmentation */
+#define NETDEV_GSO      (1 << 4) /* Netdev segments big tcp packets itself */
+
+/* A device with NETDEV_TX_CSUM_PARTIAL completes the checksum of any upper
+ * layer protocol (TCP, UDP, ICMP and ICMPv6) from the offsets given by
+ * netpkt_csum_partial(), so the network leaves these checksums to it.
+ * Packets that the device never sees whole, fragmented or looped back to
+ * ourself, are completed in software.
+ */
+
+#define NETDEV_TX_CSUM_PARTIAL (1 << 5)
 
 /* Determine the largest possible address */
 
@@ -505,6 +516,16 @@ struct net_driver_s
 
   uint16_t d_sndlen;
 
+#ifdef CONFIG_NET_TCP_GSO
+  /* When d_buf contains a TCP packet with more payload than fits in one
+   * segment, d_gso_size is non-zero and holds the size that the payload
+   * must be split into (the MSS of the connection).  Only ever set for
+   * devices advertising NETDEV_GSO or NETDEV_TSO.
+   */
+
+  uint16_t d_gso_size;
+#endif
+
   /* Multicast group support */
 
 #ifdef CONFIG_NET_IGMP
@@ -765,6 +786,34 @@ void arp_input(FAR struct net_driver_s *dev);
 
 int devif_poll(FAR struct net_driver_s *dev, devif_poll_callback_t callback);
 
+/****************************************************************************
+ * Name: tcp_gso_segment
+ *
+ * Description:
+ *   Split the oversized TCP packet in d_iob into segments of d_gso_size
+ *   bytes of payload and pass each of them in d_iob to the callback, the
+ *   same way devif_poll() does.  A packet that needs no segmentation is
+ *   passed to the callback unchanged.  Segmentation stops at the first
+ *   negative value returned by the callback.
+ *
+ * Input Parameters:
+ *   dev      - The device holding the packet in d_iob
+ *   callback - The driver function that sends a single packet
+ *
+ * Returned Value:
+ *   The value returned by the last callback, or a negated errno value if
+ *   no I/O buffer is available for a segment.
+ *
+ * Assumptions:
+ *   Called from the TX poll callback of the driver with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_GSO
+int tcp_gso_segment(FAR struct net_driver_s *dev,
+                    devif_poll_callback_t callback);
+#endif
+
 /****************************************************************************
  * Name: neighbor_out
  *
@@ -154,6 +154,9 @@ struct netdev_ops_s
    *       own queue and return OK (remember to free it later).
    *     Negated errno value for failure, will stop current sending, the pkt
    *       will be recycled by upper half.
+   *   A lower half that sets NETDEV_TSO in netdev.d_features may be given
+   *   a TCP packet bigger than the MTU, which it has to split into
+   *   segments of netdev.d_gso_size bytes of payload (if non-zero).
    */
 
   CODE int (*transmit)(FAR struct netdev_lowerhalf_s *dev,
@@ -555,6 +558,31 @@ bool netpkt_is_fragmented(FAR netpkt_t *pkt);
 int netpkt_to_iov(FAR struct netdev_lowerhalf_s *dev, FAR netpkt_t *pkt,
                   FAR struct iovec *iov, int iovcnt);
 
+/****************************************************************************
+ * Name: netpkt_csum_partial
+ *
+ * Description:
+ *   Prepare an outgoing packet for a device with NETDEV_TX_CSUM_PARTIAL,
+ *   which sums the packet from the start offset to its end and stores the
+ *   complement at start + offset.  The sum of the pseudo header is stored
+ *   into the checksum field of the TCP, UDP, ICMP or ICMPv6 header.
+ *
+ * Input Parameters:
+ *   dev    - The lower half device driver structure
+ *   pkt    - The net packet
+ *   start  - Returns the offset of the upper layer header in the frame
+ *   offset - Returns the offset of the checksum in the upper layer header
+ *
+ * Returned Value:
+ *   OK on success, a negated errno value if the packet has no checksum to
+ *   be completed by the device.
+ *
+ ****************************************************************************/
+
+int netpkt_csum_partial(FAR struct netdev_lowerhalf_s *dev,
+                        FAR netpkt_t *pkt, FAR uint16_t *start,
+                        FAR uint16_t *offset);
+
 /****************************************************************************
  * Name: netpkt_tryadd_queue
  *
@@ -64,6 +64,8 @@
 #define TCP_PSH           0x08
 #define TCP_ACK           0x10
 #define TCP_URG           0x20
+#define TCP_ECE           0x40
+#define TCP_CWR           0x80
 #define TCP_CTL           0x3f
 
 #define TCP_OPT_END       0   /* End of TCP options list */
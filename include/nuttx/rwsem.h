@@ -27,6 +27,7 @@
  * Included Files
  ****************************************************************************/
 
+#include <nuttx/atomic.h>
 #include <nuttx/mutex.h>
 
 /****************************************************************************
@@ -37,6 +38,20 @@
 #define RWSEM_INITIALIZER   {NXMUTEX_INITIALIZER, SEM_INITIALIZER(0), \
                              RWSEM_NO_HOLDER, 0, 0, 0}
 
+/* Each CPU has its own reader count of a per-CPU read-write-lock, kept in
+ * a separate cache line so that readers on different CPUs never write to
+ * the same line.
+ */
+
+#ifdef CONFIG_SMP
+#  define PERCPU_RWSEM_CACHELINE    64
+#  define PERCPU_RWSEM_INITIALIZER  {NXRMUTEX_INITIALIZER, \
+                                     NXMUTEX_INITIALIZER, \
+                                     SEM_INITIALIZER(0), 0, 0, {{0}}}
+#else
+#  define PERCPU_RWSEM_INITIALIZER  RWSEM_INITIALIZER
+#endif
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -54,6 +69,34 @@ typedef struct
   int     reader;       /* Reader Count */
 } rw_semaphore_t;
 
+/* A per-CPU read-write-lock is meant for read-mostly data.  Readers only
+ * touch the count of their own CPU and the writer state, which is only
+ * written by writers, so read locks taken on different CPUs do not bounce
+ * cache lines.  Taking the write lock is correspondingly more expensive.
+ *
+ * Like rw_semaphore_t, read locks may nest even while a writer is waiting,
+ * and the write lock holder may take both read and write locks again.
+ */
+
+#ifdef CONFIG_SMP
+struct aligned_data(PERCPU_RWSEM_CACHELINE) percpu_rwsem_count_s
+{
+  atomic_t count;       /* Readers that took the lock on this CPU */
+};
+
+typedef struct
+{
+  rmutex_t wlock;       /* Serializes the writers */
+  mutex_t  protected;   /* Protects the slow path */
+  sem_t    waiting;     /* Reader/writer Waiting queue */
+  int      waiter;      /* Waiter Count */
+  atomic_t writer;      /* Writer state, see sem_rw_percpu.c */
+  struct percpu_rwsem_count_s readers[CONFIG_SMP_NCPUS];
+} percpu_rw_semaphore_t;
+#else
+typedef rw_semaphore_t percpu_rw_semaphore_t;
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -186,4 +229,97 @@ int init_rwsem(FAR rw_semaphore_t *rwsem);
 
 void destroy_rwsem(FAR rw_semaphore_t *rwsem);
 
+#ifdef CONFIG_SMP
+
+/****************************************************************************
+ * Name: percpu_down_read
+ *
+ * Description:
+ *   Acquire a read lock on a per-CPU read-write-lock object.
+ *
+ * Input Parameters:
+ *   rwsem  - Pointer to the per-CPU read-write-lock descriptor.
+ *
+ ****************************************************************************/
+
+void percpu_down_read(FAR percpu_rw_semaphore_t *rwsem);
+
+/****************************************************************************
+ * Name: percpu_up_read
+ *
+ * Description:
+ *   Unlock a read lock on a per-CPU read-write-lock object.
+ *
+ * Input Parameters:
+ *   rwsem  - Pointer to the per-CPU read-write-lock descriptor.
+ *
+ ****************************************************************************/
+
+void percpu_up_read(FAR percpu_rw_semaphore_t *rwsem);
+
+/****************************************************************************
+ * Name: percpu_down_write
+ *
+ * Description:
+ *   Acquire a write lock on a per-CPU read-write-lock object.
+ *
+ * Input Parameters:
+ *   rwsem  - Pointer to the per-CPU read-write-lock descriptor.
+ *
+ ****************************************************************************/
+
+void percpu_down_write(FAR percpu_rw_semaphore_t *rwsem);
+
+/****************************************************************************
+ * Name: percpu_up_write
+ *
+ * Description:
+ *   Unlock a write lock on a per-CPU read-write-lock object.
+ *
+ * Input Parameters:
+ *   rwsem  - Pointer to the per-CPU read-write-lock descriptor.
+ *
+ ****************************************************************************/
+
+void percpu_up_write(FAR percpu_rw_semaphore_t *rwsem);
+
+/****************************************************************************
+ * Name: percpu_init_rwsem
+ *
+ * Description:
+ *   Initialize a per-CPU read-write-lock object.
+ *
+ * Input Parameters:
+ *   rwsem  - Pointer to the per-CPU read-write-lock descriptor.
+ *
+ * Returned Value:
+ *   It follows the NuttX internal error return policy: Zero (OK) is
+ *   returned on success. A negated errno value is returned on failure.
+ *
+ ****************************************************************************/
+
+int percpu_init_rwsem(FAR percpu_rw_semaphore_t *rwsem);
+
+/****************************************************************************
+ * Name: percpu_destroy_rwsem
+ *
+ * Description:
+ *   Destroy a per-CPU read-write-lock object.
+ *
+ * Input Parameters:
+ *   rwsem - Pointer to the per-CPU read-write-lock descriptor.
+ *
+ ****************************************************************************/
+
+void percpu_destroy_rwsem(FAR percpu_rw_semaphore_t *rwsem);
+
+#else
+#  define percpu_down_read(rwsem)     down_read(rwsem)
+#  define percpu_up_read(rwsem)       up_read(rwsem)
+#  define percpu_down_write(rwsem)    down_write(rwsem)
+#  define percpu_up_write(rwsem)      up_write(rwsem)
+#  define percpu_init_rwsem(rwsem)    init_rwsem(rwsem)
+#  define percpu_destroy_rwsem(rwsem) destroy_rwsem(rwsem)
+#endif
+
 #endif  /* __INCLUDE_NUTTX_RWSEM_H */
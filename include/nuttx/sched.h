@@ -93,11 +93,13 @@
 #  define TCB_FLAG_TTYPE_TASK      (0 << TCB_FLAG_TTYPE_SHIFT)   /*   Normal user task */
 #  define TCB_FLAG_TTYPE_PTHREAD   (1 << TCB_FLAG_TTYPE_SHIFT)   /*   User pthread */
 #  define TCB_FLAG_TTYPE_KERNEL    (2 << TCB_FLAG_TTYPE_SHIFT)   /*   Kernel thread */
-#define TCB_FLAG_POLICY_SHIFT      (3)                           /* Bit 3-4: Scheduling policy */
-#define TCB_FLAG_POLICY_MASK       (3 << TCB_FLAG_POLICY_SHIFT)
+#define TCB_FLAG_POLICY_SHIFT      (2)                           /* Bit 2-4: Scheduling policy */
+#define TCB_FLAG_POLICY_MASK       (7 << TCB_FLAG_POLICY_SHIFT)
 #  define TCB_FLAG_SCHED_FIFO      (0 << TCB_FLAG_POLICY_SHIFT)  /* FIFO scheding policy */
 #  define TCB_FLAG_SCHED_RR        (1 << TCB_FLAG_POLICY_SHIFT)  /* Round robin scheding policy */
 #  define TCB_FLAG_SCHED_SPORADIC  (2 << TCB_FLAG_POLICY_SHIFT)  /* Sporadic scheding policy */
+#  define TCB_FLAG_SCHED_DEADLINE  (3 << TCB_FLAG_POLICY_SHIFT)  /* Deadline scheding policy */
+#  define TCB_FLAG_SCHED_FAIR      (4 << TCB_FLAG_POLICY_SHIFT)  /* Fair share scheding policy */
 #define TCB_FLAG_CPU_LOCKED        (1 << 5)                      /* Bit 5: Locked to this CPU */
 #define TCB_FLAG_SIGNAL_ACTION     (1 << 6)                      /* Bit 6: In a signal handler */
 #define TCB_FLAG_SYSCALL           (1 << 7)                      /* Bit 7: In a system call */
@@ -110,6 +112,7 @@
 #define TCB_FLAG_JOIN_COMPLETED    (1 << 14)                     /* Bit 14: Pthread join completed */
 #define TCB_FLAG_FREE_TCB          (1 << 15)                     /* Bit 15: Free tcb after exit */
 #define TCB_FLAG_PREEMPT_SCHED     (1 << 16)                     /* Bit 16: tcb is PREEMPT_SCHED */
+#define TCB_FLAG_CPU_RUNQUEUE      (1 << 17)                     /* Bit 17: In the ready-to-run list of tcb->cpu */
 
 /* Values for struct task_group tg_flags */
 
@@ -347,6 +350,33 @@ struct sporadic_s
 
 #endif /* CONFIG_SCHED_SPORADIC */
 
+/* struct deadline_s ********************************************************/
+
+#ifdef CONFIG_SCHED_DEADLINE
+
+/* This structure is an allocated "plug-in" to the main TCB structure, like
+ * struct sporadic_s.  It holds the parameters and the state of the constant
+ * bandwidth server of a thread using the deadline scheduling policy.
+ */
+
+struct deadline_s
+{
+  FAR struct tcb_s *tcb;            /* The parent TCB structure              */
+  struct wdog_s timer;              /* Budget or replenishment timer         */
+  bool      running;                /* Budget is being consumed              */
+  bool      throttled;              /* Waiting for the next replenishment    */
+  uint8_t   priority;               /* Priority while not throttled          */
+  uint32_t  runtime;                /* Execution budget per period           */
+  uint32_t  deadline;               /* Relative deadline                     */
+  uint32_t  period;                 /* Replenishment period                  */
+  uint32_t  budget;                 /* Budget left in the current period     */
+  uint32_t  bandwidth;              /* Reserved runtime / period             */
+  clock_t   abs_deadline;           /* Current absolute deadline             */
+  clock_t   eventtime;              /* Time the budget started to be used    */
+};
+
+#endif /* CONFIG_SCHED_DEADLINE */
+
 /* struct child_status_s ****************************************************/
 
 /* This structure is used to maintain information about child tasks.
@@ -631,8 +661,19 @@ struct tcb_s
 #ifdef CONFIG_SCHED_SPORADIC
   FAR struct sporadic_s *sporadic;       /* Sporadic scheduling parameters  */
 #endif
+#ifdef CONFIG_SCHED_DEADLINE
+  FAR struct deadline_s *deadline;       /* Deadline scheduling parameters  */
+#endif
+#ifdef CONFIG_SCHED_FAIR
+  uint64_t vruntime;                     /* Weighted run time (fair policy) */
+  uint32_t weight;                       /* Load weight (fair policy)       */
+  int8_t   nice;                         /* Nice value (fair policy)        */
+#endif
 
   struct wdog_s waitdog;                 /* All timed waits use this timer  */
+#ifdef CONFIG_SCHED_TIMER_SLACK
+  clock_t timerslack;                    /* Slack allowed for timed waits   */
+#endif
 
   /* Stack-Related Fields ***************************************************/
 
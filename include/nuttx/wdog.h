@@ -35,6 +35,7 @@
 #include <nuttx/list.h>
 #include <errno.h>
 #include <stdint.h>
+#include <strings.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -91,6 +92,9 @@ struct wdog_s
   FAR void        *picbase; /* PIC base address */
 #endif
   clock_t          expired; /* Timer associated with the absolute time */
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+  uint8_t          slot;    /* Timing wheel level and slot index */
+#endif
 };
 
 /****************************************************************************
@@ -196,6 +200,88 @@ int wd_start(FAR struct wdog_s *wdog, clock_t delay,
   return ret;
 }
 
+/****************************************************************************
+ * Name: wd_slack_abstick
+ *
+ * Description:
+ *   Move an absolute expiration time forward by at most 'slack' ticks, to
+ *   the tick in [ticks, ticks + slack] with the most trailing zero bits.
+ *   Timers whose slack windows overlap are likely to end up on the same
+ *   tick and are then serviced by a single timer interrupt.
+ *
+ * Input Parameters:
+ *   ticks - Absolute expiration time in clock ticks
+ *   slack - The maximum delay in clock ticks the timer tolerates
+ *
+ * Returned Value:
+ *   The coalesced expiration time.
+ *
+ ****************************************************************************/
+
+static inline_function clock_t wd_slack_abstick(clock_t ticks, clock_t slack)
+{
+  clock_t limit = ticks + slack;
+  clock_t mask  = ticks ^ limit;
+
+  if (slack == 0 || limit < ticks)
+    {
+      return ticks;
+    }
+
+  /* Clear all of the bits of limit below the highest one that differs
+   * from ticks; the result is still within [ticks, limit].
+   */
+
+  mask = ((clock_t)1 << (flsll(mask) - 1)) - 1;
+  return limit & ~mask;
+}
+
+/****************************************************************************
+ * Name: wd_start_slack
+ *
+ * Description:
+ *   Like wd_start(), but the timer may expire up to 'slack' ticks late so
+ *   that it can share a timer interrupt with other timers.  See
+ *   wd_slack_abstick().  Without CONFIG_SCHED_TIMER_SLACK the timer is
+ *   exact.
+ *
+ * Input Parameters:
+ *   wdog     - Watchdog ID
+ *   delay    - Delay count in clock ticks
+ *   slack    - The maximum extra delay in clock ticks
+ *   wdentry  - Function to call on timeout
+ *   arg      - Parameter to pass to wdentry
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is return to
+ *   indicate the nature of any failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_TIMER_SLACK
+static inline_function
+int wd_start_slack(FAR struct wdog_s *wdog, clock_t delay, clock_t slack,
+                   wdentry_t wdentry, wdparm_t arg)
+{
+  int ret = -EINVAL;
+
+  /* Ensure delay is within the range the wdog can handle. */
+
+  if (delay <= WDOG_MAX_DELAY && slack <= WDOG_MAX_DELAY - delay)
+    {
+      ret = wd_start_abstick(wdog,
+                             wd_slack_abstick(clock_delay2abstick(delay),
+                                              slack),
+                             wdentry, arg);
+    }
+
+  return ret;
+}
+#else
+#  define wd_start_slack(wdog, delay, slack, wdentry, arg) \
+          wd_start(wdog, delay, wdentry, arg)
+#endif
+
 /****************************************************************************
  * Name: wd_start_abstime
  *
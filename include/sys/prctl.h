@@ -69,6 +69,21 @@
  *
  *      char myname[CONFIG_TASK_NAME_SIZE];
  *      prctl(PR_GET_NAME_EXT, myname, pid);
+ *
+ *  PR_SET_TIMERSLACK
+ *    Set the timer slack of the calling thread to (unsigned long) arg2
+ *    nanoseconds, rounded down to clock ticks.  The timed waits of the
+ *    thread may then expire that much later to share a timer interrupt
+ *    with other timers.  A slack of zero makes them exact.  The slack is
+ *    reset to zero whenever the thread is given a real-time policy
+ *    (SCHED_FIFO, SCHED_RR or SCHED_DEADLINE).  Requires
+ *    CONFIG_SCHED_TIMER_SLACK.  As an example:
+ *
+ *      prctl(PR_SET_TIMERSLACK, 100000);
+ *
+ *  PR_GET_TIMERSLACK
+ *    Return the timer slack of the calling thread in nanoseconds, or
+ *    INT_MAX if it is larger than that.
  */
 
 #define PR_SET_NAME     1
@@ -79,6 +94,9 @@
 #define PR_SET_DUMPABLE 5
 #define PR_GET_DUMPABLE 6
 
+#define PR_SET_TIMERSLACK 7
+#define PR_GET_TIMERSLACK 8
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
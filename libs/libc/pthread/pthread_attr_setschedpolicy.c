@@ -66,6 +66,10 @@ int pthread_attr_setschedpolicy(FAR pthread_attr_t *attr, int policy)
 #endif
 #ifdef CONFIG_SCHED_SPORADIC
        && policy != SCHED_SPORADIC
+#endif
+#ifdef CONFIG_SCHED_FAIR
+       && policy != SCHED_BATCH
+       && policy != SCHED_IDLE
 #endif
     ))
     {
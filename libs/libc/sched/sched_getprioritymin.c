@@ -54,6 +54,6 @@
 
 int sched_get_priority_min(int policy)
 {
-  DEBUGASSERT(policy >= SCHED_OTHER && policy <= SCHED_SPORADIC);
+  DEBUGASSERT(policy >= SCHED_OTHER && policy <= SCHED_DEADLINE);
   return SCHED_PRIORITY_MIN;
 }
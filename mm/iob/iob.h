@@ -51,6 +51,25 @@
 #  define iobinfo                _none
 #endif /* CONFIG_DEBUG_FEATURES && CONFIG_IOB_DEBUG */
 
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+#ifdef CONFIG_IOB_PERCPU_CACHE
+/* This describes the free I/O buffers cached by one CPU.  Its lock is only
+ * contended when the caches of all CPUs are drained.
+ */
+
+struct iob_cache_s
+{
+  spinlock_t        ic_lock;   /* Protects the cache */
+  FAR struct iob_s *ic_head;   /* LIFO of the cached I/O buffers */
+  int16_t           ic_count;  /* Number of cached I/O buffers */
+  unsigned long     ic_hits;   /* Allocations served by the cache */
+  unsigned long     ic_misses; /* Allocations which took g_iob_lock */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -98,6 +117,12 @@ extern int16_t g_qentry_wait;
 
 extern volatile spinlock_t g_iob_lock;
 
+#ifdef CONFIG_IOB_PERCPU_CACHE
+/* The free I/O buffers cached by every CPU */
+
+extern struct iob_cache_s g_iob_cache[CONFIG_SMP_NCPUS];
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -137,6 +162,88 @@ FAR struct iob_qentry_s *iob_tryalloc_qentry(void);
 
 FAR struct iob_qentry_s *iob_free_qentry(FAR struct iob_qentry_s *iobq);
 
+/****************************************************************************
+ * Name: iob_free_list
+ *
+ * Description:
+ *   Return a list of I/O buffers from the pool, linked by io_flink, to the
+ *   free list or to the waiters with a single round trip of g_iob_lock.
+ *
+ ****************************************************************************/
+
+void iob_free_list(FAR struct iob_s *iob);
+
+#ifdef CONFIG_IOB_PERCPU_CACHE
+/****************************************************************************
+ * Name: iob_cache_alloc
+ *
+ * Description:
+ *   Take an I/O buffer from the cache of the current CPU.  If the cache is
+ *   empty and refill is true, a batch of buffers is first moved from the
+ *   free list.  NULL is returned if the cache can't serve the request.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_cache_alloc(bool refill);
+
+/****************************************************************************
+ * Name: iob_cache_free
+ *
+ * Description:
+ *   Keep as many I/O buffers of the list, linked by io_flink, as fit in the
+ *   cache of the current CPU, unless a task is waiting for a buffer.  The
+ *   rest of the list is returned.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_cache_free(FAR struct iob_s *iob);
+
+/****************************************************************************
+ * Name: iob_cache_drain
+ *
+ * Description:
+ *   Return the I/O buffers cached by all CPUs to the free list.
+ *
+ ****************************************************************************/
+
+void iob_cache_drain(void);
+#endif
+
+#ifdef CONFIG_IOB_SIZE_CLASSES
+/****************************************************************************
+ * Name: iob_class_initialize
+ *
+ * Description:
+ *   Set up the I/O buffers of the large size classes.
+ *
+ ****************************************************************************/
+
+void iob_class_initialize(void);
+
+/****************************************************************************
+ * Name: iob_class_alloc
+ *
+ * Description:
+ *   Take a buffer from the smallest size class that holds size bytes, or
+ *   from the largest class if none does.  A throttled allocation leaves
+ *   the buffers of every class reserved by IOB_THROTTLE.  NULL is returned
+ *   if no buffer is available.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_class_alloc(unsigned int size, bool throttled);
+
+/****************************************************************************
+ * Name: iob_class_maxsize
+ *
+ * Description:
+ *   Return the payload size of the largest I/O buffer class.
+ *
+ ****************************************************************************/
+
+unsigned int iob_class_maxsize(void);
+#endif
+
 /****************************************************************************
  * Name: iob_notifier_signal
  *
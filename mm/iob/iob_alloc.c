@@ -159,6 +159,14 @@ static FAR struct iob_s *iob_allocwait(bool throttled, unsigned int timeout)
   clock_t start;
   int ret = OK;
 
+#ifdef CONFIG_IOB_PERCPU_CACHE
+  iob = iob_cache_alloc(true);
+  if (iob != NULL)
+    {
+      return iob;
+    }
+#endif
+
 #if CONFIG_IOB_THROTTLE > 0
   /* Select the semaphore to wait. */
 
@@ -193,6 +201,14 @@ static FAR struct iob_s *iob_allocwait(bool throttled, unsigned int timeout)
 
       spin_unlock_irqrestore(&g_iob_lock, flags);
 
+#ifdef CONFIG_IOB_PERCPU_CACHE
+      /* Now that we are counted as a waiter, the buffers cached by the
+       * CPUs are committed to the waiters when they are returned.
+       */
+
+      iob_cache_drain();
+#endif
+
       if (timeout == UINT_MAX)
         {
           ret = nxsem_wait_uninterruptible(sem);
@@ -221,6 +237,51 @@ static FAR struct iob_s *iob_allocwait(bool throttled, unsigned int timeout)
   return iob;
 }
 
+/****************************************************************************
+ * Name: iob_alloc_batch
+ *
+ * Description:
+ *   Allocate up to n I/O buffers without waiting and add them to the head
+ *   of chain.  The cache of this CPU is used up first and the rest is
+ *   taken from the free list with a single round trip of the lock.
+ *
+ * Returned Value:
+ *   The number of I/O buffers allocated.
+ *
+ ****************************************************************************/
+
+static unsigned int iob_alloc_batch(FAR struct iob_s **chain,
+                                    unsigned int n, bool throttled)
+{
+  FAR struct iob_s *iob;
+  unsigned int count = 0;
+  irqstate_t flags;
+
+#ifdef CONFIG_IOB_PERCPU_CACHE
+  while (count < n && (iob = iob_cache_alloc(false)) != NULL)
+    {
+      iob->io_flink = *chain;
+      *chain        = iob;
+      count++;
+    }
+#endif
+
+  if (count < n)
+    {
+      flags = spin_lock_irqsave(&g_iob_lock);
+      while (count < n && (iob = iob_tryalloc_internal(throttled)) != NULL)
+        {
+          iob->io_flink = *chain;
+          *chain        = iob;
+          count++;
+        }
+
+      spin_unlock_irqrestore(&g_iob_lock, flags);
+    }
+
+  return count;
+}
+
 #ifdef CONFIG_IOB_ALLOC
 /****************************************************************************
  * Name: iob_free_dynamic
@@ -301,6 +362,14 @@ FAR struct iob_s *iob_tryalloc(bool throttled)
   FAR struct iob_s *iob;
   irqstate_t flags;
 
+#ifdef CONFIG_IOB_PERCPU_CACHE
+  iob = iob_cache_alloc(true);
+  if (iob != NULL)
+    {
+      return iob;
+    }
+#endif
+
   /* We don't know what context we are called from so we use extreme measures
    * to protect the free list:  We disable interrupts very briefly.
    */
@@ -308,9 +377,123 @@ FAR struct iob_s *iob_tryalloc(bool throttled)
   flags = spin_lock_irqsave(&g_iob_lock);
   iob = iob_tryalloc_internal(throttled);
   spin_unlock_irqrestore(&g_iob_lock, flags);
+
+#ifdef CONFIG_IOB_PERCPU_CACHE
+  if (iob == NULL)
+    {
+      /* The last free buffers may be held by the caches of other CPUs,
+       * take them back before giving up.
+       */
+
+      iob_cache_drain();
+
+      flags = spin_lock_irqsave(&g_iob_lock);
+      iob = iob_tryalloc_internal(throttled);
+      spin_unlock_irqrestore(&g_iob_lock, flags);
+    }
+#endif
+
   return iob;
 }
 
+/****************************************************************************
+ * Name: iob_alloc_chain
+ *
+ * Description:
+ *   Allocate n I/O buffers, waiting as necessary.  As many buffers as
+ *   possible are taken with a single round trip of the lock.
+ *
+ * Input Parameters:
+ *   n          - The number of I/O buffers to allocate.
+ *   throttled  - An indication of the IOB allocation is "throttled"
+ *
+ * Returned Value:
+ *   A list of n empty I/O buffers linked by io_flink, or NULL if they
+ *   can't be allocated.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_alloc_chain(unsigned int n, bool throttled)
+{
+  FAR struct iob_s *chain = NULL;
+  FAR struct iob_s *iob;
+  unsigned int count;
+
+  for (count = iob_alloc_batch(&chain, n, throttled); count < n; count++)
+    {
+      iob = iob_alloc(throttled);
+      if (iob == NULL)
+        {
+          iob_free_chain(chain);
+          return NULL;
+        }
+
+      iob->io_flink = chain;
+      chain         = iob;
+    }
+
+  return chain;
+}
+
+/****************************************************************************
+ * Name: iob_tryalloc_chain
+ *
+ * Description:
+ *   Allocate up to n I/O buffers without waiting, with a single round trip
+ *   of the lock.
+ *
+ * Input Parameters:
+ *   n          - The maximum number of I/O buffers to allocate.
+ *   throttled  - An indication of the IOB allocation is "throttled"
+ *
+ * Returned Value:
+ *   A list of at most n empty I/O buffers linked by io_flink, or NULL if
+ *   no buffer is available.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_tryalloc_chain(unsigned int n, bool throttled)
+{
+  FAR struct iob_s *chain = NULL;
+
+  if (iob_alloc_batch(&chain, n, throttled) == 0 && n > 0)
+    {
+      /* Fall back to iob_tryalloc() which also looks into the caches of
+       * the other CPUs.
+       */
+
+      chain = iob_tryalloc(throttled);
+    }
+
+  return chain;
+}
+
+/****************************************************************************
+ * Name: iob_tryalloc_size
+ *
+ * Description:
+ *   Allocate an I/O buffer which holds at least size bytes, without
+ *   waiting.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_tryalloc_size(unsigned int size, bool throttled)
+{
+  if (size <= CONFIG_IOB_BUFSIZE)
+    {
+      return iob_tryalloc(throttled);
+    }
+
+#ifdef CONFIG_IOB_SIZE_CLASSES
+  if (size <= iob_class_maxsize())
+    {
+      return iob_class_alloc(size, throttled);
+    }
+#endif
+
+  return NULL;
+}
+
 #ifdef CONFIG_IOB_ALLOC
 
 /****************************************************************************
@@ -0,0 +1,196 @@
+/****************************************************************************
+ * mm/iob/iob_cache.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/arch.h>
+#include <nuttx/mm/iob.h>
+
+#include "iob.h"
+
+#ifdef CONFIG_IOB_PERCPU_CACHE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define IOB_CACHE_BATCH (CONFIG_IOB_PERCPU_CACHE_DEPTH / 2)
+
+/* A task is waiting for an I/O buffer, the freed buffers must go to it */
+
+#if CONFIG_IOB_THROTTLE > 0
+#  define IOB_HAVE_WAITERS() (g_iob_count < 0 || g_throttle_wait > 0)
+#else
+#  define IOB_HAVE_WAITERS() (g_iob_count < 0)
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: iob_cache_alloc
+ *
+ * Description:
+ *   Take an I/O buffer from the cache of the current CPU.  If the cache is
+ *   empty and refill is true, a batch of buffers is first moved from the
+ *   free list.  NULL is returned if the cache can't serve the request.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_cache_alloc(bool refill)
+{
+  FAR struct iob_cache_s *cache;
+  FAR struct iob_s *iob;
+  irqstate_t flags;
+
+  flags = up_irq_save();
+  cache = &g_iob_cache[this_cpu()];
+
+  spin_lock(&cache->ic_lock);
+  if (cache->ic_head != NULL)
+    {
+      cache->ic_hits++;
+    }
+  else if (refill)
+    {
+      /* Move a batch of buffers with a single round trip of the global
+       * lock, the buffers reserved for the unthrottled allocations stay
+       * in the free list.
+       */
+
+      spin_lock(&g_iob_lock);
+      while (cache->ic_count < IOB_CACHE_BATCH &&
+             g_iob_count > CONFIG_IOB_THROTTLE &&
+             (iob = g_iob_freelist) != NULL)
+        {
+          g_iob_freelist = iob->io_flink;
+          g_iob_count--;
+
+          iob->io_flink  = cache->ic_head;
+          cache->ic_head = iob;
+          cache->ic_count++;
+        }
+
+      spin_unlock(&g_iob_lock);
+      cache->ic_misses++;
+    }
+
+  iob = cache->ic_head;
+  if (iob != NULL)
+    {
+      cache->ic_head = iob->io_flink;
+      cache->ic_count--;
+
+      /* Put the I/O buffer in a known state */
+
+      iob->io_flink  = NULL; /* Not in a chain */
+      iob->io_len    = 0;    /* Length of the data in the entry */
+      iob->io_offset = 0;    /* Offset to the beginning of data */
+      iob->io_pktlen = 0;    /* Total length of the packet */
+    }
+
+  spin_unlock(&cache->ic_lock);
+  up_irq_restore(flags);
+  return iob;
+}
+
+/****************************************************************************
+ * Name: iob_cache_free
+ *
+ * Description:
+ *   Keep as many I/O buffers of the list, linked by io_flink, as fit in the
+ *   cache of the current CPU, unless a task is waiting for a buffer.  The
+ *   rest of the list is returned.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_cache_free(FAR struct iob_s *iob)
+{
+  FAR struct iob_cache_s *cache;
+  FAR struct iob_s *next;
+  irqstate_t flags;
+
+  flags = up_irq_save();
+  cache = &g_iob_cache[this_cpu()];
+
+  /* The waiters are checked with the cache locked.  A task drains all the
+   * caches after it starts to wait, so a buffer cached here just before
+   * is still found by that drain.
+   */
+
+  spin_lock(&cache->ic_lock);
+  if (!IOB_HAVE_WAITERS())
+    {
+      while (iob != NULL && cache->ic_count < CONFIG_IOB_PERCPU_CACHE_DEPTH)
+        {
+          next           = iob->io_flink;
+          iob->io_flink  = cache->ic_head;
+          cache->ic_head = iob;
+          cache->ic_count++;
+          iob            = next;
+        }
+    }
+
+  spin_unlock(&cache->ic_lock);
+  up_irq_restore(flags);
+  return iob;
+}
+
+/****************************************************************************
+ * Name: iob_cache_drain
+ *
+ * Description:
+ *   Return the I/O buffers cached by all CPUs to the free list.
+ *
+ ****************************************************************************/
+
+void iob_cache_drain(void)
+{
+  FAR struct iob_cache_s *cache;
+  FAR struct iob_s *iob;
+  irqstate_t flags;
+  int cpu;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      cache = &g_iob_cache[cpu];
+
+      flags = spin_lock_irqsave(&cache->ic_lock);
+      iob   = cache->ic_head;
+      cache->ic_head  = NULL;
+      cache->ic_count = 0;
+      spin_unlock_irqrestore(&cache->ic_lock, flags);
+
+      if (iob != NULL)
+        {
+          iob_free_list(iob);
+        }
+    }
+}
+
+#endif /* CONFIG_IOB_PERCPU_CACHE */
@@ -0,0 +1,290 @@
+/****************************************************************************
+ * mm/iob/iob_class.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/nuttx.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/mm/iob.h>
+
+#include "iob.h"
+
+#ifdef CONFIG_IOB_SIZE_CLASSES
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#if CONFIG_IOB_LARGE_BUFSIZE <= CONFIG_IOB_BUFSIZE
+#  error CONFIG_IOB_LARGE_BUFSIZE must be larger than CONFIG_IOB_BUFSIZE
+#endif
+
+#if CONFIG_IOB_HUGE_NBUFFERS > 0
+#  if CONFIG_IOB_HUGE_BUFSIZE <= CONFIG_IOB_LARGE_BUFSIZE
+#    error CONFIG_IOB_HUGE_BUFSIZE must be larger than CONFIG_IOB_LARGE_BUFSIZE
+#  endif
+#  define IOB_NCLASSES    2
+#else
+#  define IOB_NCLASSES    1
+#endif
+
+/* Every buffer of a size class is an iob_s followed by its payload, like the
+ * buffers returned by iob_alloc_dynamic().
+ */
+
+#define IOB_CLASS_CHUNK(s) (ALIGN_UP(sizeof(struct iob_s), IOB_ALIGNMENT) + \
+                            ALIGN_UP(s, IOB_ALIGNMENT))
+
+#define IOB_LARGE_SIZE    (IOB_CLASS_CHUNK(CONFIG_IOB_LARGE_BUFSIZE) * \
+                           CONFIG_IOB_LARGE_NBUFFERS)
+
+#if CONFIG_IOB_HUGE_NBUFFERS > 0
+#  define IOB_HUGE_SIZE   (IOB_CLASS_CHUNK(CONFIG_IOB_HUGE_BUFSIZE) * \
+                           CONFIG_IOB_HUGE_NBUFFERS)
+#else
+#  define IOB_HUGE_SIZE   0
+#endif
+
+#define IOB_CLASS_BUFFER_SIZE (IOB_LARGE_SIZE + IOB_HUGE_SIZE + \
+                               IOB_ALIGNMENT - 1)
+
+/* Every class reserves the same share of its buffers for the unthrottled
+ * allocations as IOB_THROTTLE does of the IOB_NBUFFERS ones, rounded up.
+ */
+
+#if CONFIG_IOB_THROTTLE > 0 && CONFIG_IOB_NBUFFERS > 0
+#  define IOB_CLASS_THROTTLE(n) (((n) * CONFIG_IOB_THROTTLE + \
+                                  CONFIG_IOB_NBUFFERS - 1) / \
+                                 CONFIG_IOB_NBUFFERS)
+#else
+#  define IOB_CLASS_THROTTLE(n) 0
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This describes the pool of one I/O buffer size class */
+
+struct iob_class_s
+{
+  FAR struct iob_s *cl_freelist; /* List of the free I/O buffers */
+  FAR uint8_t      *cl_start;    /* Memory of the pool */
+  FAR uint8_t      *cl_end;
+  uint16_t          cl_bufsize;  /* Payload size of every buffer */
+  int16_t           cl_nbuffers; /* Number of buffers in the pool */
+  int16_t           cl_nfree;    /* Number of free buffers */
+  int16_t           cl_throttle; /* Buffers kept for unthrottled allocs */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef IOB_SECTION
+static uint8_t g_iob_class_buffer[IOB_CLASS_BUFFER_SIZE]
+                                 locate_data(IOB_SECTION);
+#else
+static uint8_t g_iob_class_buffer[IOB_CLASS_BUFFER_SIZE];
+#endif
+
+static struct iob_class_s g_iob_class[IOB_NCLASSES] =
+{
+  {
+    NULL, NULL, NULL, CONFIG_IOB_LARGE_BUFSIZE, CONFIG_IOB_LARGE_NBUFFERS, 0,
+    IOB_CLASS_THROTTLE(CONFIG_IOB_LARGE_NBUFFERS)
+  },
+#if CONFIG_IOB_HUGE_NBUFFERS > 0
+  {
+    NULL, NULL, NULL, CONFIG_IOB_HUGE_BUFSIZE, CONFIG_IOB_HUGE_NBUFFERS, 0,
+    IOB_CLASS_THROTTLE(CONFIG_IOB_HUGE_NBUFFERS)
+  },
+#endif
+};
+
+static spinlock_t g_iob_class_lock = SP_UNLOCKED;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: iob_class_free
+ *
+ * Description:
+ *   The io_free callback of the buffers of the size classes, return the
+ *   buffer to the pool it was carved from.
+ *
+ ****************************************************************************/
+
+static void iob_class_free(FAR void *data)
+{
+  FAR struct iob_s *iob = data;
+  FAR struct iob_class_s *pool;
+  irqstate_t flags;
+  int i;
+
+  for (i = 0; i < IOB_NCLASSES; i++)
+    {
+      pool = &g_iob_class[i];
+      if ((FAR uint8_t *)iob >= pool->cl_start &&
+          (FAR uint8_t *)iob < pool->cl_end)
+        {
+          break;
+        }
+    }
+
+  DEBUGASSERT(i < IOB_NCLASSES);
+
+  flags = spin_lock_irqsave(&g_iob_class_lock);
+  iob->io_flink     = pool->cl_freelist;
+  pool->cl_freelist = iob;
+  pool->cl_nfree++;
+  spin_unlock_irqrestore(&g_iob_class_lock, flags);
+
+  DEBUGASSERT(pool->cl_nfree <= pool->cl_nbuffers);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: iob_class_initialize
+ *
+ * Description:
+ *   Carve the buffers of every size class from the preallocated memory.
+ *
+ ****************************************************************************/
+
+void iob_class_initialize(void)
+{
+  FAR struct iob_class_s *pool;
+  FAR struct iob_s *iob;
+  FAR uint8_t *buf;
+  size_t chunk;
+  int i;
+  int j;
+
+  buf = (FAR uint8_t *)ALIGN_UP((uintptr_t)g_iob_class_buffer,
+                                IOB_ALIGNMENT);
+
+  for (i = 0; i < IOB_NCLASSES; i++)
+    {
+      pool           = &g_iob_class[i];
+      chunk          = IOB_CLASS_CHUNK(pool->cl_bufsize);
+      pool->cl_start = buf;
+
+      for (j = 0; j < pool->cl_nbuffers; j++, buf += chunk)
+        {
+          iob = iob_init_with_data(buf, chunk, iob_class_free);
+
+          iob->io_flink     = pool->cl_freelist;
+          pool->cl_freelist = iob;
+        }
+
+      pool->cl_end   = buf;
+      pool->cl_nfree = pool->cl_nbuffers;
+    }
+}
+
+/****************************************************************************
+ * Name: iob_class_alloc
+ *
+ * Description:
+ *   Take a buffer from the smallest size class that holds size bytes, or
+ *   from the largest class if none does.  A larger class is used when the
+ *   right one is exhausted.  A throttled allocation leaves the buffers of
+ *   every class reserved by IOB_THROTTLE.  NULL is returned if no buffer
+ *   is available.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_class_alloc(unsigned int size, bool throttled)
+{
+  FAR struct iob_class_s *pool;
+  FAR struct iob_s *iob = NULL;
+  irqstate_t flags;
+  int i;
+
+  for (i = 0; i < IOB_NCLASSES - 1; i++)
+    {
+      if (size <= g_iob_class[i].cl_bufsize)
+        {
+          break;
+        }
+    }
+
+  flags = spin_lock_irqsave(&g_iob_class_lock);
+  for (; i < IOB_NCLASSES; i++)
+    {
+      pool = &g_iob_class[i];
+      if (throttled && pool->cl_nfree <= pool->cl_throttle)
+        {
+          continue;
+        }
+
+      iob = pool->cl_freelist;
+      if (iob != NULL)
+        {
+          pool->cl_freelist = iob->io_flink;
+          pool->cl_nfree--;
+          break;
+        }
+    }
+
+  spin_unlock_irqrestore(&g_iob_class_lock, flags);
+
+  if (iob != NULL)
+    {
+      /* Put the I/O buffer in a known state */
+
+      iob->io_flink  = NULL; /* Not in a chain */
+      iob->io_len    = 0;    /* Length of the data in the entry */
+      iob->io_offset = 0;    /* Offset to the beginning of data */
+      iob->io_pktlen = 0;    /* Total length of the packet */
+    }
+
+  return iob;
+}
+
+/****************************************************************************
+ * Name: iob_class_maxsize
+ *
+ * Description:
+ *   Return the payload size of the largest I/O buffer class.
+ *
+ ****************************************************************************/
+
+unsigned int iob_class_maxsize(void)
+{
+  return g_iob_class[IOB_NCLASSES - 1].cl_bufsize;
+}
+
+#endif /* CONFIG_IOB_SIZE_CLASSES */
@@ -44,11 +44,13 @@
  * Name: iob_next
  *
  * Description:
- *   Allocate or reinitialize the next node
+ *   Allocate or reinitialize the next node, len is the number of bytes
+ *   still to be copied.
  *
  ****************************************************************************/
 
-static int iob_next(FAR struct iob_s *iob, bool throttled, bool block)
+static int iob_next(FAR struct iob_s *iob, unsigned int len,
+                    bool throttled, bool block)
 {
   FAR struct iob_s *next = iob->io_flink;
 
@@ -56,6 +58,20 @@ static int iob_next(FAR struct iob_s *iob, bool throttled, bool block)
    * destination I/O buffer chain.
    */
 
+#ifdef CONFIG_IOB_SIZE_CLASSES
+  /* Copy the rest of a large packet to a single large buffer if possible */
+
+  if (next == NULL && len > CONFIG_IOB_BUFSIZE)
+    {
+      next = iob_class_alloc(len, throttled);
+      if (next != NULL)
+        {
+          iob->io_flink = next;
+          return OK;
+        }
+    }
+#endif
+
   if (next == NULL)
     {
       if (block)
@@ -150,7 +166,7 @@ int iob_clone_partial(FAR struct iob_s *iob1, unsigned int len,
       iob2->io_len = avail2;
       offset2     -= iob2->io_len;
 
-      ret = iob_next(iob2, throttled, block);
+      ret = iob_next(iob2, offset2 + len, throttled, block);
       if (ret < 0)
         {
           return ret;
@@ -223,7 +239,7 @@ int iob_clone_partial(FAR struct iob_s *iob1, unsigned int len,
       if ((int)(offset2 + iob2->io_offset - IOB_BUFSIZE(iob2)) >= 0 &&
           iob1 != NULL)
         {
-          ret = iob_next(iob2, throttled, block);
+          ret = iob_next(iob2, len, throttled, block);
           if (ret < 0)
             {
               return ret;
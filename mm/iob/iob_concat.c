@@ -46,19 +46,39 @@
 
 void iob_concat(FAR struct iob_s *iob1, FAR struct iob_s *iob2)
 {
-  /* Combine the total packet size */
-
-  iob1->io_pktlen += iob2->io_pktlen;
-  iob2->io_pktlen  = 0;
+  FAR struct iob_s *tail = iob1;
 
   /* Find the last buffer in the iob1 buffer chain */
 
-  while (iob1->io_flink)
+  while (tail->io_flink)
+    {
+      tail = tail->io_flink;
+    }
+
+#ifdef CONFIG_IOB_SIZE_CLASSES
+  /* If the last buffer is a large one with enough room left, copy the data
+   * of iob2 there instead of chaining more buffers.
+   */
+
+  if (IOB_BUFSIZE(tail) > CONFIG_IOB_BUFSIZE &&
+      iob2->io_pktlen <= IOB_FREESPACE(tail))
     {
-      iob1 = iob1->io_flink;
+      iob_copyout(&tail->io_data[tail->io_offset + tail->io_len], iob2,
+                  iob2->io_pktlen, 0);
+
+      tail->io_len    += iob2->io_pktlen;
+      iob1->io_pktlen += iob2->io_pktlen;
+      iob_free_chain(iob2);
+      return;
     }
+#endif
+
+  /* Combine the total packet size */
+
+  iob1->io_pktlen += iob2->io_pktlen;
+  iob2->io_pktlen  = 0;
 
   /* Then connect iob2 buffer chain to the end of the iob1 chain */
 
-  iob1->io_flink = iob2;
+  tail->io_flink = iob2;
 }
@@ -57,6 +57,7 @@ static int iob_copyin_internal(FAR struct iob_s *iob, FAR const uint8_t *src,
                                bool throttled, bool can_block)
 {
   FAR struct iob_s *head = iob;
+  FAR struct iob_s *spare = NULL;
   FAR struct iob_s *next;
   FAR uint8_t *dest;
   unsigned int ncopy;
@@ -178,26 +179,45 @@ static int iob_copyin_internal(FAR struct iob_s *iob, FAR const uint8_t *src,
 
       if (len > 0 && !next)
         {
-          /* Yes.. allocate a new buffer.
+          /* Yes.. take a new buffer from the spare ones.  All of the
+           * buffers needed by the rest of the copy are allocated in one
+           * batch, or as a single large buffer if possible.
            *
            * Copy as many bytes as possible. Block if we're allowed.
            */
 
-          if (can_block)
+#ifdef CONFIG_IOB_SIZE_CLASSES
+          if (spare == NULL && len > CONFIG_IOB_BUFSIZE)
             {
-              next = iob_alloc(throttled);
+              spare = iob_class_alloc(len, throttled);
             }
-          else
+#endif
+
+          if (spare == NULL)
             {
-              next = iob_tryalloc(throttled);
+              unsigned int n = (len + CONFIG_IOB_BUFSIZE - 1) /
+                               CONFIG_IOB_BUFSIZE;
+
+              if (can_block)
+                {
+                  spare = iob_alloc_chain(n, throttled);
+                }
+              else
+                {
+                  spare = iob_tryalloc_chain(n, throttled);
+                }
             }
 
+          next = spare;
           if (next == NULL)
             {
               ioberr("ERROR: Failed to allocate I/O buffer\n");
               return -ENOMEM;
             }
 
+          spare          = next->io_flink;
+          next->io_flink = NULL;
+
           /* Add the new, empty I/O buffer to the end of the buffer chain. */
 
           iob->io_flink = next;
@@ -208,6 +228,11 @@ static int iob_copyin_internal(FAR struct iob_s *iob, FAR const uint8_t *src,
       offset = 0;
     }
 
+  if (spare != NULL)
+    {
+      iob_free_chain(spare);
+    }
+
   return total;
 }
 
@@ -46,12 +46,35 @@
 
 void iob_free_chain(FAR struct iob_s *iob)
 {
+  FAR struct iob_s *list = NULL;
   FAR struct iob_s *next;
 
-  /* Free each IOB in the chain -- one at a time to keep the count straight */
+  /* Collect the IOBs of the pool, so that they are returned to the free
+   * list with a single round trip of the lock.
+   */
 
   for (; iob; iob = next)
     {
-      next = iob_free(iob);
+      next = iob->io_flink;
+
+#ifdef CONFIG_IOB_ALLOC
+      if (iob->io_free != NULL)
+        {
+          iob_free(iob);
+          continue;
+        }
+#endif
+
+      iob->io_flink = list;
+      list          = iob;
+    }
+
+#ifdef CONFIG_IOB_PERCPU_CACHE
+  list = iob_cache_free(list);
+#endif
+
+  if (list != NULL)
+    {
+      iob_free_list(list);
     }
 }
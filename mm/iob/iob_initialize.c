@@ -117,6 +117,12 @@ int16_t g_qentry_wait = 0;
 
 volatile spinlock_t g_iob_lock = SP_UNLOCKED;
 
+#ifdef CONFIG_IOB_PERCPU_CACHE
+/* The free I/O buffers cached by every CPU */
+
+struct iob_cache_s g_iob_cache[CONFIG_SMP_NCPUS];
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -174,4 +180,8 @@ void iob_initialize(void)
       g_iob_freeqlist = iobq;
     }
 #endif
+
+#ifdef CONFIG_IOB_SIZE_CLASSES
+  iob_class_initialize();
+#endif
 }
@@ -46,6 +46,9 @@
 
 int iob_navail(bool throttled)
 {
+#ifdef CONFIG_IOB_PERCPU_CACHE
+  int cpu;
+#endif
   int ret;
 
 #if CONFIG_IOB_NBUFFERS > 0
@@ -65,6 +68,17 @@ int iob_navail(bool throttled)
       ret = 0;
     }
 
+#ifdef CONFIG_IOB_PERCPU_CACHE
+  /* The buffers cached by the CPUs are not counted in g_iob_count, but
+   * they serve the throttled allocations too.
+   */
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      ret += g_iob_cache[cpu].ic_count;
+    }
+#endif
+
 #else
   ret = 0;
 #endif
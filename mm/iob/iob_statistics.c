@@ -54,6 +54,10 @@
 
 void iob_getstats(FAR struct iob_stats_s *stats)
 {
+#ifdef CONFIG_IOB_PERCPU_CACHE
+  int cpu;
+
+#endif
   stats->ntotal = CONFIG_IOB_NBUFFERS;
 
   stats->nfree = g_iob_count;
@@ -74,6 +78,23 @@ void iob_getstats(FAR struct iob_stats_s *stats)
     {
       stats->nthrottle = 0;
     }
+
+#ifdef CONFIG_IOB_PERCPU_CACHE
+  /* The buffers held by the per-CPU caches are free but not counted in
+   * g_iob_count.
+   */
+
+  stats->ncached = 0;
+  stats->nhits   = 0;
+  stats->nmisses = 0;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      stats->ncached += g_iob_cache[cpu].ic_count;
+      stats->nhits   += g_iob_cache[cpu].ic_hits;
+      stats->nmisses += g_iob_cache[cpu].ic_misses;
+    }
+#endif
 }
 
 #endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS &&
@@ -28,6 +28,7 @@
 #include <execinfo.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
 #include <syslog.h>
 
 #include <nuttx/kmalloc.h>
@@ -40,7 +41,29 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
-#define MEMPOOL_HEADER_SIZE (sizeof(sq_entry_t) + CONFIG_MM_NODE_GUARDSIZE)
+/* The per-CPU caches disable the local interrupts and touch the data of
+ * the current CPU, so the userspace copy of the mempool in the protected
+ * and kernel builds keeps using the shared queue only.
+ */
+
+#if defined(CONFIG_MM_MEMPOOL_PERCPU_CACHE) && \
+    (defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__))
+#  define MEMPOOL_PERCPU_CACHE
+#endif
+
+#ifdef MEMPOOL_PERCPU_CACHE
+#  define MEMPOOL_CACHE_DEPTH CONFIG_MM_MEMPOOL_PERCPU_CACHE_DEPTH
+#  define MEMPOOL_CACHE_BATCH (MEMPOOL_CACHE_DEPTH / 2)
+
+/* Only the pools which can expand use the per-CPU caches.  The waiters of
+ * a fixed size pool sleep until a block is released to the shared queue,
+ * and the blocks parked in the caches of the other CPUs would make it run
+ * out earlier than it used to.
+ */
+
+#  define MEMPOOL_CACHEABLE(pool) \
+     ((pool)->expandsize >= MEMPOOL_REALBLOCKSIZE(pool) + MEMPOOL_HEADER_SIZE)
+#endif
 
 #if CONFIG_MM_BACKTRACE >= 0
 #define MEMPOOL_MAGIC_FREE  0x55555555
@@ -100,6 +123,237 @@ static inline void mempool_add_queue(FAR struct mempool_s *pool,
     }
 }
 
+#ifdef MEMPOOL_PERCPU_CACHE
+static FAR sq_entry_t *mempool_cache_alloc(FAR struct mempool_s *pool)
+{
+  FAR struct mempool_cache_s *cache;
+  FAR sq_entry_t *blk;
+  irqstate_t flags;
+
+  /* With the local interrupts disabled nobody else can touch the cache of
+   * this CPU, the pool lock is only needed to refill it.
+   */
+
+  flags = up_irq_save();
+  cache = &pool->cache[this_cpu()];
+  if (cache->head == NULL)
+    {
+      spin_lock(&pool->lock);
+      while (cache->nfree < MEMPOOL_CACHE_BATCH &&
+             (blk = mempool_remove_queue(pool, &pool->queue)) != NULL)
+        {
+          blk->flink  = cache->head;
+          cache->head = blk;
+          cache->nfree++;
+          pool->nalloc++;
+        }
+
+      spin_unlock(&pool->lock);
+    }
+
+  blk = cache->head;
+  if (blk != NULL)
+    {
+      cache->head = blk->flink;
+      cache->nfree--;
+      blk->flink = NULL;
+    }
+
+  up_irq_restore(flags);
+  return blk;
+}
+
+static void mempool_cache_release(FAR struct mempool_s *pool,
+                                  FAR sq_entry_t *blk)
+{
+  FAR struct mempool_cache_s *cache;
+  FAR sq_entry_t *entry;
+  FAR sq_entry_t *next;
+  irqstate_t flags;
+  size_t nkeep;
+
+  flags = up_irq_save();
+  cache = &pool->cache[this_cpu()];
+  if (cache->nfree >= MEMPOOL_CACHE_DEPTH)
+    {
+      /* Keep the recently released blocks at the head of the cache and
+       * return the older ones to the shared queue.
+       */
+
+      entry = cache->head;
+      for (nkeep = 1; nkeep < MEMPOOL_CACHE_DEPTH - MEMPOOL_CACHE_BATCH;
+           nkeep++)
+        {
+          entry = entry->flink;
+        }
+
+      next         = entry->flink;
+      entry->flink = NULL;
+
+      spin_lock(&pool->lock);
+      while (next != NULL)
+        {
+          entry = next;
+          next  = entry->flink;
+          sq_addlast(entry, &pool->queue);
+          pool->nalloc--;
+        }
+
+      spin_unlock(&pool->lock);
+      cache->nfree = nkeep;
+    }
+
+  blk->flink  = cache->head;
+  cache->head = blk;
+  cache->nfree++;
+  up_irq_restore(flags);
+}
+
+static void mempool_cache_drain(FAR struct mempool_s *pool)
+{
+  FAR struct mempool_cache_s *cache;
+  FAR sq_entry_t *blk;
+  irqstate_t flags;
+  int cpu;
+
+  /* Only used when the pool is idle, so the caches of the other CPUs
+   * are stable.
+   */
+
+  flags = spin_lock_irqsave(&pool->lock);
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      cache = &pool->cache[cpu];
+      while ((blk = cache->head) != NULL)
+        {
+          cache->head = blk->flink;
+          sq_addlast(blk, &pool->queue);
+          pool->nalloc--;
+        }
+
+      cache->nfree = 0;
+    }
+
+  spin_unlock_irqrestore(&pool->lock, flags);
+}
+
+static void mempool_cache_flush(FAR struct mempool_s *pool)
+{
+  FAR struct mempool_cache_s *cache;
+  FAR sq_entry_t *blk;
+  irqstate_t flags;
+
+  /* Unlike mempool_cache_drain(), only the cache of this CPU is returned,
+   * so the pool doesn't need to be idle.
+   */
+
+  flags = up_irq_save();
+  cache = &pool->cache[this_cpu()];
+
+  spin_lock(&pool->lock);
+  while ((blk = cache->head) != NULL)
+    {
+      cache->head = blk->flink;
+      sq_addlast(blk, &pool->queue);
+      pool->nalloc--;
+    }
+
+  spin_unlock(&pool->lock);
+  cache->nfree = 0;
+  up_irq_restore(flags);
+}
+
+#ifdef CONFIG_SMP
+static int mempool_cache_flush_handler(FAR void *arg)
+{
+  mempool_cache_flush(arg);
+  return OK;
+}
+#endif
+
+/* On SMP the other CPUs are asked to flush their caches, which can't be
+ * waited for from an interrupt handler, so only the local cache is flushed
+ * there.
+ */
+
+static void mempool_cache_flush_all(FAR struct mempool_s *pool)
+{
+#ifdef CONFIG_SMP
+  if (!up_interrupt_context())
+    {
+      nxsched_smp_call((1 << CONFIG_SMP_NCPUS) - 1,
+                       mempool_cache_flush_handler, pool);
+    }
+  else
+#endif
+    {
+      mempool_cache_flush(pool);
+    }
+}
+
+/* Called with the pool lock held, which keeps the refill and flush of the
+ * caches away while the counts are summed up.
+ */
+
+static size_t mempool_cache_count(FAR struct mempool_s *pool)
+{
+  size_t count = 0;
+  int cpu;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      count += pool->cache[cpu].nfree;
+    }
+
+  return count;
+}
+#endif
+
+static size_t mempool_count_range(FAR sq_queue_t *queue,
+                                  FAR const char *base, FAR const char *end)
+{
+  FAR sq_entry_t *entry;
+  size_t count = 0;
+
+  sq_for_every(queue, entry)
+    {
+      if ((FAR char *)entry >= base && (FAR char *)entry < end)
+        {
+          count++;
+        }
+    }
+
+  return count;
+}
+
+static void mempool_remove_range(FAR sq_queue_t *queue,
+                                 FAR const char *base, FAR const char *end)
+{
+  FAR sq_entry_t *prev = NULL;
+  FAR sq_entry_t *entry;
+  FAR sq_entry_t *next;
+
+  for (entry = sq_peek(queue); entry != NULL; entry = next)
+    {
+      next = sq_next(entry);
+      if ((FAR char *)entry >= base && (FAR char *)entry < end)
+        {
+          if (prev == NULL)
+            {
+              sq_remfirst(queue);
+            }
+          else
+            {
+              sq_remafter(prev, queue);
+            }
+        }
+      else
+        {
+          prev = entry;
+        }
+    }
+}
+
 #if CONFIG_MM_BACKTRACE >= 0
 static inline void mempool_add_backtrace(FAR struct mempool_s *pool,
                                          FAR struct mempool_backtrace_s *buf)
@@ -269,6 +523,9 @@ int mempool_init(FAR struct mempool_s *pool, FAR const char *name)
   sq_init(&pool->iqueue);
   sq_init(&pool->equeue);
   pool->nalloc = 0;
+#ifdef MEMPOOL_PERCPU_CACHE
+  memset(pool->cache, 0, sizeof(pool->cache));
+#endif
   if (pool->interruptsize >= blocksize)
     {
       size_t ninterrupt = pool->interruptsize / blocksize;
@@ -353,6 +610,20 @@ FAR void *mempool_allocate(FAR struct mempool_s *pool)
 {
   FAR sq_entry_t *blk;
   irqstate_t flags;
+#ifdef MEMPOOL_PERCPU_CACHE
+  bool flushed = false;
+#endif
+
+#ifdef MEMPOOL_PERCPU_CACHE
+  if (MEMPOOL_CACHEABLE(pool))
+    {
+      blk = mempool_cache_alloc(pool);
+      if (blk != NULL)
+        {
+          goto out;
+        }
+    }
+#endif
 
 retry:
   flags = spin_lock_irqsave(&pool->lock);
@@ -382,6 +653,19 @@ retry:
 
               if (base == NULL)
                 {
+#ifdef MEMPOOL_PERCPU_CACHE
+                  /* Take the free blocks parked in the caches of the
+                   * other CPUs before giving up.
+                   */
+
+                  if (!flushed)
+                    {
+                      mempool_cache_flush_all(pool);
+                      flushed = true;
+                      goto retry;
+                    }
+#endif
+
                   return NULL;
                 }
 
@@ -408,6 +692,9 @@ retry:
   pool->nalloc++;
   spin_unlock_irqrestore(&pool->lock, flags);
 
+#ifdef MEMPOOL_PERCPU_CACHE
+out:
+#endif
 #if CONFIG_MM_BACKTRACE >= 0
   mempool_add_backtrace(pool, (FAR struct mempool_backtrace_s *)
                               ((FAR char *)blk + pool->blocksize));
@@ -434,16 +721,40 @@ retry:
 
 void mempool_release(FAR struct mempool_s *pool, FAR void *blk)
 {
-  irqstate_t flags = spin_lock_irqsave(&pool->lock);
+  irqstate_t flags;
 #if CONFIG_MM_BACKTRACE >= 0
   FAR struct mempool_backtrace_s *buf =
     (FAR struct mempool_backtrace_s *)((FAR char *)blk + pool->blocksize);
+#endif
+
+#ifdef MEMPOOL_PERCPU_CACHE
+  if (MEMPOOL_CACHEABLE(pool) &&
+      (pool->ibase == NULL || (FAR char *)blk < pool->ibase ||
+       (FAR char *)blk >= pool->ibase + pool->interruptsize))
+    {
+#  if CONFIG_MM_BACKTRACE >= 0
+      /* Check double free or out of out of bounds */
 
+      DEBUGASSERT(buf->magic == MEMPOOL_MAGIC_ALLOC);
+      buf->magic = MEMPOOL_MAGIC_FREE;
+#  endif
+
+#  ifdef CONFIG_MM_FILL_ALLOCATIONS
+      memset(blk, MM_FREE_MAGIC, pool->blocksize);
+#  endif
+
+      kasan_poison(blk, pool->blocksize);
+      mempool_cache_release(pool, blk);
+      return;
+    }
+#endif
+
+  flags = spin_lock_irqsave(&pool->lock);
+#if CONFIG_MM_BACKTRACE >= 0
   /* Check double free or out of out of bounds */
 
   DEBUGASSERT(buf->magic == MEMPOOL_MAGIC_ALLOC);
   buf->magic = MEMPOOL_MAGIC_FREE;
-
 #endif
 
   pool->nalloc--;
@@ -501,6 +812,9 @@ int mempool_info(FAR struct mempool_s *pool, FAR struct mempoolinfo_s *info)
 {
   size_t blocksize = MEMPOOL_REALBLOCKSIZE(pool);
   irqstate_t flags;
+#ifdef MEMPOOL_PERCPU_CACHE
+  size_t ncached;
+#endif
 
   DEBUGASSERT(pool != NULL && info != NULL);
 
@@ -508,6 +822,13 @@ int mempool_info(FAR struct mempool_s *pool, FAR struct mempoolinfo_s *info)
   info->ordblks = sq_count(&pool->queue);
   info->iordblks = sq_count(&pool->iqueue);
   info->aordblks = pool->nalloc;
+#ifdef MEMPOOL_PERCPU_CACHE
+  /* The blocks in the per-CPU caches are free from user's view */
+
+  ncached = mempool_cache_count(pool);
+  info->ordblks += ncached;
+  info->aordblks -= ncached;
+#endif
   info->arena = sq_count(&pool->equeue) * MEMPOOL_HEADER_SIZE +
     (info->aordblks + info->ordblks + info->iordblks) * blocksize;
   spin_unlock_irqrestore(&pool->lock, flags);
@@ -547,14 +868,24 @@ mempool_info_task(FAR struct mempool_s *pool,
       size_t count = sq_count(&pool->queue) +
                      sq_count(&pool->iqueue);
 
+#ifdef MEMPOOL_PERCPU_CACHE
+      count += mempool_cache_count(pool);
+#endif
       spin_unlock_irqrestore(&pool->lock, flags);
       info.aordblks += count;
       info.uordblks += count * blocksize;
     }
   else if (task->pid == PID_MM_ALLOC)
     {
-      info.aordblks += pool->nalloc;
-      info.uordblks += pool->nalloc * blocksize;
+      irqstate_t flags = spin_lock_irqsave(&pool->lock);
+      size_t count = pool->nalloc;
+
+#ifdef MEMPOOL_PERCPU_CACHE
+      count -= mempool_cache_count(pool);
+#endif
+      spin_unlock_irqrestore(&pool->lock, flags);
+      info.aordblks += count;
+      info.uordblks += count * blocksize;
     }
 #if CONFIG_MM_BACKTRACE >= 0
   else
@@ -608,6 +939,108 @@ void mempool_memdump(FAR struct mempool_s *pool,
 #endif
 }
 
+/****************************************************************************
+ * Name: mempool_reclaim
+ *
+ * Description:
+ *   Return the free blocks cached by the CPUs to the pool and give every
+ *   expanded chunk whose blocks are all free back to the heap.  The
+ *   initial chunk and the interrupt blocks are always kept.  On SMP the
+ *   other CPUs are asked to flush their caches, which can't be waited for
+ *   from an interrupt handler, so only the local cache is flushed there.
+ *
+ * Input Parameters:
+ *   pool    - Address of the memory pool to be used.
+ *
+ * Returned Value:
+ *   The number of bytes given back to the heap.
+ ****************************************************************************/
+
+size_t mempool_reclaim(FAR struct mempool_s *pool)
+{
+  size_t blocksize = MEMPOOL_REALBLOCKSIZE(pool);
+  FAR sq_entry_t *prev;
+  FAR sq_entry_t *entry;
+  irqstate_t flags;
+  FAR char *base;
+  size_t nexpand;
+  size_t index = 0;
+  size_t size;
+  size_t ret = 0;
+  size_t i;
+
+  if (pool->expandsize < blocksize + MEMPOOL_HEADER_SIZE)
+    {
+      return 0;
+    }
+
+#ifdef MEMPOOL_PERCPU_CACHE
+  mempool_cache_flush_all(pool);
+#endif
+
+  nexpand = (pool->expandsize - MEMPOOL_HEADER_SIZE) / blocksize;
+  size    = nexpand * blocksize + MEMPOOL_HEADER_SIZE;
+
+  /* The header of every chunk is queued to equeue at the end of the
+   * chunk, the initial chunk comes first and the new chunks are appended.
+   */
+
+  if (pool->initialsize >= blocksize + MEMPOOL_HEADER_SIZE)
+    {
+      index++;
+    }
+
+  /* Counting the free blocks of a chunk walks the whole free queue, so
+   * the lock is dropped between the chunks to bound the time spent with
+   * the interrupts disabled.
+   */
+
+  for (; ; )
+    {
+      flags = spin_lock_irqsave(&pool->lock);
+      prev  = NULL;
+      entry = sq_peek(&pool->equeue);
+      for (i = 0; entry != NULL && i < index; i++)
+        {
+          prev  = entry;
+          entry = sq_next(entry);
+        }
+
+      if (entry == NULL)
+        {
+          spin_unlock_irqrestore(&pool->lock, flags);
+          break;
+        }
+
+      base = (FAR char *)entry - nexpand * blocksize;
+      if (mempool_count_range(&pool->queue, base,
+                              (FAR char *)entry) != nexpand)
+        {
+          spin_unlock_irqrestore(&pool->lock, flags);
+          index++;
+          continue;
+        }
+
+      mempool_remove_range(&pool->queue, base, (FAR char *)entry);
+      if (prev == NULL)
+        {
+          sq_remfirst(&pool->equeue);
+        }
+      else
+        {
+          sq_remafter(prev, &pool->equeue);
+        }
+
+      spin_unlock_irqrestore(&pool->lock, flags);
+
+      base = kasan_unpoison(base, size);
+      pool->free(pool, base);
+      ret += size;
+    }
+
+  return ret;
+}
+
 /****************************************************************************
  * Name: mempool_deinit
  *
@@ -624,6 +1057,10 @@ int mempool_deinit(FAR struct mempool_s *pool)
   FAR sq_entry_t *blk;
   size_t count = 0;
 
+#ifdef MEMPOOL_PERCPU_CACHE
+  mempool_cache_drain(pool);
+#endif
+
   if (pool->nalloc != 0)
     {
       return -EBUSY;
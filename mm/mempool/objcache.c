@@ -0,0 +1,317 @@
+/****************************************************************************
+ * mm/mempool/objcache.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/param.h>
+
+#include <assert.h>
+#include <string.h>
+
+#include <nuttx/cache.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/mutex.h>
+#include <nuttx/nuttx.h>
+#include <nuttx/mm/objcache.h>
+#include <nuttx/mm/shrinker.h>
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The list of all initialized object caches, for objcache_reclaim_all() */
+
+static struct list_node g_objcache_list =
+  LIST_INITIAL_VALUE(g_objcache_list);
+static mutex_t g_objcache_lock = NXMUTEX_INITIALIZER;
+
+#ifdef MM_SHRINKER
+static size_t objcache_shrink(FAR struct mm_shrinker_s *shrinker,
+                              FAR struct mm_heap_s *heap, size_t size);
+
+/* Give the free chunks of all the object caches back when memory runs
+ * low.
+ */
+
+static struct mm_shrinker_s g_objcache_shrinker =
+{
+  LIST_INITIAL_CLEARED_VALUE, "objcache", objcache_shrink
+};
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static FAR void *objcache_chunk_alloc(FAR struct mempool_s *pool,
+                                      size_t size)
+{
+  FAR struct objcache_s *cache = pool->priv;
+
+  return kmm_memalign(cache->align, size);
+}
+
+static void objcache_chunk_free(FAR struct mempool_s *pool, FAR void *addr)
+{
+  kmm_free(addr);
+}
+
+static void objcache_check(FAR struct mempool_s *pool, FAR void *blk)
+{
+  DEBUGASSERT(kmm_heapmember(blk));
+}
+
+#ifdef MM_SHRINKER
+static size_t objcache_shrink(FAR struct mm_shrinker_s *shrinker,
+                              FAR struct mm_heap_s *heap, size_t size)
+{
+  /* The chunks of the object caches come from the kernel heap only */
+
+  if (heap != KRN_HEAP)
+    {
+      return 0;
+    }
+
+  return objcache_reclaim_all();
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: objcache_init
+ *
+ * Description:
+ *   Initialize a cache of objects of the given size.  The free objects
+ *   hold the link of the pool, so unlike the slab caches of other systems
+ *   they are not kept constructed: ctor is called on every allocation and
+ *   dtor on every free.
+ *
+ * Input Parameters:
+ *   cache - Address of the object cache to be initialized.
+ *   name  - The name of the object cache.
+ *   size  - The size of every object.
+ *   align - The alignment of every object, a power of two.  Zero aligns
+ *           the objects to the data cache lines, so that no two objects
+ *           share a line.
+ *   ctor  - Prepares every allocated object, may be NULL.
+ *   dtor  - Tears down every freed object, may be NULL.
+ *   arg   - The argument of ctor and dtor.
+ *
+ * Returned Value:
+ *   Zero on success; A negated errno value is returned on any failure.
+ *
+ ****************************************************************************/
+
+int objcache_init(FAR struct objcache_s *cache, FAR const char *name,
+                  size_t size, size_t align, objcache_ctor_t ctor,
+                  objcache_dtor_t dtor, FAR void *arg)
+{
+  size_t blocksize;
+  int ret;
+
+  if (align == 0)
+    {
+      align = up_get_dcache_linesize();
+    }
+
+  if (align < MM_ALIGN)
+    {
+      align = MM_ALIGN;
+    }
+
+  DEBUGASSERT((align & (align - 1)) == 0);
+
+  /* The free objects hold the link of the pool.  The real size of the
+   * blocks, including the backtrace after every object, is rounded up to
+   * the alignment, so that all the blocks of an aligned chunk are aligned.
+   */
+
+  size = MAX(size, sizeof(sq_entry_t));
+#if CONFIG_MM_BACKTRACE >= 0
+  blocksize = ALIGN_UP(size + sizeof(struct mempool_backtrace_s), align) -
+              sizeof(struct mempool_backtrace_s);
+#else
+  blocksize = ALIGN_UP(size, align);
+#endif
+
+  memset(cache, 0, sizeof(*cache));
+  cache->align           = align;
+  cache->ctor            = ctor;
+  cache->dtor            = dtor;
+  cache->arg             = arg;
+  cache->pool.blocksize  = blocksize;
+  cache->pool.expandsize = MAX(CONFIG_MM_OBJCACHE_EXPAND_SIZE,
+                               MEMPOOL_REALBLOCKSIZE(&cache->pool) +
+                               MEMPOOL_HEADER_SIZE);
+  cache->pool.priv       = cache;
+  cache->pool.alloc      = objcache_chunk_alloc;
+  cache->pool.free       = objcache_chunk_free;
+  cache->pool.check      = objcache_check;
+
+  ret = mempool_init(&cache->pool, name);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  nxmutex_lock(&g_objcache_lock);
+  list_add_tail(&g_objcache_list, &cache->node);
+  nxmutex_unlock(&g_objcache_lock);
+
+#ifdef MM_SHRINKER
+  /* Registered outside of g_objcache_lock, which the shrinker takes */
+
+  mm_shrinker_register(&g_objcache_shrinker);
+#endif
+
+  return 0;
+}
+
+/****************************************************************************
+ * Name: objcache_alloc
+ *
+ * Description:
+ *   Allocate an object from the cache, the cache grows when it is empty.
+ *
+ * Input Parameters:
+ *   cache - Address of the object cache to be used.
+ *
+ * Returned Value:
+ *   The pointer to the allocated object on success; NULL on any failure.
+ *
+ ****************************************************************************/
+
+FAR void *objcache_alloc(FAR struct objcache_s *cache)
+{
+  FAR void *obj = mempool_allocate(&cache->pool);
+
+  if (obj != NULL && cache->ctor != NULL)
+    {
+      cache->ctor(obj, cache->arg);
+    }
+
+  return obj;
+}
+
+/****************************************************************************
+ * Name: objcache_free
+ *
+ * Description:
+ *   Return an object to the cache.
+ *
+ * Input Parameters:
+ *   cache - Address of the object cache to be used.
+ *   obj   - The object allocated by objcache_alloc().
+ *
+ ****************************************************************************/
+
+void objcache_free(FAR struct objcache_s *cache, FAR void *obj)
+{
+  if (cache->dtor != NULL)
+    {
+      cache->dtor(obj, cache->arg);
+    }
+
+  mempool_release(&cache->pool, obj);
+}
+
+/****************************************************************************
+ * Name: objcache_reclaim
+ *
+ * Description:
+ *   Give the memory of the free objects of the cache back to the heap,
+ *   where possible.
+ *
+ * Input Parameters:
+ *   cache - Address of the object cache to be used.
+ *
+ * Returned Value:
+ *   The number of bytes given back to the heap.
+ *
+ ****************************************************************************/
+
+size_t objcache_reclaim(FAR struct objcache_s *cache)
+{
+  return mempool_reclaim(&cache->pool);
+}
+
+/****************************************************************************
+ * Name: objcache_reclaim_all
+ *
+ * Description:
+ *   Call objcache_reclaim() on every initialized object cache.
+ *
+ * Returned Value:
+ *   The number of bytes given back to the heap.
+ *
+ ****************************************************************************/
+
+size_t objcache_reclaim_all(void)
+{
+  FAR struct objcache_s *cache;
+  size_t ret = 0;
+
+  nxmutex_lock(&g_objcache_lock);
+  list_for_every_entry(&g_objcache_list, cache, struct objcache_s, node)
+    {
+      ret += mempool_reclaim(&cache->pool);
+    }
+
+  nxmutex_unlock(&g_objcache_lock);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: objcache_deinit
+ *
+ * Description:
+ *   Deinitialize an object cache, all its objects must have been freed.
+ *
+ * Input Parameters:
+ *   cache - Address of the object cache to be deinitialized.
+ *
+ * Returned Value:
+ *   Zero on success; -EBUSY if some objects are still allocated.
+ *
+ ****************************************************************************/
+
+int objcache_deinit(FAR struct objcache_s *cache)
+{
+  int ret;
+
+  nxmutex_lock(&g_objcache_lock);
+  ret = mempool_deinit(&cache->pool);
+  if (ret >= 0)
+    {
+      list_delete(&cache->node);
+    }
+
+  nxmutex_unlock(&g_objcache_lock);
+  return ret;
+}
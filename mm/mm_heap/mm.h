@@ -29,14 +29,18 @@
 
 #include <nuttx/config.h>
 
+#include <nuttx/clock.h>
 #include <nuttx/mutex.h>
 #include <nuttx/sched.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/wqueue.h>
 #include <nuttx/fs/procfs.h>
 #include <nuttx/lib/math32.h>
 #include <nuttx/mm/mempool.h>
 #include <nuttx/mm/mm.h>
 
 #include <assert.h>
+#include <strings.h>
 #include <sys/types.h>
 #include <stdbool.h>
 #include <string.h>
@@ -113,7 +117,19 @@
 
 #define MM_MIN_CHUNK     (1 << MM_MIN_SHIFT)
 #define MM_MAX_CHUNK     (1 << MM_MAX_SHIFT)
-#define MM_NNODES        (MM_MAX_SHIFT - MM_MIN_SHIFT + 1)
+
+/* Free chunks are kept in a two-level segregated index: the first level
+ * splits the sizes by power of two, the second level splits every power
+ * of two range into MM_SL_COUNT linear classes.  One bitmap bit per level
+ * records which lists are non-empty, so a fitting list is found with two
+ * find-first-set operations.  All chunks >= MM_MAX_CHUNK share the last
+ * list.
+ */
+
+#define MM_SL_SHIFT      (3)
+#define MM_SL_COUNT      (1 << MM_SL_SHIFT)
+#define MM_FL_COUNT      (MM_MAX_SHIFT - MM_MIN_SHIFT + 1)
+#define MM_NNODES        (MM_FL_COUNT * MM_SL_COUNT)
 
 #define MM_GRAN_MASK     (MM_ALIGN - 1)
 #define MM_ALIGN_UP(a)   (((a) + MM_GRAN_MASK) & ~MM_GRAN_MASK)
@@ -158,6 +174,24 @@
 #define MM_PREVNODE_IS_ALLOC(node) (((node)->size & MM_PREVFREE_BIT) == 0)
 #define MM_PREVNODE_IS_FREE(node) (((node)->size & MM_PREVFREE_BIT) != 0)
 
+/* Per-CPU chunk cache geometry.  Cached chunks are binned by their exact
+ * node size in units of MM_ALIGN, so that any chunk found in a bin can
+ * satisfy every request that maps to the same bin.
+ */
+
+#ifdef CONFIG_MM_HEAP_PERCPU_CACHE
+#  define MM_CACHE_MAXCHUNK \
+     MM_ALIGN_UP(CONFIG_MM_HEAP_PERCPU_CACHE_THRESHOLD + MM_ALLOCNODE_OVERHEAD)
+#  define MM_CACHE_NCLASSES  (MM_CACHE_MAXCHUNK / MM_ALIGN)
+#  define MM_CACHE_NDX(size) ((size) / MM_ALIGN - 1)
+
+/* Cached chunks keep MM_ALLOC_BIT set in the heap, so they are marked
+ * with a value derived from their address behind the list link instead.
+ */
+
+#  define MM_CACHE_MAGIC(node) ((uintptr_t)(node) ^ (uintptr_t)0xcac4ec4e)
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -207,6 +241,9 @@ struct mm_freenode_s
 static_assert(MM_SIZEOF_ALLOCNODE <= MM_MIN_CHUNK,
               "Error size for struct mm_allocnode_s\n");
 
+static_assert(MM_MIN_SHIFT >= MM_SL_SHIFT && MM_FL_COUNT < 32,
+              "Error free list index geometry\n");
+
 static_assert(MM_ALIGN >= sizeof(uintptr_t) &&
               (MM_ALIGN & MM_GRAN_MASK) == 0,
               "Error memory alignment\n");
@@ -216,6 +253,46 @@ struct mm_delaynode_s
   FAR struct mm_delaynode_s *flink;
 };
 
+/* This describes the small chunk cache owned by one CPU */
+
+#ifdef CONFIG_MM_HEAP_PERCPU_CACHE
+struct mm_cachenode_s
+{
+  FAR struct mm_cachenode_s *flink;
+  uintptr_t magic;
+};
+
+struct mm_cache_s
+{
+  spinlock_t mc_lock;                                    /* Per-CPU lock */
+  FAR struct mm_cachenode_s *mc_list[MM_CACHE_NCLASSES]; /* Cached chunks */
+  uint16_t mc_count[MM_CACHE_NCLASSES];                  /* Chunks in list */
+  size_t mc_cached;                                      /* Bytes cached */
+  unsigned long mc_hits;                                 /* Allocs from cache */
+  unsigned long mc_misses;                               /* Allocs from heap */
+  unsigned long mc_frees;                                /* Frees to cache */
+  unsigned long mc_drains;                               /* Lists flushed */
+};
+#endif
+
+/* This describes the contention of the heap mutex, the times are kept in
+ * perf ticks and converted by mm_lockinfo().
+ */
+
+#ifdef CONFIG_MM_HEAP_LOCKSTAT
+struct mm_lockstat_s
+{
+  clock_t ml_acquired;                  /* When the mutex was taken */
+  unsigned long ml_nlock;               /* Times the mutex was taken */
+  unsigned long ml_ncontended;          /* Times the mutex was found held */
+  uint64_t ml_waittime;                 /* Total wait time */
+  clock_t ml_waitmax;                   /* Longest wait */
+  uint64_t ml_holdtime;                 /* Total hold time */
+  clock_t ml_holdmax;                   /* Longest hold */
+  struct mm_lockwaiter_s ml_waiter[CONFIG_MM_HEAP_LOCKSTAT_NTASKS];
+};
+#endif
+
 /* This describes one heap (possibly with multiple regions) */
 
 struct mm_heap_s
@@ -245,12 +322,13 @@ struct mm_heap_s
   int mm_nregions;
 #endif
 
-  /* All free nodes are maintained in a doubly linked list.  This
-   * array provides some hooks into the list at various points to
-   * speed up searching of free nodes.
+  /* All free nodes are maintained in size segregated doubly linked
+   * lists.  The bitmaps record which of the lists are non-empty.
    */
 
-  struct mm_freenode_s mm_nodelist[MM_NNODES];
+  uint32_t mm_flbitmap;
+  uint32_t mm_slbitmap[MM_FL_COUNT];
+  FAR struct mm_freenode_s *mm_freelist[MM_NNODES];
 
   /* Free delay list, as sometimes we can't do free immdiately. */
 
@@ -260,6 +338,32 @@ struct mm_heap_s
   size_t mm_delaycount[CONFIG_SMP_NCPUS];
 #endif
 
+  /* Per-CPU small chunk caches, which serve the common small allocation
+   * and free paths without taking mm_lock.
+   */
+
+#ifdef CONFIG_MM_HEAP_PERCPU_CACHE
+  struct mm_cache_s mm_cache[CONFIG_SMP_NCPUS];
+#endif
+
+  /* Latency histogram of the allocations served by the free lists */
+
+#ifdef CONFIG_MM_HEAP_LATENCY_HISTOGRAM
+  unsigned long mm_latency[MM_LATENCY_NBUCKETS];
+#endif
+
+  /* Contention statistics of mm_lock, only updated while holding it */
+
+#ifdef CONFIG_MM_HEAP_LOCKSTAT
+  struct mm_lockstat_s mm_lockstat;
+#endif
+
+  /* Queues the shrinkers when the heap runs below the watermark */
+
+#if CONFIG_MM_SHRINKER_WATERMARK > 0
+  struct work_s mm_shrinkwork;
+#endif
+
   /* The is a multiple mempool of the heap */
 
 #ifdef CONFIG_MM_HEAP_MEMPOOL
@@ -306,27 +410,39 @@ void mm_foreach(FAR struct mm_heap_s *heap, mm_node_handler_t handler,
 
 void mm_delayfree(FAR struct mm_heap_s *heap, FAR void *mem, bool delay);
 
+/* Functions contained in mm_cache.c ****************************************/
+
+#ifdef CONFIG_MM_HEAP_PERCPU_CACHE
+FAR void *mm_cache_alloc(FAR struct mm_heap_s *heap, size_t alignsize);
+bool mm_cache_free(FAR struct mm_heap_s *heap, FAR void *mem);
+bool mm_cache_drain(FAR struct mm_heap_s *heap);
+size_t mm_cache_size(FAR struct mm_heap_s *heap);
+#endif
+
 /****************************************************************************
  * Inline Functions
  ****************************************************************************/
 
 static inline_function int mm_size2ndx(size_t size)
 {
+  int fl;
+  int sl;
+
   DEBUGASSERT(size >= MM_MIN_CHUNK);
   if (size >= MM_MAX_CHUNK)
     {
       return MM_NNODES - 1;
     }
 
-  size >>= MM_MIN_SHIFT;
-  return flsl(size) - 1;
+  fl = flsl(size) - 1;
+  sl = (size >> (fl - MM_SL_SHIFT)) & (MM_SL_COUNT - 1);
+  return ((fl - MM_MIN_SHIFT) << MM_SL_SHIFT) + sl;
 }
 
 static inline_function void mm_addfreechunk(FAR struct mm_heap_s *heap,
                                             FAR struct mm_freenode_s *node)
 {
   FAR struct mm_freenode_s *next;
-  FAR struct mm_freenode_s *prev;
   size_t nodesize = MM_SIZEOF_NODE(node);
   int ndx;
 
@@ -337,25 +453,176 @@ static inline_function void mm_addfreechunk(FAR struct mm_heap_s *heap,
 
   ndx = mm_size2ndx(nodesize);
 
-  /* Now put the new node into the next */
+  /* Now put the new node at the head of the list */
 
-  for (prev = &heap->mm_nodelist[ndx],
-       next = heap->mm_nodelist[ndx].flink;
-       next && next->size && MM_SIZEOF_NODE(next) < nodesize;
-       prev = next, next = next->flink);
-
-  /* Does it go in mid next or at the end? */
-
-  prev->flink = node;
-  node->blink = prev;
+  next = heap->mm_freelist[ndx];
+  node->blink = NULL;
   node->flink = next;
 
   if (next)
     {
-      /* The new node goes between prev and next */
-
       next->blink = node;
     }
+
+  heap->mm_freelist[ndx] = node;
+
+  /* Mark the list as non-empty */
+
+  heap->mm_slbitmap[ndx >> MM_SL_SHIFT] |= 1 << (ndx & (MM_SL_COUNT - 1));
+  heap->mm_flbitmap |= 1 << (ndx >> MM_SL_SHIFT);
+}
+
+static inline_function void mm_delfreechunk(FAR struct mm_heap_s *heap,
+                                            FAR struct mm_freenode_s *node)
+{
+  int ndx;
+
+  DEBUGASSERT(MM_NODE_IS_FREE(node));
+
+  if (node->flink)
+    {
+      DEBUGASSERT(node->flink->blink == node);
+      node->flink->blink = node->blink;
+    }
+
+  if (node->blink)
+    {
+      /* The node is in the middle of a list */
+
+      DEBUGASSERT(node->blink->flink == node);
+      node->blink->flink = node->flink;
+      return;
+    }
+
+  /* The node is the head of its list */
+
+  ndx = mm_size2ndx(MM_SIZEOF_NODE(node));
+  DEBUGASSERT(heap->mm_freelist[ndx] == node);
+
+  heap->mm_freelist[ndx] = node->flink;
+  if (node->flink == NULL)
+    {
+      /* The list became empty, clear its bits in the bitmaps */
+
+      heap->mm_slbitmap[ndx >> MM_SL_SHIFT] &=
+        ~(1 << (ndx & (MM_SL_COUNT - 1)));
+      if (heap->mm_slbitmap[ndx >> MM_SL_SHIFT] == 0)
+        {
+          heap->mm_flbitmap &= ~(1 << (ndx >> MM_SL_SHIFT));
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: mm_findfreechunk
+ *
+ * Description:
+ *   Find a free chunk of at least size bytes in constant time.  The size is
+ *   rounded up to the next class first, so that the head of any non-empty
+ *   list found through the bitmaps is large enough.  Only if no such list
+ *   exists (or the request is beyond MM_MAX_CHUNK), the list of the
+ *   request's own class is searched for a fitting chunk.
+ *
+ ****************************************************************************/
+
+static inline_function FAR struct mm_freenode_s *
+mm_findfreechunk(FAR struct mm_heap_s *heap, size_t size)
+{
+  FAR struct mm_freenode_s *node;
+  uint32_t map;
+  size_t roundup = size;
+  int ndx;
+  int fl;
+
+  if (size < MM_MAX_CHUNK)
+    {
+      roundup += (1 << (flsl(size) - 1 - MM_SL_SHIFT)) - 1;
+    }
+
+  ndx = mm_size2ndx(roundup);
+  fl  = ndx >> MM_SL_SHIFT;
+  map = heap->mm_slbitmap[fl] & (~0u << (ndx & (MM_SL_COUNT - 1)));
+  if (map == 0)
+    {
+      map = heap->mm_flbitmap & (~0u << (fl + 1));
+      if (map != 0)
+        {
+          fl  = ffs(map) - 1;
+          map = heap->mm_slbitmap[fl];
+        }
+    }
+
+  if (map != 0)
+    {
+      ndx = (fl << MM_SL_SHIFT) + ffs(map) - 1;
+      if (ndx < MM_NNODES - 1 || size < MM_MAX_CHUNK)
+        {
+          node = heap->mm_freelist[ndx];
+          DEBUGASSERT(node != NULL && MM_SIZEOF_NODE(node) >= size);
+          return node;
+        }
+    }
+
+  /* Fall back to searching the list of the request's own class */
+
+  for (node = heap->mm_freelist[mm_size2ndx(size)]; node;
+       node = node->flink)
+    {
+      DEBUGASSERT(node->blink == NULL || node->blink->flink == node);
+      if (MM_SIZEOF_NODE(node) >= size)
+        {
+          break;
+        }
+    }
+
+  return node;
+}
+
+/****************************************************************************
+ * Name: mm_node_is_pinned
+ *
+ * Description:
+ *   Return true if the node is an allocated chunk with free chunks on both
+ *   sides, so that it keeps the free memory around it fragmented.
+ *
+ ****************************************************************************/
+
+static inline_function bool
+mm_node_is_pinned(FAR struct mm_allocnode_s *node)
+{
+  FAR struct mm_allocnode_s *next;
+  size_t nodesize = MM_SIZEOF_NODE(node);
+
+  /* The guard nodes at both ends of a region are never pinned */
+
+  if (MM_NODE_IS_FREE(node) || MM_PREVNODE_IS_ALLOC(node) ||
+      nodesize < MM_MIN_CHUNK)
+    {
+      return false;
+    }
+
+  next = (FAR struct mm_allocnode_s *)((FAR char *)node + nodesize);
+  return MM_NODE_IS_FREE(next);
+}
+
+#ifdef CONFIG_MM_HEAP_LATENCY_HISTOGRAM
+static inline_function void mm_latency_record(FAR struct mm_heap_s *heap,
+                                              clock_t start)
+{
+  unsigned long elapsed = perf_gettime() - start;
+  int ndx = 0;
+
+  if (elapsed != 0)
+    {
+      ndx = flsl(elapsed);
+      if (ndx >= MM_LATENCY_NBUCKETS)
+        {
+          ndx = MM_LATENCY_NBUCKETS - 1;
+        }
+    }
+
+  heap->mm_latency[ndx]++;
 }
+#endif
 
 #endif /* __MM_MM_HEAP_MM_H */
@@ -0,0 +1,366 @@
+/****************************************************************************
+ * mm/mm_heap/mm_cache.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <debug.h>
+#include <string.h>
+
+#include <nuttx/mm/mm.h>
+#include <nuttx/mm/kasan.h>
+#include <nuttx/sched_note.h>
+
+#include "mm_heap/mm.h"
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: cache_flush
+ *
+ * Description:
+ *   Return a detached list of cached chunks to the heap.  This is the only
+ *   place where the cache takes mm_lock.
+ *
+ ****************************************************************************/
+
+static void cache_flush(FAR struct mm_heap_s *heap,
+                        FAR struct mm_cachenode_s *list)
+{
+  while (list != NULL)
+    {
+      FAR struct mm_cachenode_s *tmp = list;
+      bool flag;
+
+      flag = kasan_bypass(true);
+      list = list->flink;
+      tmp->magic = 0;
+      kasan_bypass(flag);
+
+      mm_delayfree(heap, tmp, false);
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_cache_alloc
+ *
+ * Description:
+ *   Try to take a chunk of exactly alignsize bytes from the cache of the
+ *   current CPU.
+ *
+ * Input Parameters:
+ *   heap      - The selected heap
+ *   alignsize - The aligned chunk size, including the allocnode overhead
+ *
+ * Returned Value:
+ *   The user memory on success; NULL if the cache can't serve the request.
+ *
+ ****************************************************************************/
+
+FAR void *mm_cache_alloc(FAR struct mm_heap_s *heap, size_t alignsize)
+{
+  FAR struct mm_cachenode_s *tmp = NULL;
+  FAR struct mm_allocnode_s *node;
+  FAR struct mm_cache_s *cache;
+  irqstate_t flags;
+  size_t nodesize;
+  FAR void *ret;
+  bool flag;
+  int ndx;
+
+  if (alignsize > MM_CACHE_MAXCHUNK)
+    {
+      return NULL;
+    }
+
+  ndx   = MM_CACHE_NDX(alignsize);
+  flags = up_irq_save();
+  cache = &heap->mm_cache[this_cpu()];
+
+  spin_lock(&cache->mc_lock);
+  if (cache->mc_list[ndx] != NULL)
+    {
+      tmp = cache->mc_list[ndx];
+
+      flag = kasan_bypass(true);
+      cache->mc_list[ndx] = tmp->flink;
+      tmp->magic = 0;
+      kasan_bypass(flag);
+
+      cache->mc_count[ndx]--;
+      cache->mc_cached -= alignsize;
+      cache->mc_hits++;
+    }
+  else
+    {
+      cache->mc_misses++;
+    }
+
+  spin_unlock(&cache->mc_lock);
+  up_irq_restore(flags);
+
+  if (tmp == NULL)
+    {
+      return NULL;
+    }
+
+  node     = (FAR struct mm_allocnode_s *)
+             ((FAR char *)tmp - MM_SIZEOF_ALLOCNODE);
+  nodesize = MM_SIZEOF_NODE(node);
+  DEBUGASSERT(MM_NODE_IS_ALLOC(node) && nodesize >= alignsize);
+
+  sched_note_heap(NOTE_HEAP_ALLOC, heap, tmp, nodesize, heap->mm_curused);
+
+  MM_ADD_BACKTRACE(heap, node);
+  ret = kasan_unpoison(tmp, nodesize - MM_ALLOCNODE_OVERHEAD);
+#ifdef CONFIG_MM_FILL_ALLOCATIONS
+  memset(ret, MM_ALLOC_MAGIC, alignsize - MM_ALLOCNODE_OVERHEAD);
+#endif
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: mm_cache_free
+ *
+ * Description:
+ *   Try to keep a small chunk in the cache of the current CPU instead of
+ *   returning it to the heap.  The chunk stays marked as allocated in the
+ *   heap, so nobody but the cache can touch it, and carries
+ *   MM_CACHE_MAGIC to catch it being freed again.  When the list of the
+ *   size class is full, the whole list is flushed back to the heap.
+ *
+ * Input Parameters:
+ *   heap - The selected heap
+ *   mem  - The memory to be freed
+ *
+ * Returned Value:
+ *   true if the chunk was absorbed by the cache, otherwise false.
+ *
+ ****************************************************************************/
+
+bool mm_cache_free(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+  FAR struct mm_cachenode_s *flush = NULL;
+  FAR struct mm_cachenode_s *tmp;
+  FAR struct mm_allocnode_s *node;
+  FAR struct mm_cache_s *cache;
+  irqstate_t flags;
+  size_t nodesize;
+  bool flag;
+  int ndx;
+
+  tmp  = kasan_clear_tag(mem);
+  node = (FAR struct mm_allocnode_s *)
+         ((FAR char *)tmp - MM_SIZEOF_ALLOCNODE);
+
+  /* Sanity check against double-frees */
+
+  DEBUGASSERT(MM_NODE_IS_ALLOC(node));
+
+  nodesize = MM_SIZEOF_NODE(node);
+  if (nodesize > MM_CACHE_MAXCHUNK || nodesize < MM_MIN_CHUNK)
+    {
+      return false;
+    }
+
+  /* The heap can't tell a cached chunk from an allocated one */
+
+  flag = kasan_bypass(true);
+  if (tmp->magic == MM_CACHE_MAGIC(tmp))
+    {
+      kasan_bypass(flag);
+      merr("ERROR: Double free of cached chunk %p\n", mem);
+      DEBUGPANIC();
+      return true;
+    }
+
+  kasan_bypass(flag);
+
+#ifdef CONFIG_MM_FILL_ALLOCATIONS
+  memset(mem, MM_FREE_MAGIC, nodesize - MM_ALLOCNODE_OVERHEAD);
+#endif
+
+  kasan_poison(mem, nodesize - MM_ALLOCNODE_OVERHEAD);
+
+#if CONFIG_MM_BACKTRACE >= 0
+  /* The cached chunk is owned by the heap itself, account it like the
+   * trunks of the mempool so that it is not reported as a leak.
+   */
+
+  node->pid = PID_MM_MEMPOOL;
+#endif
+
+  sched_note_heap(NOTE_HEAP_FREE, heap, mem, nodesize, heap->mm_curused);
+
+  ndx   = MM_CACHE_NDX(nodesize);
+  flags = up_irq_save();
+  cache = &heap->mm_cache[this_cpu()];
+
+  spin_lock(&cache->mc_lock);
+  if (cache->mc_count[ndx] >= CONFIG_MM_HEAP_PERCPU_CACHE_DEPTH)
+    {
+      /* Detach the whole list, it is flushed outside of the lock */
+
+      flush = cache->mc_list[ndx];
+      cache->mc_list[ndx] = NULL;
+      cache->mc_cached -= cache->mc_count[ndx] * (ndx + 1) * MM_ALIGN;
+      cache->mc_count[ndx] = 0;
+      cache->mc_drains++;
+    }
+
+  flag = kasan_bypass(true);
+  tmp->flink = cache->mc_list[ndx];
+  tmp->magic = MM_CACHE_MAGIC(tmp);
+  kasan_bypass(flag);
+
+  cache->mc_list[ndx] = tmp;
+  cache->mc_count[ndx]++;
+  cache->mc_cached += (ndx + 1) * MM_ALIGN;
+  cache->mc_frees++;
+
+  spin_unlock(&cache->mc_lock);
+  up_irq_restore(flags);
+
+  cache_flush(heap, flush);
+  return true;
+}
+
+/****************************************************************************
+ * Name: mm_cache_drain
+ *
+ * Description:
+ *   Return the chunks cached by all CPUs back to the heap.
+ *
+ * Input Parameters:
+ *   heap - The selected heap
+ *
+ * Returned Value:
+ *   true if any chunk was returned to the heap.
+ *
+ ****************************************************************************/
+
+bool mm_cache_drain(FAR struct mm_heap_s *heap)
+{
+  FAR struct mm_cachenode_s *list[MM_CACHE_NCLASSES];
+  FAR struct mm_cache_s *cache;
+  irqstate_t flags;
+  bool ret = false;
+  int cpu;
+  int ndx;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      cache = &heap->mm_cache[cpu];
+
+      flags = spin_lock_irqsave(&cache->mc_lock);
+      if (cache->mc_cached != 0)
+        {
+          cache->mc_drains++;
+        }
+
+      for (ndx = 0; ndx < MM_CACHE_NCLASSES; ndx++)
+        {
+          list[ndx] = cache->mc_list[ndx];
+          cache->mc_list[ndx] = NULL;
+          cache->mc_count[ndx] = 0;
+        }
+
+      cache->mc_cached = 0;
+      spin_unlock_irqrestore(&cache->mc_lock, flags);
+
+      for (ndx = 0; ndx < MM_CACHE_NCLASSES; ndx++)
+        {
+          if (list[ndx] != NULL)
+            {
+              cache_flush(heap, list[ndx]);
+              ret = true;
+            }
+        }
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: mm_cache_size
+ *
+ * Description:
+ *   Return the number of bytes held by the caches of all CPUs.
+ *
+ ****************************************************************************/
+
+size_t mm_cache_size(FAR struct mm_heap_s *heap)
+{
+  size_t size = 0;
+  int cpu;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      size += heap->mm_cache[cpu].mc_cached;
+    }
+
+  return size;
+}
+
+/****************************************************************************
+ * Name: mm_cacheinfo
+ *
+ * Description:
+ *   Return the statistics of the per-CPU chunk caches of the heap.
+ *
+ ****************************************************************************/
+
+void mm_cacheinfo(FAR struct mm_heap_s *heap,
+                  FAR struct mm_cacheinfo_s *info)
+{
+  FAR struct mm_cache_s *cache;
+  int cpu;
+  int ndx;
+
+  memset(info, 0, sizeof(*info));
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      cache = &heap->mm_cache[cpu];
+
+      info->hits   += cache->mc_hits;
+      info->misses += cache->mc_misses;
+      info->frees  += cache->mc_frees;
+      info->drains += cache->mc_drains;
+      info->cached += cache->mc_cached;
+
+      for (ndx = 0; ndx < MM_CACHE_NCLASSES; ndx++)
+        {
+          info->nblks += cache->mc_count[ndx];
+        }
+    }
+}
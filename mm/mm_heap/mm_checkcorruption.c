@@ -53,13 +53,14 @@ static void checkcorruption_handler(FAR struct mm_allocnode_s *node,
       FAR struct mm_freenode_s *fnode = (FAR void *)node;
 
       ASSERT(nodesize >= MM_MIN_CHUNK);
-      ASSERT(fnode->blink->flink == fnode);
-      ASSERT(MM_SIZEOF_NODE(fnode->blink) <= nodesize);
+      ASSERT(fnode->blink == NULL ||
+             (fnode->blink->flink == fnode &&
+              mm_size2ndx(MM_SIZEOF_NODE(fnode->blink)) ==
+              mm_size2ndx(nodesize)));
       ASSERT(fnode->flink == NULL ||
-             fnode->flink->blink == fnode);
-      ASSERT(fnode->flink == NULL ||
-             MM_SIZEOF_NODE(fnode->flink) == 0 ||
-             MM_SIZEOF_NODE(fnode->flink) >= nodesize);
+             (fnode->flink->blink == fnode &&
+              mm_size2ndx(MM_SIZEOF_NODE(fnode->flink)) ==
+              mm_size2ndx(nodesize)));
     }
 }
 
@@ -33,6 +33,7 @@
 #include <nuttx/sched_note.h>
 #include <nuttx/mm/mm.h>
 #include <nuttx/mm/kasan.h>
+#include <nuttx/mm/shrinker.h>
 
 #include "mm_heap/mm.h"
 
@@ -238,7 +239,6 @@ mm_initialize_heap(FAR const struct mm_heap_config_s *config)
   FAR const char *name = config->name;
   FAR void *heapstart = config->start;
   size_t heapsize = config->size;
-  int i;
 
   minfo("Heap: name=%s, start=%p size=%zu\n", name, heapstart, heapsize);
   if (heap == NULL)
@@ -271,14 +271,6 @@ mm_initialize_heap(FAR const struct mm_heap_config_s *config)
   memset(heap, 0, sizeof(struct mm_heap_s));
   heap->mm_nokasan = config->nokasan;
 
-  /* Initialize the node array */
-
-  for (i = 1; i < MM_NNODES; i++)
-    {
-      heap->mm_nodelist[i - 1].flink = &heap->mm_nodelist[i];
-      heap->mm_nodelist[i].blink     = &heap->mm_nodelist[i - 1];
-    }
-
   /* Initialize the malloc mutex to one (to support one-at-
    * a-time access to private data sets).
    */
@@ -404,5 +396,10 @@ void mm_uninitialize(FAR struct mm_heap_s *heap)
   procfs_unregister_meminfo(&heap->mm_procfs);
 #  endif
 #endif
+
+#if defined(MM_SHRINKER) && CONFIG_MM_SHRINKER_WATERMARK > 0
+  work_cancel_sync(LPWORK, &heap->mm_shrinkwork);
+#endif
+
   nxmutex_destroy(&heap->mm_lock);
 }
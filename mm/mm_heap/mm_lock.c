@@ -30,6 +30,7 @@
 #include <errno.h>
 #include <assert.h>
 #include <debug.h>
+#include <string.h>
 
 #include <nuttx/arch.h>
 #include <nuttx/mm/kasan.h>
@@ -37,6 +38,150 @@
 
 #include "mm_heap/mm.h"
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_HEAP_LOCKSTAT
+
+/****************************************************************************
+ * Name: lockstat_acquired
+ *
+ * Description:
+ *   Account one acquisition of the heap mutex, which was requested at
+ *   start.  If the mutex was found held, the wait is also charged to the
+ *   calling task in the table of contenders.  Called with the mutex held.
+ *
+ ****************************************************************************/
+
+static void lockstat_acquired(FAR struct mm_heap_s *heap, clock_t start,
+                              bool contended)
+{
+  FAR struct mm_lockstat_s *stat = &heap->mm_lockstat;
+  FAR struct mm_lockwaiter_s *victim = NULL;
+  FAR struct mm_lockwaiter_s *waiter;
+  clock_t now = perf_gettime();
+  clock_t wait = now - start;
+  pid_t pid;
+  int i;
+
+  stat->ml_acquired = now;
+  stat->ml_nlock++;
+  stat->ml_waittime += wait;
+  if (wait > stat->ml_waitmax)
+    {
+      stat->ml_waitmax = wait;
+    }
+
+  if (!contended)
+    {
+      return;
+    }
+
+  stat->ml_ncontended++;
+
+  /* Look for the task, or else for a free entry or the one which waited
+   * the shortest time.
+   */
+
+  pid = _SCHED_GETTID();
+  for (i = 0; i < CONFIG_MM_HEAP_LOCKSTAT_NTASKS; i++)
+    {
+      waiter = &stat->ml_waiter[i];
+      if (waiter->count != 0 && waiter->pid == pid)
+        {
+          waiter->count++;
+          waiter->waittime += wait;
+          return;
+        }
+
+      if (victim == NULL ||
+          (victim->count != 0 &&
+           (waiter->count == 0 || waiter->waittime < victim->waittime)))
+        {
+          victim = waiter;
+        }
+    }
+
+  if (victim->count == 0 || victim->waittime < wait)
+    {
+      victim->pid      = pid;
+      victim->count    = 1;
+      victim->waittime = wait;
+    }
+}
+
+/****************************************************************************
+ * Name: lockstat_released
+ *
+ * Description:
+ *   Account the hold time of the heap mutex before it is released.
+ *
+ ****************************************************************************/
+
+static void lockstat_released(FAR struct mm_heap_s *heap)
+{
+  FAR struct mm_lockstat_s *stat = &heap->mm_lockstat;
+  clock_t hold = perf_gettime() - stat->ml_acquired;
+
+  stat->ml_holdtime += hold;
+  if (hold > stat->ml_holdmax)
+    {
+      stat->ml_holdmax = hold;
+    }
+}
+
+/****************************************************************************
+ * Name: lockstat_ns
+ *
+ * Description:
+ *   Convert the perf ticks to nanoseconds without overflowing on long
+ *   totals.
+ *
+ ****************************************************************************/
+
+static uint64_t lockstat_ns(uint64_t ticks)
+{
+  unsigned long freq = perf_getfreq();
+
+  return ticks / freq * NSEC_PER_SEC + ticks % freq * NSEC_PER_SEC / freq;
+}
+
+/****************************************************************************
+ * Name: lockstat_percentile
+ *
+ * Description:
+ *   Return the upper bound of the latency histogram bucket which holds the
+ *   given percentile of the allocations.
+ *
+ ****************************************************************************/
+
+static unsigned long
+lockstat_percentile(FAR const struct mm_latencyinfo_s *latency,
+                    uint64_t total, unsigned int percent)
+{
+  uint64_t threshold = (total * percent + 99) / 100;
+  uint64_t sum = 0;
+  int i;
+
+  if (total == 0)
+    {
+      return 0;
+    }
+
+  for (i = 0; i < MM_LATENCY_NBUCKETS - 1; i++)
+    {
+      sum += latency->count[i];
+      if (sum >= threshold)
+        {
+          break;
+        }
+    }
+
+  return latency->limit[i];
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -104,10 +249,17 @@ int mm_lock(FAR struct mm_heap_s *heap)
     }
   else
     {
+#ifdef CONFIG_MM_HEAP_LOCKSTAT
+      bool contended = nxmutex_is_locked(&heap->mm_lock);
+      clock_t start = perf_gettime();
+#endif
       int ret = nxmutex_lock(&heap->mm_lock);
       if (ret >= 0)
         {
           kasan_bypass(true);
+#ifdef CONFIG_MM_HEAP_LOCKSTAT
+          lockstat_acquired(heap, start, contended);
+#endif
         }
 
       return 0;
@@ -132,10 +284,67 @@ void mm_unlock(FAR struct mm_heap_s *heap)
     }
 #endif
 
+#ifdef CONFIG_MM_HEAP_LOCKSTAT
+  lockstat_released(heap);
+#endif
+
   kasan_bypass(false);
   DEBUGVERIFY(nxmutex_unlock(&heap->mm_lock));
 }
 
+/****************************************************************************
+ * Name: mm_lockinfo
+ *
+ * Description:
+ *   Return the contention statistics of the heap mutex together with the
+ *   allocation latency percentiles.  The query takes the mutex itself, so
+ *   it is accounted too.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_HEAP_LOCKSTAT
+void mm_lockinfo(FAR struct mm_heap_s *heap, FAR struct mm_lockinfo_s *info)
+{
+  struct mm_latencyinfo_s latency;
+  struct mm_lockstat_s stat;
+  uint64_t total = 0;
+  int i;
+
+  memset(info, 0, sizeof(*info));
+  if (mm_lock(heap) < 0)
+    {
+      return;
+    }
+
+  stat = heap->mm_lockstat;
+  mm_unlock(heap);
+
+  info->nlock      = stat.ml_nlock;
+  info->ncontended = stat.ml_ncontended;
+  info->waittime   = lockstat_ns(stat.ml_waittime);
+  info->waitmax    = lockstat_ns(stat.ml_waitmax);
+  info->holdtime   = lockstat_ns(stat.ml_holdtime);
+  info->holdmax    = lockstat_ns(stat.ml_holdmax);
+
+  for (i = 0; i < CONFIG_MM_HEAP_LOCKSTAT_NTASKS; i++)
+    {
+      info->waiter[i].pid      = stat.ml_waiter[i].pid;
+      info->waiter[i].count    = stat.ml_waiter[i].count;
+      info->waiter[i].waittime = lockstat_ns(stat.ml_waiter[i].waittime);
+    }
+
+  mm_mallinfo_latency(heap, &latency);
+  for (i = 0; i < MM_LATENCY_NBUCKETS; i++)
+    {
+      total += latency.count[i];
+    }
+
+  info->p50 = lockstat_percentile(&latency, total, 50);
+  info->p90 = lockstat_percentile(&latency, total, 90);
+  info->p99 = lockstat_percentile(&latency, total, 99);
+}
+#endif
+
 /****************************************************************************
  * Name: mm_lock_irq
  *
@@ -28,6 +28,7 @@
 
 #include <assert.h>
 #include <debug.h>
+#include <limits.h>
 
 #include <nuttx/mm/mm.h>
 
@@ -69,13 +70,14 @@ static void mallinfo_handler(FAR struct mm_allocnode_s *node, FAR void *arg)
       FAR struct mm_freenode_s *fnode = (FAR void *)node;
 
       DEBUGASSERT(nodesize >= MM_MIN_CHUNK);
-      DEBUGASSERT(fnode->blink->flink == fnode);
-      DEBUGASSERT(MM_SIZEOF_NODE(fnode->blink) <= nodesize);
+      DEBUGASSERT(fnode->blink == NULL ||
+                  (fnode->blink->flink == fnode &&
+                   mm_size2ndx(MM_SIZEOF_NODE(fnode->blink)) ==
+                   mm_size2ndx(nodesize)));
       DEBUGASSERT(fnode->flink == NULL ||
-                  fnode->flink->blink == fnode);
-      DEBUGASSERT(fnode->flink == NULL ||
-                  MM_SIZEOF_NODE(fnode->flink) == 0 ||
-                  MM_SIZEOF_NODE(fnode->flink) >= nodesize);
+                  (fnode->flink->blink == fnode &&
+                   mm_size2ndx(MM_SIZEOF_NODE(fnode->flink)) ==
+                   mm_size2ndx(nodesize)));
 
       info->ordblks++;
       info->fordblks += nodesize;
@@ -113,6 +115,30 @@ static void mallinfo_task_handler(FAR struct mm_allocnode_s *node,
     }
 }
 
+static void fraginfo_handler(FAR struct mm_allocnode_s *node, FAR void *arg)
+{
+  FAR struct mm_fraginfo_s *info = arg;
+  size_t nodesize = MM_SIZEOF_NODE(node);
+  int ndx;
+
+  if (MM_NODE_IS_FREE(node))
+    {
+      ndx = mm_fragndx(nodesize);
+      info->nfree[ndx]++;
+      info->sfree[ndx] += nodesize;
+      info->totalfree  += nodesize;
+      if (nodesize > info->largest)
+        {
+          info->largest = nodesize;
+        }
+    }
+  else if (mm_node_is_pinned(node))
+    {
+      info->npinned++;
+      info->spinned += nodesize;
+    }
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -131,6 +157,9 @@ struct mallinfo mm_mallinfo(FAR struct mm_heap_s *heap)
 #ifdef CONFIG_MM_HEAP_MEMPOOL
   struct mallinfo poolinfo;
 #endif
+#ifdef CONFIG_MM_HEAP_PERCPU_CACHE
+  size_t cached;
+#endif
 
   memset(&info, 0, sizeof(info));
   mm_foreach(heap, mallinfo_handler, &info);
@@ -146,6 +175,14 @@ struct mallinfo mm_mallinfo(FAR struct mm_heap_s *heap)
   info.fordblks += poolinfo.fordblks;
 #endif
 
+#ifdef CONFIG_MM_HEAP_PERCPU_CACHE
+  /* The chunks held by the per-CPU caches are free from user's view */
+
+  cached = mm_cache_size(heap);
+  info.uordblks -= cached;
+  info.fordblks += cached;
+#endif
+
   DEBUGASSERT(info.uordblks + info.fordblks == info.arena);
 
   return info;
@@ -190,7 +227,11 @@ struct mallinfo_task mm_mallinfo_task(FAR struct mm_heap_s *heap,
 
 size_t mm_heapfree(FAR struct mm_heap_s *heap)
 {
+#ifdef CONFIG_MM_HEAP_PERCPU_CACHE
+  return heap->mm_heapsize - heap->mm_curused + mm_cache_size(heap);
+#else
   return heap->mm_heapsize - heap->mm_curused;
+#endif
 }
 
 /****************************************************************************
@@ -204,15 +245,79 @@ size_t mm_heapfree(FAR struct mm_heap_s *heap)
 size_t mm_heapfree_largest(FAR struct mm_heap_s *heap)
 {
   FAR struct mm_freenode_s *node;
-  for (node = heap->mm_nodelist[MM_NNODES - 1].blink; node;
-       node = node->blink)
+  size_t largest = 0;
+  int ndx;
+
+  if (heap->mm_flbitmap == 0)
+    {
+      return 0;
+    }
+
+  /* The largest chunk is in the highest non-empty list */
+
+  ndx = fls(heap->mm_flbitmap) - 1;
+  ndx = (ndx << MM_SL_SHIFT) + fls(heap->mm_slbitmap[ndx]) - 1;
+
+  for (node = heap->mm_freelist[ndx]; node; node = node->flink)
     {
       size_t nodesize = MM_SIZEOF_NODE(node);
-      if (nodesize != 0)
+      if (nodesize > largest)
         {
-          return nodesize;
+          largest = nodesize;
         }
     }
 
-  return 0;
+  return largest;
 }
+
+/****************************************************************************
+ * Name: mm_fraginfo
+ *
+ * Description:
+ *   Return the size distribution of the free chunks and the allocated
+ *   chunks which keep two free chunks from merging.
+ *
+ ****************************************************************************/
+
+void mm_fraginfo(FAR struct mm_heap_s *heap,
+                 FAR struct mm_fraginfo_s *info)
+{
+  memset(info, 0, sizeof(*info));
+
+#ifdef CONFIG_MM_HEAP_PERCPU_CACHE
+  /* The cached chunks would be reported as pinned otherwise */
+
+  mm_cache_drain(heap);
+#endif
+
+  mm_foreach(heap, fraginfo_handler, info);
+}
+
+/****************************************************************************
+ * Name: mm_mallinfo_latency
+ *
+ * Description:
+ *   Return the latency histogram of the allocations served by the free
+ *   lists of the heap.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_HEAP_LATENCY_HISTOGRAM
+void mm_mallinfo_latency(FAR struct mm_heap_s *heap,
+                         FAR struct mm_latencyinfo_s *info)
+{
+  struct timespec ts;
+  int i;
+
+  for (i = 0; i < MM_LATENCY_NBUCKETS - 1; i++)
+    {
+      info->count[i] = heap->mm_latency[i];
+
+      perf_convert((clock_t)1 << i, &ts);
+      info->limit[i] = ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec;
+    }
+
+  info->count[i] = heap->mm_latency[i];
+  info->limit[i] = ULONG_MAX;
+}
+#endif
@@ -33,6 +33,7 @@
 #include <nuttx/arch.h>
 #include <nuttx/mm/mm.h>
 #include <nuttx/mm/kasan.h>
+#include <nuttx/mm/shrinker.h>
 #include <nuttx/sched.h>
 #include <nuttx/sched_note.h>
 
@@ -173,7 +174,12 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
   size_t alignsize;
   size_t nodesize;
   FAR void *ret = NULL;
-  int ndx;
+#ifdef CONFIG_MM_HEAP_PERCPU_CACHE
+  bool drained = false;
+#endif
+#ifdef CONFIG_MM_HEAP_LATENCY_HISTOGRAM
+  clock_t start;
+#endif
 
   /* Free the delay list first */
 
@@ -210,32 +216,33 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
 
   DEBUGASSERT(alignsize >= MM_ALIGN);
 
-  /* We need to hold the MM mutex while we muck with the nodelist. */
+#ifdef CONFIG_MM_HEAP_PERCPU_CACHE
+  /* Try the cache of this CPU first, which doesn't need the MM mutex */
 
-  DEBUGVERIFY(mm_lock(heap));
+  ret = mm_cache_alloc(heap, alignsize);
+  if (ret != NULL)
+    {
+      return ret;
+    }
+#endif
+
+#ifdef CONFIG_MM_HEAP_PERCPU_CACHE
+retry:
+#endif
 
-  /* Convert the request size into a nodelist index */
+  /* We need to hold the MM mutex while we muck with the nodelist. */
 
-  ndx = mm_size2ndx(alignsize);
+#ifdef CONFIG_MM_HEAP_LATENCY_HISTOGRAM
+  start = perf_gettime();
+#endif
+  DEBUGVERIFY(mm_lock(heap));
 
-  /* Search for a large enough chunk in the list of nodes. This list is
-   * ordered by size, but will have occasional zero sized nodes as we visit
-   * other mm_nodelist[] entries.
-   */
+  /* Look up a large enough chunk in the segregated free lists */
 
-  for (node = heap->mm_nodelist[ndx].flink; node; node = node->flink)
-    {
-      DEBUGASSERT(node->blink->flink == node);
-      nodesize = MM_SIZEOF_NODE(node);
-      if (nodesize >= alignsize)
-        {
-          break;
-        }
-    }
+  node = mm_findfreechunk(heap, alignsize);
 
-  /* If we found a node with non-zero size, then this is one to use. Since
-   * the list is ordered, we know that it must be the best fitting chunk
-   * available.
+  /* If we found a node, then this is one to use.  It comes from the
+   * smallest non-empty size class that is guaranteed to fit.
    */
 
   if (node)
@@ -244,16 +251,10 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
       FAR struct mm_freenode_s *next;
       size_t remaining;
 
-      /* Remove the node.  There must be a predecessor, but there may not be
-       * a successor node.
-       */
+      /* Remove the node from its free list */
 
-      DEBUGASSERT(node->blink);
-      node->blink->flink = node->flink;
-      if (node->flink)
-        {
-          node->flink->blink = node->blink;
-        }
+      mm_delfreechunk(heap, node);
+      nodesize = MM_SIZEOF_NODE(node);
 
       /* Get a pointer to the next node in physical memory */
 
@@ -328,6 +329,10 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
                       heap->mm_curused);
     }
 
+#ifdef CONFIG_MM_HEAP_LATENCY_HISTOGRAM
+  mm_latency_record(heap, start);
+#endif
+
   mm_unlock(heap);
 
   if (ret)
@@ -339,6 +344,9 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
 #endif
 #ifdef CONFIG_DEBUG_MM
       minfo("Allocated %p, size %zu\n", ret, alignsize);
+#endif
+#ifdef MM_SHRINKER
+      mm_shrink_watermark(heap, &heap->mm_shrinkwork);
 #endif
     }
 
@@ -351,6 +359,25 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
     }
 #endif
 
+#ifdef CONFIG_MM_HEAP_PERCPU_CACHE
+  /* Try once more after returning the chunks cached by all CPUs */
+
+  else if (!drained && mm_cache_drain(heap))
+    {
+      drained = true;
+      goto retry;
+    }
+#endif
+
+#ifdef MM_SHRINKER
+  /* Try again after the shrinkers gave some memory back */
+
+  else if (mm_shrink(heap, alignsize) > 0)
+    {
+      return mm_malloc(heap, size);
+    }
+#endif
+
 #ifdef CONFIG_DEBUG_MM
   else if (MM_INTERNAL_HEAP(heap))
     {
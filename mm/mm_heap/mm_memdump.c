@@ -30,8 +30,10 @@
 #include <assert.h>
 #include <debug.h>
 #include <execinfo.h>
+#include <string.h>
 
 #include <nuttx/mm/mm.h>
+#include <nuttx/sched.h>
 
 #include "mm_heap/mm.h"
 
@@ -53,6 +55,19 @@ struct mm_memdump_priv_s
 #endif
 };
 
+#if CONFIG_MM_BACKTRACE >= 0
+struct mm_memdump_frag_s
+{
+  FAR struct mm_heap_s *heap;
+  FAR const struct mm_memdump_s *dump;
+  pid_t pid;             /* The task being summed up */
+  unsigned long nblks;   /* Pinned chunks of the task */
+  size_t size;           /* Pinned size of the task */
+  unsigned long nowned;  /* Pinned chunks of all running tasks */
+  size_t sowned;         /* Pinned size of all running tasks */
+};
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -168,6 +183,87 @@ void memdump_dump_pool(FAR struct mm_memdump_priv_s *priv,
 #  define memdump_dump_pool(priv,heap)
 #endif
 
+static void memdump_fraginfo(FAR struct mm_heap_s *heap)
+{
+  struct mm_fraginfo_s info;
+  unsigned int frag = 0;
+  int i;
+
+  mm_fraginfo(heap, &info);
+  if (info.totalfree > 0)
+    {
+      frag = 100 - (unsigned int)((uint64_t)info.largest * 100 /
+                                  info.totalfree);
+    }
+
+  syslog(LOG_INFO, "%12s%12s%12s\n", "Below", "Free Blks", "Free Size");
+  for (i = 0; i < MM_FRAG_NBUCKETS - 1; i++)
+    {
+      syslog(LOG_INFO, "%12zu%12lu%12zu\n",
+             MM_FRAG_LIMIT(i), info.nfree[i], info.sfree[i]);
+    }
+
+  syslog(LOG_INFO, "%12s%12lu%12zu\n", "-", info.nfree[i], info.sfree[i]);
+  syslog(LOG_INFO, "%12s%12s%12s%12s%12s\n",
+         "Total Free", "Largest", "Frag", "Pinned", "Pinned Size");
+  syslog(LOG_INFO, "%12zu%12zu%11u%%%12lu%12zu\n",
+         info.totalfree, info.largest, frag, info.npinned, info.spinned);
+}
+
+#if CONFIG_MM_BACKTRACE >= 0
+static void memdump_frag_handler(FAR struct mm_allocnode_s *node,
+                                 FAR void *arg)
+{
+  FAR struct mm_memdump_frag_s *frag = arg;
+
+  if (MM_NODE_IS_ALLOC(node) && node->pid == frag->pid &&
+      MM_DUMP_SEQNO(frag->dump, node) && mm_node_is_pinned(node))
+    {
+      frag->nblks++;
+      frag->size += MM_SIZEOF_NODE(node);
+    }
+}
+
+static void memdump_frag_task(FAR struct tcb_s *tcb, FAR void *arg)
+{
+  FAR struct mm_memdump_frag_s *frag = arg;
+
+  frag->pid   = tcb->pid;
+  frag->nblks = 0;
+  frag->size  = 0;
+
+  mm_foreach(frag->heap, memdump_frag_handler, frag);
+  if (frag->nblks > 0)
+    {
+      syslog(LOG_INFO, "%6d%12lu%12zu %s\n", (int)tcb->pid, frag->nblks,
+             frag->size, get_task_name(tcb));
+      frag->nowned += frag->nblks;
+      frag->sowned += frag->size;
+    }
+}
+
+/* Sum up the pinned chunks per task, the rest belongs to tasks which have
+ * exited or to the heap itself.
+ */
+
+static void memdump_fragtasks(FAR struct mm_heap_s *heap,
+                              FAR struct mm_memdump_priv_s *priv)
+{
+  struct mm_memdump_frag_s frag;
+
+  memset(&frag, 0, sizeof(frag));
+  frag.heap = heap;
+  frag.dump = priv->dump;
+
+  syslog(LOG_INFO, "%6s%12s%12s %s\n", "PID", "Pinned Blks", "Pinned Size",
+         "Name");
+  nxsched_foreach(memdump_frag_task, &frag);
+  syslog(LOG_INFO, "%6s%12lu%12zu\n", "-",
+         (unsigned long)priv->info.aordblks - frag.nowned,
+         (size_t)priv->info.uordblks - frag.sowned);
+}
+#endif
+
 static void memdump_handler(FAR struct mm_allocnode_s *node, FAR void *arg)
 {
   FAR struct mm_memdump_priv_s *priv = arg;
@@ -195,6 +291,15 @@ static void memdump_handler(FAR struct mm_allocnode_s *node, FAR void *arg)
               memdump_allocnode(node);
             }
         }
+      else if (dump->pid == PID_MM_FRAG && MM_DUMP_SEQNO(dump, node))
+        {
+          if (mm_node_is_pinned(node))
+            {
+              priv->info.aordblks++;
+              priv->info.uordblks += nodesize;
+              memdump_allocnode(node);
+            }
+        }
 #if CONFIG_MM_HEAP_BIGGEST_COUNT > 0
       else if (dump->pid == PID_MM_BIGGEST && MM_DUMP_SEQNO(dump, node))
         {
@@ -207,13 +312,14 @@ static void memdump_handler(FAR struct mm_allocnode_s *node, FAR void *arg)
       FAR struct mm_freenode_s *fnode = (FAR void *)node;
 
       DEBUGASSERT(nodesize >= MM_MIN_CHUNK);
-      DEBUGASSERT(fnode->blink->flink == fnode);
-      DEBUGASSERT(MM_SIZEOF_NODE(fnode->blink) <= nodesize);
-      DEBUGASSERT(fnode->flink == NULL ||
-                  fnode->flink->blink == fnode);
+      DEBUGASSERT(fnode->blink == NULL ||
+                  (fnode->blink->flink == fnode &&
+                   mm_size2ndx(MM_SIZEOF_NODE(fnode->blink)) ==
+                   mm_size2ndx(nodesize)));
       DEBUGASSERT(fnode->flink == NULL ||
-                  MM_SIZEOF_NODE(fnode->flink) == 0 ||
-                  MM_SIZEOF_NODE(fnode->flink) >= nodesize);
+                  (fnode->flink->blink == fnode &&
+                   mm_size2ndx(MM_SIZEOF_NODE(fnode->flink)) ==
+                   mm_size2ndx(nodesize)));
 
       priv->info.aordblks++;
       priv->info.uordblks += nodesize;
@@ -247,6 +353,12 @@ void mm_memdump(FAR struct mm_heap_s *heap,
   memset(&priv, 0, sizeof(struct mm_memdump_priv_s));
   priv.dump = dump;
 
+#ifdef CONFIG_MM_HEAP_PERCPU_CACHE
+  /* Return the cached chunks first, they aren't owned by anyone */
+
+  mm_cache_drain(heap);
+#endif
+
   if (pid == PID_MM_MEMPOOL)
     {
       syslog(LOG_INFO, "Memdump mempool\n");
@@ -301,6 +413,11 @@ void mm_memdump(FAR struct mm_heap_s *heap,
     {
       syslog(LOG_INFO, "Dump allocated orphan nodes\n");
     }
+  else if (pid == PID_MM_FRAG)
+    {
+      syslog(LOG_INFO, "Dump fragmentation, allocated nodes pinned "
+                       "between free nodes\n");
+    }
 
 #if CONFIG_MM_BACKTRACE < 0
   syslog(LOG_INFO, "%12s%9s%*s\n", "Size", "Overhead",
@@ -332,4 +449,12 @@ void mm_memdump(FAR struct mm_heap_s *heap,
 
   syslog(LOG_INFO, "%12s%12s\n", "Total Blks", "Total Size");
   syslog(LOG_INFO, "%12d%12d\n", priv.info.aordblks, priv.info.uordblks);
+
+  if (pid == PID_MM_FRAG)
+    {
+#if CONFIG_MM_BACKTRACE >= 0
+      memdump_fragtasks(heap, &priv);
+#endif
+      memdump_fraginfo(heap);
+    }
 }
@@ -0,0 +1,191 @@
+/****************************************************************************
+ * mm/shrinker/mm_shrinker.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/init.h>
+#include <nuttx/mutex.h>
+#include <nuttx/wqueue.h>
+#include <nuttx/mm/mm.h>
+#include <nuttx/mm/shrinker.h>
+
+#ifdef MM_SHRINKER
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The list of all registered shrinkers.  The lock is held while the
+ * shrinkers run, so that they are not unregistered under our feet and
+ * that an allocation failing inside a shrinker doesn't recurse.
+ */
+
+static struct list_node g_shrinker_list =
+  LIST_INITIAL_VALUE(g_shrinker_list);
+static mutex_t g_shrinker_lock = NXMUTEX_INITIALIZER;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+#if CONFIG_MM_SHRINKER_WATERMARK > 0
+static void mm_shrink_worker(FAR void *arg)
+{
+  FAR struct mm_heap_s *heap = arg;
+  size_t free = mm_heapfree(heap);
+
+  if (free < CONFIG_MM_SHRINKER_WATERMARK)
+    {
+      mm_shrink(heap, CONFIG_MM_SHRINKER_WATERMARK - free);
+    }
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_shrinker_register
+ *
+ * Description:
+ *   Register a shrinker, it is called when memory runs low.  Registering
+ *   a shrinker which is already registered does nothing.
+ *
+ * Input Parameters:
+ *   shrinker - The shrinker, with its name and callback filled in.
+ *
+ ****************************************************************************/
+
+void mm_shrinker_register(FAR struct mm_shrinker_s *shrinker)
+{
+  DEBUGASSERT(shrinker != NULL && shrinker->shrink != NULL);
+
+  nxmutex_lock(&g_shrinker_lock);
+  if (!list_in_list(&shrinker->node))
+    {
+      list_add_tail(&g_shrinker_list, &shrinker->node);
+    }
+
+  nxmutex_unlock(&g_shrinker_lock);
+}
+
+/****************************************************************************
+ * Name: mm_shrinker_unregister
+ *
+ * Description:
+ *   Unregister a shrinker.  It is not called anymore when this returns.
+ *
+ * Input Parameters:
+ *   shrinker - The registered shrinker.
+ *
+ ****************************************************************************/
+
+void mm_shrinker_unregister(FAR struct mm_shrinker_s *shrinker)
+{
+  nxmutex_lock(&g_shrinker_lock);
+  if (list_in_list(&shrinker->node))
+    {
+      list_delete(&shrinker->node);
+      shrinker->node.prev = NULL;
+      shrinker->node.next = NULL;
+    }
+
+  nxmutex_unlock(&g_shrinker_lock);
+}
+
+/****************************************************************************
+ * Name: mm_shrink
+ *
+ * Description:
+ *   Call the shrinkers, in the order of registration, until size bytes are
+ *   freed.  The heap allocators call it before failing an allocation.
+ *   Nothing is done from an interrupt handler or while a shrinker runs.
+ *
+ * Input Parameters:
+ *   heap - The heap which runs low, for the information of the shrinkers.
+ *   size - The number of bytes wanted.
+ *
+ * Returned Value:
+ *   The number of bytes freed.
+ *
+ ****************************************************************************/
+
+size_t mm_shrink(FAR struct mm_heap_s *heap, size_t size)
+{
+  FAR struct mm_shrinker_s *shrinker;
+  size_t freed = 0;
+
+  if (up_interrupt_context() || !OSINIT_OS_READY() ||
+      nxmutex_trylock(&g_shrinker_lock) < 0)
+    {
+      return 0;
+    }
+
+  list_for_every_entry(&g_shrinker_list, shrinker, struct mm_shrinker_s,
+                       node)
+    {
+      freed += shrinker->shrink(shrinker, heap, size - freed);
+      if (freed >= size)
+        {
+          break;
+        }
+    }
+
+  nxmutex_unlock(&g_shrinker_lock);
+  return freed;
+}
+
+/****************************************************************************
+ * Name: mm_shrink_watermark
+ *
+ * Description:
+ *   Called by the heap allocators after every allocation.  If less than
+ *   CONFIG_MM_SHRINKER_WATERMARK bytes are left free, the shrinkers are
+ *   called from the low priority work queue to free the difference.
+ *
+ * Input Parameters:
+ *   heap - The heap which served the allocation.
+ *   work - The work of the heap, so that every heap is queued separately.
+ *
+ ****************************************************************************/
+
+#if CONFIG_MM_SHRINKER_WATERMARK > 0
+void mm_shrink_watermark(FAR struct mm_heap_s *heap,
+                         FAR struct work_s *work)
+{
+  /* The work queue doesn't run before the idle loop */
+
+  if (OSINIT_IDLELOOP() && work_available(work) &&
+      mm_heapfree(heap) < CONFIG_MM_SHRINKER_WATERMARK)
+    {
+      work_queue(LPWORK, work, mm_shrink_worker, heap, 0);
+    }
+}
+#endif
+
+#endif /* MM_SHRINKER */
@@ -42,6 +42,7 @@
 #include <nuttx/mm/mm.h>
 #include <nuttx/mm/kasan.h>
 #include <nuttx/mm/mempool.h>
+#include <nuttx/mm/shrinker.h>
 #include <nuttx/sched_note.h>
 
 #include "tlsf/tlsf.h"
@@ -109,6 +110,12 @@ struct mm_heap_s
   size_t mm_delaycount[CONFIG_SMP_NCPUS];
 #endif
 
+  /* Queues the shrinkers when the heap runs below the watermark */
+
+#if CONFIG_MM_SHRINKER_WATERMARK > 0
+  struct work_s mm_shrinkwork;
+#endif
+
 #if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_MEMINFO)
   struct procfs_meminfo_entry_s mm_procfs;
 #endif
@@ -135,6 +142,13 @@ struct mm_mallinfo_handler_s
   FAR struct mallinfo_task *info;
 };
 
+struct mm_fraginfo_handler_s
+{
+  FAR struct mm_fraginfo_s *info;
+  size_t pending;   /* The size of the used block following a free block */
+  bool   prevfree;  /* The previous block is free */
+};
+
 #if CONFIG_MM_HEAP_BIGGEST_COUNT > 0
 struct mm_tlsf_node_s
 {
@@ -472,6 +486,46 @@ static void mallinfo_handler(FAR void *ptr, size_t size, int used,
     }
 }
 
+/****************************************************************************
+ * Name: fraginfo_handler
+ ****************************************************************************/
+
+static void fraginfo_handler(FAR void *ptr, size_t size, int used,
+                             FAR void *user)
+{
+  FAR struct mm_fraginfo_handler_s *handler = user;
+  FAR struct mm_fraginfo_s *info = handler->info;
+  int ndx;
+
+  if (!used)
+    {
+      /* The used block in between two free blocks is pinned */
+
+      if (handler->pending > 0)
+        {
+          info->npinned++;
+          info->spinned += handler->pending;
+        }
+
+      ndx = mm_fragndx(size);
+      info->nfree[ndx]++;
+      info->sfree[ndx] += size;
+      info->totalfree  += size;
+      if (size > info->largest)
+        {
+          info->largest = size;
+        }
+
+      handler->pending  = 0;
+      handler->prevfree = true;
+    }
+  else
+    {
+      handler->pending  = handler->prevfree ? size : 0;
+      handler->prevfree = false;
+    }
+}
+
 /****************************************************************************
  * Name: mallinfo_task_handler
  ****************************************************************************/
@@ -1425,6 +1479,9 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
 
 #ifdef CONFIG_MM_FILL_ALLOCATIONS
       memset(ret, MM_ALLOC_MAGIC, nodesize);
+#endif
+#ifdef MM_SHRINKER
+      mm_shrink_watermark(heap, &heap->mm_shrinkwork);
 #endif
     }
 
@@ -1437,6 +1494,15 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
     }
 #endif
 
+#ifdef MM_SHRINKER
+  /* Try again after the shrinkers gave some memory back */
+
+  else if (mm_shrink(heap, size) > 0)
+    {
+      return mm_malloc(heap, size);
+    }
+#endif
+
   return ret;
 }
 
@@ -1507,6 +1573,9 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment,
       memdump_backtrace(heap, buf);
 #endif
       ret = kasan_unpoison(ret, nodesize);
+#ifdef MM_SHRINKER
+      mm_shrink_watermark(heap, &heap->mm_shrinkwork);
+#endif
     }
 
 #if CONFIG_MM_FREE_DELAYCOUNT_MAX > 0
@@ -1518,6 +1587,15 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment,
     }
 #endif
 
+#ifdef MM_SHRINKER
+  /* Try again after the shrinkers gave some memory back */
+
+  else if (mm_shrink(heap, size) > 0)
+    {
+      return mm_memalign(heap, alignment, size);
+    }
+#endif
+
   return ret;
 }
 
@@ -1697,6 +1775,10 @@ void mm_uninitialize(FAR struct mm_heap_s *heap)
   procfs_unregister_meminfo(&heap->mm_procfs);
 #  endif
 #endif
+#if defined(MM_SHRINKER) && CONFIG_MM_SHRINKER_WATERMARK > 0
+  work_cancel_sync(LPWORK, &heap->mm_shrinkwork);
+#endif
+
   nxmutex_destroy(&heap->mm_lock);
   tlsf_destroy(&heap->mm_tlsf);
 }
@@ -1737,6 +1819,47 @@ void mm_free_delaylist(FAR struct mm_heap_s *heap)
     }
 }
 
+/****************************************************************************
+ * Name: mm_fraginfo
+ *
+ * Description:
+ *   Return the size distribution of the free blocks and the used blocks
+ *   which keep two free blocks from merging.
+ *
+ ****************************************************************************/
+
+void mm_fraginfo(FAR struct mm_heap_s *heap,
+                 FAR struct mm_fraginfo_s *info)
+{
+  struct mm_fraginfo_handler_s handler;
+#if CONFIG_MM_REGIONS > 1
+  int region;
+#else
+#  define region 0
+#endif
+
+  memset(info, 0, sizeof(struct mm_fraginfo_s));
+  handler.info = info;
+
+  /* Visit each region */
+
+#if CONFIG_MM_REGIONS > 1
+  for (region = 0; region < heap->mm_nregions; region++)
+#endif
+    {
+      handler.pending  = 0;
+      handler.prevfree = false;
+
+      /* Retake the mutex for each region to reduce latencies */
+
+      DEBUGVERIFY(mm_lock(heap));
+      tlsf_walk_pool(heap->mm_heapstart[region],
+                     fraginfo_handler, &handler);
+      mm_unlock(heap);
+    }
+#undef region
+}
+
 /****************************************************************************
  * Name: mm_heapfree
  *
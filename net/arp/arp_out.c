@@ -99,6 +99,58 @@ static const uint8_t g_multicast_ethaddr[3] =
 };
 #endif
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_ARP_SEND_QUEUE
+#ifdef CONFIG_NET_TCP_GSO
+/****************************************************************************
+ * Name: arp_queue_segment
+ *
+ * Description:
+ *   The callback of tcp_gso_segment() for an oversized TCP packet waiting
+ *   for an ARP response.  The request is in progress by now, so arp_out()
+ *   queues the segment.
+ *
+ ****************************************************************************/
+
+static int arp_queue_segment(FAR struct net_driver_s *dev)
+{
+  /* No Ethernet header is built yet */
+
+  dev->d_len = dev->d_iob->io_pktlen;
+  arp_out(dev);
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: arp_queue_out
+ *
+ * Description:
+ *   Queue the IP packet in d_iob until the ARP request for ipaddr is
+ *   answered.  d_gso_size doesn't survive the queue, so an oversized TCP
+ *   packet is split into segments first.
+ *
+ ****************************************************************************/
+
+static void arp_queue_out(FAR struct net_driver_s *dev, in_addr_t ipaddr)
+{
+#ifdef CONFIG_NET_TCP_GSO
+  if (dev->d_gso_size > 0)
+    {
+      tcp_gso_segment(dev, arp_queue_segment);
+      netdev_iob_clear(dev);
+      return;
+    }
+#endif
+
+  arp_queue_iob(dev, ipaddr, dev->d_iob);
+  netdev_iob_clear(dev);
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -276,8 +328,7 @@ void arp_out(FAR struct net_driver_s *dev)
            */
 
 #ifdef CONFIG_NET_ARP_SEND_QUEUE
-          arp_queue_iob(dev, ipaddr, dev->d_iob);
-          netdev_iob_clear(dev);
+          arp_queue_out(dev, ipaddr);
 #else
           dev->d_len = 0;
 #endif
@@ -290,8 +341,7 @@ void arp_out(FAR struct net_driver_s *dev)
 
       arp_update(dev, ipaddr, NULL, 0);
 #ifdef CONFIG_NET_ARP_SEND_QUEUE
-      arp_queue_iob(dev, ipaddr, dev->d_iob);
-      netdev_iob_clear(dev);
+      arp_queue_out(dev, ipaddr);
 #endif
 
       /* The destination address was not in our ARP table, so we overwrite
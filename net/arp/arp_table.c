@@ -56,6 +56,7 @@
 #include <net/ethernet.h>
 
 #include <nuttx/clock.h>
+#include <nuttx/mutex.h>
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/netdev.h>
@@ -93,6 +94,12 @@ struct arp_table_info_s
 
 static struct arp_entry_s g_arptable[CONFIG_NET_ARPTAB_SIZE];
 
+/* Protects g_arptable, packets for different devices are processed in
+ * parallel.
+ */
+
+static mutex_t g_arp_lock = NXMUTEX_INITIALIZER;
+
 static const struct ether_addr g_zero_ethaddr =
 {
   {
@@ -194,8 +201,8 @@ arp_return_old_entry(FAR struct arp_entry_s *e1, FAR struct arp_entry_s *e2)
  *   dev    - Device structure
  *
  * Assumptions:
- *   The network is locked to assure exclusive access to the ARP table.
- *   The return value will become unstable when the network is unlocked.
+ *   The ARP table is locked.  The return value will become unstable when
+ *   the ARP table is unlocked.
  *
  ****************************************************************************/
 
@@ -258,11 +265,31 @@ static void arp_get_arpreq(FAR struct arpreq *output,
 }
 #endif
 
+/****************************************************************************
+ * Name: arp_unreach_work
+ *
+ * Description:
+ *   Drop the packets queued to an entry that got no ARP response in time.
+ *   The table owners cancel this work without waiting for it, since they
+ *   hold g_arp_lock, so the work may run after the entry was resolved,
+ *   replaced or cleared.  If the work was queued again meanwhile, the
+ *   packets belong to that new request and are left to it.
+ *
+ ****************************************************************************/
+
 #ifdef CONFIG_NET_ARP_SEND_QUEUE
 static void arp_unreach_work(FAR void *param)
 {
   FAR struct arp_entry_s *tabptr = (FAR struct arp_entry_s *)param;
-  iob_free_queue(&tabptr->at_queue);
+
+  nxmutex_lock(&g_arp_lock);
+
+  if (work_available(&tabptr->at_work))
+    {
+      iob_free_queue(&tabptr->at_queue);
+    }
+
+  nxmutex_unlock(&g_arp_lock);
 }
 #endif
 
@@ -287,9 +314,6 @@ static void arp_unreach_work(FAR void *param)
  *   Zero (OK) if the ARP table entry was successfully modified.  A negated
  *   errno value is returned on any error.
  *
- * Assumptions
- *   The network is locked to assure exclusive access to the ARP table
- *
  ****************************************************************************/
 
 int arp_update(FAR struct net_driver_s *dev, in_addr_t ipaddr,
@@ -310,6 +334,8 @@ int arp_update(FAR struct net_driver_s *dev, in_addr_t ipaddr,
    * inserted in the ARP table.
    */
 
+  nxmutex_lock(&g_arp_lock);
+
   for (i = 0; i < CONFIG_NET_ARPTAB_SIZE; ++i)
     {
       /* Check if the source IP address of the incoming packet matches
@@ -338,6 +364,7 @@ int arp_update(FAR struct net_driver_s *dev, in_addr_t ipaddr,
 
   if ((tabptr->at_flags & ATF_PERM) != 0 && (flags & ATF_PERM) == 0)
     {
+      nxmutex_unlock(&g_arp_lock);
       return -ENOSPC;
     }
 
@@ -346,12 +373,12 @@ int arp_update(FAR struct net_driver_s *dev, in_addr_t ipaddr,
     {
       /* arp entry will be replaced, clean delayed iobs if exist */
 
-      work_cancel_sync(LPWORK, &tabptr->at_work);
+      work_cancel(LPWORK, &tabptr->at_work);
       iob_free_queue(&tabptr->at_queue);
     }
   else if (found && ethaddr != NULL)
     {
-      work_cancel_sync(LPWORK, &tabptr->at_work);
+      work_cancel(LPWORK, &tabptr->at_work);
       iob_concat_queue(&dev->d_arpout, &tabptr->at_queue);
     }
 #endif
@@ -396,6 +423,8 @@ int arp_update(FAR struct net_driver_s *dev, in_addr_t ipaddr,
     }
 #endif
 
+  nxmutex_unlock(&g_arp_lock);
+
 #ifdef CONFIG_NET_ARP_SEND_QUEUE
   if (!IOB_QEMPTY(&dev->d_arpout))
     {
@@ -437,9 +466,6 @@ int arp_update(FAR struct net_driver_s *dev, in_addr_t ipaddr,
  *   Zero (OK) if the ARP table entry was successfully modified.  A negated
  *   errno value is returned on any error.
  *
- * Assumptions
- *   The network is locked to assure exclusive access to the ARP table
- *
  ****************************************************************************/
 
 void arp_hdr_update(FAR struct net_driver_s *dev, FAR uint16_t *pipaddr,
@@ -467,9 +493,6 @@ void arp_hdr_update(FAR struct net_driver_s *dev, FAR uint16_t *pipaddr,
  *             available.
  *   dev     - Device structure
  *
- * Assumptions
- *   The network is locked to assure exclusive access to the ARP table.
- *
  ****************************************************************************/
 
 int arp_find(in_addr_t ipaddr, FAR uint8_t *ethaddr,
@@ -477,9 +500,12 @@ int arp_find(in_addr_t ipaddr, FAR uint8_t *ethaddr,
 {
   FAR struct arp_entry_s *tabptr;
   struct arp_table_info_s info;
+  int ret = OK;
 
   /* Check if the IPv4 address is already in the ARP table. */
 
+  nxmutex_lock(&g_arp_lock);
+
   tabptr = arp_lookup(ipaddr, dev);
   if (tabptr != NULL)
     {
@@ -494,15 +520,15 @@ int arp_find(in_addr_t ipaddr, FAR uint8_t *ethaddr,
           elapsed = clock_systime_ticks() - tabptr->at_time;
           if (elapsed <= ARP_INPROGRESS_TICK)
             {
-              return -EINPROGRESS;
+              ret = -EINPROGRESS;
             }
           else if (elapsed <= ARP_MAXAGE_UNREACHABLE_TICK)
             {
-              return -ENETUNREACH;
+              ret = -ENETUNREACH;
             }
           else
             {
-              return -ENOENT;
+              ret = -ENOENT;
             }
         }
 
@@ -510,7 +536,7 @@ int arp_find(in_addr_t ipaddr, FAR uint8_t *ethaddr,
        * non-NULL address in 'ethaddr'.
        */
 
-      if (ethaddr != NULL)
+      else if (ethaddr != NULL)
         {
           memcpy(ethaddr, &tabptr->at_ethaddr, ETHER_ADDR_LEN);
         }
@@ -519,9 +545,12 @@ int arp_find(in_addr_t ipaddr, FAR uint8_t *ethaddr,
        * is available for the IP address.
        */
 
-      return OK;
+      nxmutex_unlock(&g_arp_lock);
+      return ret;
     }
 
+  nxmutex_unlock(&g_arp_lock);
+
   /* No.. check if the IPv4 address is the address assigned to a local
    * Ethernet network device.  If so, return a mapping of that IP address
    * to the Ethernet MAC address assigned to the network device.
@@ -550,9 +579,6 @@ int arp_find(in_addr_t ipaddr, FAR uint8_t *ethaddr,
  *   ipaddr - Refers to an IP address in network order
  *   dev    - Device structure
  *
- * Assumptions
- *   The network is locked to assure exclusive access to the ARP table.
- *
  ****************************************************************************/
 
 int arp_delete(in_addr_t ipaddr, FAR struct net_driver_s *dev)
@@ -561,8 +587,12 @@ int arp_delete(in_addr_t ipaddr, FAR struct net_driver_s *dev)
 #ifdef CONFIG_NETLINK_ROUTE
   struct arpreq arp_notify;
 #endif
+  int ret = -ENOENT;
+
   /* Check if the IPv4 address is in the ARP table. */
 
+  nxmutex_lock(&g_arp_lock);
+
   tabptr = arp_lookup(ipaddr, dev);
   if (tabptr != NULL)
     {
@@ -576,10 +606,11 @@ int arp_delete(in_addr_t ipaddr, FAR struct net_driver_s *dev)
       /* Yes.. Set the IP address to zero to "delete" it */
 
       tabptr->at_ipaddr = 0;
-      return OK;
+      ret = OK;
     }
 
-  return -ENOENT;
+  nxmutex_unlock(&g_arp_lock);
+  return ret;
 }
 
 /****************************************************************************
@@ -591,27 +622,28 @@ int arp_delete(in_addr_t ipaddr, FAR struct net_driver_s *dev)
  * Input Parameters:
  *   dev  - The device driver structure
  *
- * Assumptions
- *   The network is locked to assure exclusive access to the ARP table.
- *
  ****************************************************************************/
 
 void arp_cleanup(FAR struct net_driver_s *dev)
 {
   int i;
 
+  nxmutex_lock(&g_arp_lock);
+
   for (i = 0; i < CONFIG_NET_ARPTAB_SIZE; ++i)
     {
       if (dev == g_arptable[i].at_dev)
         {
 #ifdef CONFIG_NET_ARP_SEND_QUEUE
-          work_cancel_sync(LPWORK, &g_arptable[i].at_work);
+          work_cancel(LPWORK, &g_arptable[i].at_work);
           iob_free_queue(&g_arptable[i].at_queue);
 #endif
 
           memset(&g_arptable[i], 0, sizeof(g_arptable[i]));
         }
     }
+
+  nxmutex_unlock(&g_arp_lock);
 }
 
 /****************************************************************************
@@ -629,9 +661,6 @@ void arp_cleanup(FAR struct net_driver_s *dev)
  *   On success, the number of entries actually copied is returned.  Unused
  *   entries are not returned.
  *
- * Assumptions
- *   The network is locked to assure exclusive access to the ARP table
- *
  ****************************************************************************/
 
 #ifdef CONFIG_NETLINK_ROUTE
@@ -645,6 +674,8 @@ unsigned int arp_snapshot(FAR struct arpreq *snapshot,
 
   /* Copy all non-empty, non-expired entries in the ARP table. */
 
+  nxmutex_lock(&g_arp_lock);
+
   for (i = 0, now = clock_systime_ticks(), ncopied = 0;
        nentries > ncopied && i < CONFIG_NET_ARPTAB_SIZE;
        i++)
@@ -658,6 +689,8 @@ unsigned int arp_snapshot(FAR struct arpreq *snapshot,
         }
     }
 
+  nxmutex_unlock(&g_arp_lock);
+
   /* Return the number of entries copied into the user buffer */
 
   return ncopied;
@@ -680,9 +713,6 @@ unsigned int arp_snapshot(FAR struct arpreq *snapshot,
  *   Zero (OK) if the ARP table entry was successfully modified.  A negated
  *   errno value is returned on any error.
  *
- * Assumptions
- *   The network is locked to assure exclusive access to the ARP table
- *
  ****************************************************************************/
 
 #ifdef CONFIG_NET_ARP_SEND_QUEUE
@@ -690,13 +720,17 @@ int arp_queue_iob(FAR struct net_driver_s *dev, in_addr_t ipaddr,
                   FAR struct iob_s *iob)
 {
   FAR struct arp_entry_s *tabptr;
+  int ret = -ENOENT;
 
   /* the IPv4 address should in the ARP table and arp in progress. */
 
+  nxmutex_lock(&g_arp_lock);
+
   tabptr = arp_lookup(ipaddr, dev);
   if (tabptr && memcmp(&tabptr->at_ethaddr, &g_zero_ethaddr,
                        sizeof(tabptr->at_ethaddr)) == 0)
     {
+      ret = -ENOMEM;
       if (iob_tryadd_queue(iob, &tabptr->at_queue) == 0)
         {
           if (work_available(&tabptr->at_work))
@@ -705,13 +739,12 @@ int arp_queue_iob(FAR struct net_driver_s *dev, in_addr_t ipaddr,
                          tabptr, ARP_INPROGRESS_TICK);
             }
 
-          return OK;
+          ret = OK;
         }
-
-      return -ENOMEM;
     }
 
-  return -ENOENT;
+  nxmutex_unlock(&g_arp_lock);
+  return ret;
 }
 #endif
 #endif /* CONFIG_NET_ARP */
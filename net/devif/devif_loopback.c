@@ -33,6 +33,8 @@
 #include <nuttx/net/pkt.h>
 #include <nuttx/net/netdev.h>
 
+#include "utils/utils.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -111,6 +113,18 @@ int devif_loopback(FAR struct net_driver_s *dev)
        pkt_input(dev);
 #endif
 
+#ifdef CONFIG_MM_IOB
+      /* The checksum left to the offload of the device is never completed
+       * for a packet that does not leave the host, and the input path would
+       * drop it.  Finish it here.
+       */
+
+      if ((dev->d_features & (NETDEV_TX_CSUM | NETDEV_TX_CSUM_PARTIAL)) != 0)
+        {
+          net_chksum_finish(dev);
+        }
+#endif
+
       /* We only accept IP packets of the configured type */
 
 #ifdef CONFIG_NET_IPv4
@@ -677,6 +677,14 @@ devif_poll_tcp_connections(FAR struct net_driver_s *dev,
           /* Call back into the driver */
 
           bstop = devif_poll_local_out(dev, callback);
+
+#ifdef CONFIG_NET_TCP_GSO
+          /* Whatever became of the packet, the segment size set by the
+           * poll applies to it only.
+           */
+
+          dev->d_gso_size = 0;
+#endif
         }
     }
 
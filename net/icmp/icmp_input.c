@@ -490,10 +490,13 @@ void icmp_input(FAR struct net_driver_s *dev)
 
       icmp->icmpchksum = 0;
 #ifdef CONFIG_NET_ICMP_CHECKSUMS
-      icmp->icmpchksum = ~icmp_chksum_iob(dev->d_iob);
-      if (icmp->icmpchksum == 0)
+      if ((dev->d_features & NETDEV_TX_CSUM_PARTIAL) == 0)
         {
-          icmp->icmpchksum = 0xffff;
+          icmp->icmpchksum = ~icmp_chksum_iob(dev->d_iob);
+          if (icmp->icmpchksum == 0)
+            {
+              icmp->icmpchksum = 0xffff;
+            }
         }
 #endif
 
@@ -559,7 +559,11 @@ void icmpv6_input(FAR struct net_driver_s *dev, unsigned int iplen)
         icmpv6->chksum = 0;
 
 #ifdef CONFIG_NET_ICMPv6_CHECKSUMS
-        icmpv6->chksum = ~icmpv6_chksum(dev, iplen);
+        if (iplen != IPv6_HDRLEN ||
+            (dev->d_features & NETDEV_TX_CSUM_PARTIAL) == 0)
+          {
+            icmpv6->chksum = ~icmpv6_chksum(dev, iplen);
+          }
 #endif
       }
       break;
@@ -133,10 +133,13 @@ static void sendto_request(FAR struct net_driver_s *dev,
   icmpv6->chksum = 0;
 
 #ifdef CONFIG_NET_ICMPv6_CHECKSUMS
-  icmpv6->chksum = ~icmpv6_chksum(dev, IPv6_HDRLEN);
-  if (icmpv6->chksum == 0)
+  if ((dev->d_features & NETDEV_TX_CSUM_PARTIAL) == 0)
     {
-      icmpv6->chksum = 0xffff;
+      icmpv6->chksum = ~icmpv6_chksum(dev, IPv6_HDRLEN);
+      if (icmpv6->chksum == 0)
+        {
+          icmpv6->chksum = 0xffff;
+        }
     }
 #endif
 
@@ -50,6 +50,7 @@
 #include "inet/inet.h"
 #include "icmp/icmp.h"
 #include "icmpv6/icmpv6.h"
+#include "utils/utils.h"
 #include "ipfrag.h"
 
 /****************************************************************************
@@ -1251,6 +1252,15 @@ int32_t ip_fragout(FAR struct net_driver_s *dev)
       return OK;
     }
 
+#ifdef CONFIG_NET_TCP_GSO
+  /* Oversized TCP packets are split into segments by the driver */
+
+  if (dev->d_gso_size > 0)
+    {
+      return OK;
+    }
+#endif
+
 #ifdef CONFIG_NET_6LOWPAN
   if (dev->d_lltype == NET_LL_IEEE802154 ||
       dev->d_lltype == NET_LL_PKTRADIO)
@@ -1266,6 +1276,11 @@ int32_t ip_fragout(FAR struct net_driver_s *dev)
 
   ninfo("pkt size: %d, MTU: %d\n", dev->d_iob->io_pktlen, mtu);
 
+  if ((dev->d_features & (NETDEV_TX_CSUM | NETDEV_TX_CSUM_PARTIAL)) != 0)
+    {
+      net_chksum_finish(dev);
+    }
+
 #ifdef CONFIG_NET_IPv4
   if (IFF_IS_IPv4(dev->d_flags))
     {
@@ -31,6 +31,7 @@
 
 #include <net/ethernet.h>
 
+#include <nuttx/mutex.h>
 #include <nuttx/net/ip.h>
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/sixlowpan.h>
@@ -42,11 +43,42 @@
  * Public Data
  ****************************************************************************/
 
-/* This is the Neighbor table.  The network should be locked when accessing
+/* This is the Neighbor table.  g_neighbor_lock must be held when accessing
  * this table.
  */
 
 extern struct neighbor_entry_s g_neighbors[CONFIG_NET_IPv6_NCONF_ENTRIES];
+extern mutex_t g_neighbor_lock;
+
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: neighbor_lock
+ *
+ * Description:
+ *   Take the Neighbor Table lock
+ *
+ ****************************************************************************/
+
+static inline_function void neighbor_lock(void)
+{
+  nxmutex_lock(&g_neighbor_lock);
+}
+
+/****************************************************************************
+ * Name: neighbor_unlock
+ *
+ * Description:
+ *   Release the Neighbor Table lock
+ *
+ ****************************************************************************/
+
+static inline_function void neighbor_unlock(void)
+{
+  nxmutex_unlock(&g_neighbor_lock);
+}
 
 /****************************************************************************
  * Public Function Prototypes
@@ -68,6 +100,10 @@ struct net_driver_s; /* Forward reference */
  *   The Neighbor Table entry corresponding to the IPv6 address;  NULL is
  *   returned if there is no matching entry in the Neighbor Table.
  *
+ * Assumptions:
+ *   The Neighbor Table is locked.  The returned entry becomes unstable
+ *   when the table is unlocked.
+ *
  ****************************************************************************/
 
 FAR struct neighbor_entry_s *neighbor_findentry(const net_ipv6addr_t ipaddr);
@@ -80,6 +80,8 @@ void neighbor_add(FAR struct net_driver_s *dev, FAR net_ipv6addr_t ipaddr,
    * check might be to compare ne_ipaddr with the IPv6 unspecified address.
    */
 
+  neighbor_lock();
+
   oldest_time = g_neighbors[0].ne_time;
   oldest_ndx  = 0;
   lltype      = dev->d_lltype;
@@ -139,4 +141,6 @@ void neighbor_add(FAR struct net_driver_s *dev, FAR net_ipv6addr_t ipaddr,
   /* Dump the contents of the new entry */
 
   neighbor_dumpentry("Added entry", &g_neighbors[oldest_ndx]);
+
+  neighbor_unlock();
 }
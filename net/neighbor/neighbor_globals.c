@@ -32,11 +32,12 @@
  * Public Data
  ****************************************************************************/
 
-/* This is the Neighbor table.  The network should be locked when accessing
+/* This is the Neighbor table.  g_neighbor_lock must be held when accessing
  * this table.
  */
 
 struct neighbor_entry_s g_neighbors[CONFIG_NET_IPv6_NCONF_ENTRIES];
+mutex_t g_neighbor_lock = NXMUTEX_INITIALIZER;
 
 /****************************************************************************
  * Public Functions
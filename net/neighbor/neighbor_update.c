@@ -52,9 +52,13 @@ void neighbor_update(const net_ipv6addr_t ipaddr)
 {
   struct neighbor_entry_s *neighbor;
 
+  neighbor_lock();
+
   neighbor = neighbor_findentry(ipaddr);
   if (neighbor != NULL)
     {
       neighbor->ne_time = clock_systime_ticks();
     }
+
+  neighbor_unlock();
 }
@@ -60,6 +60,17 @@ int netdev_iob_prepare(FAR struct net_driver_s *dev, bool throttled,
 {
   /* Prepare iob buffer */
 
+#ifdef CONFIG_IOB_SIZE_CLASSES
+  /* Receive the jumbo frames to one large I/O buffer if possible */
+
+  if (dev->d_iob == NULL &&
+      NETDEV_PKTSIZE(dev) + CONFIG_NET_LL_GUARDSIZE > CONFIG_IOB_BUFSIZE)
+    {
+      dev->d_iob = iob_tryalloc_size(NETDEV_PKTSIZE(dev) +
+                                     CONFIG_NET_LL_GUARDSIZE, false);
+    }
+#endif
+
   if (dev->d_iob == NULL)
     {
       dev->d_iob = net_iobtimedalloc(false, timeout);
@@ -108,9 +119,16 @@ void netdev_iob_prepare_dynamic(FAR struct net_driver_s *dev, uint16_t size)
       return;
     }
 
-  /* alloc new iob for jumbo frame */
+  /* alloc new iob for jumbo frame, from the large I/O buffer classes if
+   * possible, otherwise from the heap.
+   */
+
+  iob = iob_tryalloc_size(size, false);
+  if (iob == NULL)
+    {
+      iob = iob_alloc_dynamic(size);
+    }
 
-  iob = iob_alloc_dynamic(size);
   if (iob == NULL)
     {
       nerr("ERROR: Failed to allocate an I/O buffer.");
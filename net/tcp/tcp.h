@@ -208,6 +208,13 @@ struct tcp_conn_s
 
   /* TCP-specific content follows */
 
+#if CONFIG_NET_TCP_HASHTAB_SIZE > 0
+  dq_entry_t hashnode;    /* Link in the connection hash table */
+
+  /* The hash table bucket holding the connection */
+
+  FAR dq_queue_t *hashlist;
+#endif
   union ip_binding_u u;   /* IP address binding */
   uint8_t  rcvseq[4];     /* The sequence number that we expect to
                            * receive next */
@@ -704,9 +711,6 @@ int tcp_connect(FAR struct tcp_conn_s *conn,
  * Description:
  *   remove the connection from the list of active TCP connections
  *
- * Assumptions:
- *   This function is called from network logic with the network locked.
- *
  ****************************************************************************/
 
 void tcp_removeconn(FAR struct tcp_conn_s *conn);
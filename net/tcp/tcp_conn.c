@@ -57,6 +57,7 @@
 #include <arch/irq.h>
 
 #include <nuttx/clock.h>
+#include <nuttx/nuttx.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/net.h>
@@ -81,6 +82,13 @@
 #  define CONFIG_NET_TCP_MAX_CONNS 0
 #endif
 
+#if CONFIG_NET_TCP_HASHTAB_SIZE > 0
+#  define tcp_hashentry(node) \
+     ((node) ? container_of(node, struct tcp_conn_s, hashnode) : NULL)
+#  define tcp_hashfirst(list) tcp_hashentry((list)->head)
+#  define tcp_hashnext(conn)  tcp_hashentry((conn)->hashnode.flink)
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -95,10 +103,109 @@ NET_BUFPOOL_DECLARE(g_tcp_connections, sizeof(struct tcp_conn_s),
 
 static dq_queue_t g_active_tcp_connections;
 
+#if CONFIG_NET_TCP_HASHTAB_SIZE > 0
+/* The same connections hashed by remote address, remote and local port */
+
+static dq_queue_t g_tcp_hashtab[CONFIG_NET_TCP_HASHTAB_SIZE];
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+#if CONFIG_NET_TCP_HASHTAB_SIZE > 0
+/****************************************************************************
+ * Name: tcp_hashlist
+ *
+ * Description:
+ *   Return the hash bucket of the connection with the given remote address
+ *   (folded to 32 bits), remote port and local port.
+ *
+ ****************************************************************************/
+
+static FAR dq_queue_t *tcp_hashlist(uint32_t raddr, uint16_t rport,
+                                    uint16_t lport)
+{
+  uint32_t hash = raddr ^ ((uint32_t)rport << 16 | lport);
+
+  hash ^= hash >> 16;
+  hash *= 0x45d9f3b;
+  hash ^= hash >> 16;
+
+  return &g_tcp_hashtab[hash % CONFIG_NET_TCP_HASHTAB_SIZE];
+}
+
+#ifdef CONFIG_NET_IPv6
+/****************************************************************************
+ * Name: tcp_ipv6_fold
+ *
+ * Description:
+ *   Fold the interface identifier of an IPv6 address into 32 bits for
+ *   hashing.
+ *
+ ****************************************************************************/
+
+static inline uint32_t tcp_ipv6_fold(FAR const uint16_t *ipaddr)
+{
+  return ((uint32_t)ipaddr[4] << 16 | ipaddr[5]) ^
+         ((uint32_t)ipaddr[6] << 16 | ipaddr[7]);
+}
+#endif
+
+/****************************************************************************
+ * Name: tcp_conn_hashlist
+ *
+ * Description:
+ *   Return the hash bucket that the connection belongs to.
+ *
+ ****************************************************************************/
+
+static FAR dq_queue_t *tcp_conn_hashlist(FAR struct tcp_conn_s *conn)
+{
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  if (conn->domain == PF_INET6)
+#endif
+    {
+      return tcp_hashlist(tcp_ipv6_fold(conn->u.ipv6.raddr), conn->rport,
+                          conn->lport);
+    }
+#endif /* CONFIG_NET_IPv6 */
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  else
+#endif
+    {
+      return tcp_hashlist(conn->u.ipv4.raddr, conn->rport, conn->lport);
+    }
+#endif /* CONFIG_NET_IPv4 */
+}
+#endif /* CONFIG_NET_TCP_HASHTAB_SIZE > 0 */
+
+/****************************************************************************
+ * Name: tcp_addconn
+ *
+ * Description:
+ *   Add the connection to the list of active TCP connections, the address
+ *   and port of both ends must be set up already.
+ *
+ ****************************************************************************/
+
+static void tcp_addconn(FAR struct tcp_conn_s *conn)
+{
+  tcp_conn_list_lock();
+
+  dq_addlast(&conn->sconn.node, &g_active_tcp_connections);
+
+#if CONFIG_NET_TCP_HASHTAB_SIZE > 0
+  conn->hashlist = tcp_conn_hashlist(conn);
+  dq_addlast(&conn->hashnode, conn->hashlist);
+#endif
+
+  tcp_conn_list_unlock();
+}
+
 /****************************************************************************
  * Name: tcp_listener
  *
@@ -171,9 +278,14 @@ static inline FAR struct tcp_conn_s *
   in_addr_t srcipaddr;
   in_addr_t destipaddr;
 
-  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
   srcipaddr  = net_ip4addr_conv32(ip->srcipaddr);
   destipaddr = net_ip4addr_conv32(ip->destipaddr);
+#if CONFIG_NET_TCP_HASHTAB_SIZE > 0
+  conn       = tcp_hashfirst(tcp_hashlist(srcipaddr, tcp->srcport,
+                                          tcp->destport));
+#else
+  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
+#endif
 
   while (conn)
     {
@@ -210,7 +322,11 @@ static inline FAR struct tcp_conn_s *
 
       /* Look at the next active connection */
 
+#if CONFIG_NET_TCP_HASHTAB_SIZE > 0
+      conn = tcp_hashnext(conn);
+#else
       conn = (FAR struct tcp_conn_s *)conn->sconn.node.flink;
+#endif
     }
 
   return conn;
@@ -238,9 +354,14 @@ static inline FAR struct tcp_conn_s *
   net_ipv6addr_t *srcipaddr;
   net_ipv6addr_t *destipaddr;
 
-  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
   srcipaddr  = (net_ipv6addr_t *)ip->srcipaddr;
   destipaddr = (net_ipv6addr_t *)ip->destipaddr;
+#if CONFIG_NET_TCP_HASHTAB_SIZE > 0
+  conn       = tcp_hashfirst(tcp_hashlist(tcp_ipv6_fold(*srcipaddr),
+                                          tcp->srcport, tcp->destport));
+#else
+  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
+#endif
 
   while (conn)
     {
@@ -277,7 +398,11 @@ static inline FAR struct tcp_conn_s *
 
       /* Look at the next active connection */
 
+#if CONFIG_NET_TCP_HASHTAB_SIZE > 0
+      conn = tcp_hashnext(conn);
+#else
       conn = (FAR struct tcp_conn_s *)conn->sconn.node.flink;
+#endif
     }
 
   return conn;
@@ -811,9 +936,7 @@ void tcp_free(FAR struct tcp_conn_s *conn)
     {
       /* Remove the connection from the active list */
 
-      tcp_conn_list_lock();
-      dq_rem(&conn->sconn.node, &g_active_tcp_connections);
-      tcp_conn_list_unlock();
+      tcp_removeconn(conn);
     }
 
   /* Cancel tcp timer */
@@ -1180,9 +1303,7 @@ FAR struct tcp_conn_s *tcp_alloc_accept(FAR struct net_driver_s *dev,
        * Interrupts should already be disabled in this context.
        */
 
-      tcp_conn_list_lock();
-      dq_addlast(&conn->sconn.node, &g_active_tcp_connections);
-      tcp_conn_list_unlock();
+      tcp_addconn(conn);
 
       tcp_update_retrantimer(conn, TCP_RTO);
     }
@@ -1489,9 +1610,7 @@ int tcp_connect(FAR struct tcp_conn_s *conn, FAR const struct sockaddr *addr)
 
   /* And, finally, put the connection structure into the active list. */
 
-  tcp_conn_list_lock();
-  dq_addlast(&conn->sconn.node, &g_active_tcp_connections);
-  tcp_conn_list_unlock();
+  tcp_addconn(conn);
 
   return OK;
 }
@@ -1528,14 +1647,19 @@ void tcp_conn_list_unlock(void)
  * Description:
  *   remove the connection from the list of active TCP connections
  *
- * Assumptions:
- *   This function is called from network logic with the network locked.
- *
  ****************************************************************************/
 
 void tcp_removeconn(FAR struct tcp_conn_s *conn)
 {
+  tcp_conn_list_lock();
+
   dq_rem(&conn->sconn.node, &g_active_tcp_connections);
+
+#if CONFIG_NET_TCP_HASHTAB_SIZE > 0
+  dq_rem(&conn->hashnode, conn->hashlist);
+#endif
+
+  tcp_conn_list_unlock();
 }
 
 /****************************************************************************
@@ -0,0 +1,277 @@
+/****************************************************************************
+ * net/tcp/tcp_gso.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/param.h>
+#include <debug.h>
+#include <errno.h>
+#include <string.h>
+
+#include <nuttx/mm/iob.h>
+#include <nuttx/net/netconfig.h>
+#include <nuttx/net/netdev.h>
+#include <nuttx/net/ip.h>
+#include <nuttx/net/tcp.h>
+
+#include "tcp/tcp.h"
+#include "utils/utils.h"
+
+#ifdef CONFIG_NET_TCP_GSO
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_gso_iplen
+ *
+ * Description:
+ *   Return the size of the IP header of the packet in d_iob, or zero if the
+ *   packet does not carry TCP.
+ *
+ ****************************************************************************/
+
+static unsigned int tcp_gso_iplen(FAR struct net_driver_s *dev)
+{
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  if (IFF_IS_IPv6(dev->d_flags))
+#endif
+    {
+      FAR struct ipv6_hdr_s *ipv6 = IPv6BUF;
+
+      if ((ipv6->vtc & IP_VERSION_MASK) == IPv6_VERSION &&
+          ipv6->proto == IP_PROTO_TCP)
+        {
+          return IPv6_HDRLEN;
+        }
+    }
+#endif /* CONFIG_NET_IPv6 */
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  else
+#endif
+    {
+      FAR struct ipv4_hdr_s *ipv4 = IPv4BUF;
+
+      if ((ipv4->vhl & IP_VERSION_MASK) == IPv4_VERSION &&
+          ipv4->proto == IP_PROTO_TCP)
+        {
+          return (ipv4->vhl & IPv4_HLMASK) << 2;
+        }
+    }
+#endif /* CONFIG_NET_IPv4 */
+
+  return 0;
+}
+
+/****************************************************************************
+ * Name: tcp_gso_fixup
+ *
+ * Description:
+ *   Update the IP length, sequence number, flags and checksums of the
+ *   segment in d_iob whose headers were copied from the oversized packet.
+ *
+ ****************************************************************************/
+
+static void tcp_gso_fixup(FAR struct net_driver_s *dev, unsigned int iplen,
+                          uint32_t seqno, uint8_t flags)
+{
+  FAR struct tcp_hdr_s *tcp = IPBUF(iplen);
+  unsigned int len = dev->d_iob->io_pktlen;
+
+  tcp_setsequence(tcp->seqno, seqno);
+  tcp->flags     = flags;
+  tcp->tcpchksum = 0;
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  if (IFF_IS_IPv6(dev->d_flags))
+#endif
+    {
+      FAR struct ipv6_hdr_s *ipv6 = IPv6BUF;
+
+      ipv6->len[0] = (len - IPv6_HDRLEN) >> 8;
+      ipv6->len[1] = (len - IPv6_HDRLEN) & 0xff;
+
+#ifdef CONFIG_NET_TCP_CHECKSUMS
+      if ((dev->d_features & NETDEV_TX_CSUM) == 0)
+        {
+          tcp->tcpchksum = ~tcp_ipv6_chksum(dev);
+        }
+#endif
+    }
+#endif /* CONFIG_NET_IPv6 */
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  else
+#endif
+    {
+      FAR struct ipv4_hdr_s *ipv4 = IPv4BUF;
+
+      /* The segments carry DF, so the IP ID is not used for reassembly
+       * (RFC 6864) and all of them keep the one of the oversized packet.
+       */
+
+      ipv4->len[0]   = len >> 8;
+      ipv4->len[1]   = len & 0xff;
+      ipv4->ipchksum = 0;
+
+#ifdef CONFIG_NET_IPV4_CHECKSUMS
+      ipv4->ipchksum = ~ipv4_chksum(ipv4);
+#endif
+
+#ifdef CONFIG_NET_TCP_CHECKSUMS
+      if ((dev->d_features & NETDEV_TX_CSUM) == 0)
+        {
+          tcp->tcpchksum = ~tcp_ipv4_chksum(dev);
+        }
+#endif
+    }
+#endif /* CONFIG_NET_IPv4 */
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_gso_segment
+ *
+ * Description:
+ *   Split the oversized TCP packet in d_iob into segments of d_gso_size
+ *   bytes of payload and pass each of them in d_iob to the callback, the
+ *   same way devif_poll() does.  A packet that needs no segmentation is
+ *   passed to the callback unchanged.  Segmentation stops at the first
+ *   negative value returned by the callback.
+ *
+ * Input Parameters:
+ *   dev      - The device holding the packet in d_iob
+ *   callback - The driver function that sends a single packet
+ *
+ * Returned Value:
+ *   The value returned by the last callback, or a negated errno value if
+ *   no I/O buffer is available for a segment.
+ *
+ * Assumptions:
+ *   Called from the TX poll callback of the driver with the network locked.
+ *
+ ****************************************************************************/
+
+int tcp_gso_segment(FAR struct net_driver_s *dev,
+                    devif_poll_callback_t callback)
+{
+  FAR struct iob_s *iob = dev->d_iob;
+  FAR struct tcp_hdr_s *tcp;
+  uint16_t gso_size = dev->d_gso_size;
+  uint16_t llhdrlen = NET_LL_HDRLEN(dev);
+  unsigned int iplen;
+  unsigned int hdrlen;
+  unsigned int paylen;
+  unsigned int offset;
+  uint32_t seqno;
+  uint8_t flags;
+  int ret = 0;
+
+  dev->d_gso_size = 0;
+
+  /* The packet in d_iob may have been replaced on the way down, e.g. by an
+   * ARP request, so make sure that it is still an oversized TCP packet.
+   */
+
+  if (gso_size == 0 || iob->io_pktlen <= gso_size + TCP_HDRLEN ||
+      (iplen = tcp_gso_iplen(dev)) == 0)
+    {
+      return callback(dev);
+    }
+
+  tcp    = IPBUF(iplen);
+  hdrlen = iplen + ((tcp->tcpoffset >> 4) << 2);
+  if (hdrlen > iob->io_len || iob->io_pktlen <= gso_size + hdrlen)
+    {
+      return callback(dev);
+    }
+
+  paylen = iob->io_pktlen - hdrlen;
+  seqno  = tcp_getsequence(tcp->seqno);
+  flags  = tcp->flags;
+
+  /* Detach the oversized packet, each segment goes into d_iob in turn */
+
+  netdev_iob_clear(dev);
+
+  for (offset = 0; offset < paylen && ret >= 0; offset += gso_size)
+    {
+      unsigned int len = MIN(paylen - offset, gso_size);
+      FAR struct iob_s *seg;
+
+      seg = iob_tryalloc(false);
+      if (seg == NULL)
+        {
+          goto errout;
+        }
+
+      /* Copy the L2, IP and TCP headers, then the payload of the segment */
+
+      iob_reserve(seg, CONFIG_NET_LL_GUARDSIZE);
+      memcpy(IOB_DATA(seg) - llhdrlen, IOB_DATA(iob) - llhdrlen,
+             llhdrlen + hdrlen);
+      iob_update_pktlen(seg, hdrlen, false);
+
+      if (iob_clone_partial(iob, len, hdrlen + offset, seg, hdrlen,
+                            false, false) < 0)
+        {
+          iob_free_chain(seg);
+          goto errout;
+        }
+
+      dev->d_iob = seg;
+      dev->d_buf = NETLLBUF;
+      dev->d_len = llhdrlen + hdrlen + len;
+
+      /* Only the last segment keeps FIN and PSH */
+
+      tcp_gso_fixup(dev, iplen, seqno + offset,
+                    offset + len < paylen ?
+                    flags & ~(TCP_FIN | TCP_PSH) : flags);
+
+      ret = callback(dev);
+    }
+
+  iob_free_chain(iob);
+  return ret;
+
+errout:
+  nwarn("WARNING: No IOB for TCP segment, dropped %u bytes\n",
+        paylen - offset);
+  iob_free_chain(iob);
+  return -ENOMEM;
+}
+
+#endif /* CONFIG_NET_TCP_GSO */
@@ -65,6 +65,21 @@
 #include "tcp/tcp.h"
 #include "utils/utils.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Whether the TCP checksum of the outgoing packet is computed here, rather
+ * than by the hardware or per segment for an oversized packet.
+ */
+
+#ifdef CONFIG_NET_TCP_GSO
+#  define TCP_SW_CHKSUM(dev) \
+     (((dev)->d_features & NETDEV_TX_CSUM) == 0 && (dev)->d_gso_size == 0)
+#else
+#  define TCP_SW_CHKSUM(dev) (((dev)->d_features & NETDEV_TX_CSUM) == 0)
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -200,7 +215,7 @@ static void tcp_sendcommon(FAR struct net_driver_s *dev,
       tcp->tcpchksum = 0;
 
 #ifdef CONFIG_NET_TCP_CHECKSUMS
-      if ((dev->d_features & NETDEV_TX_CSUM) == 0)
+      if (TCP_SW_CHKSUM(dev))
         {
           tcp->tcpchksum = ~tcp_ipv6_chksum(dev);
         }
@@ -227,7 +242,7 @@ static void tcp_sendcommon(FAR struct net_driver_s *dev,
       tcp->tcpchksum = 0;
 
 #ifdef CONFIG_NET_TCP_CHECKSUMS
-      if ((dev->d_features & NETDEV_TX_CSUM) == 0)
+      if (TCP_SW_CHKSUM(dev))
         {
           tcp->tcpchksum = ~tcp_ipv4_chksum(dev);
         }
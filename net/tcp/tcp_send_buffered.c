@@ -92,6 +92,71 @@
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: tcp_max_sndlen
+ *
+ * Description:
+ *   Return the largest amount of data that may be passed down in a single
+ *   packet: one MSS, or up to CONFIG_NET_TCP_GSO_MAXSIZE for the TX poll of
+ *   a device which splits oversized packets into segments itself.
+ *
+ * Input Parameters:
+ *   dev   The device the packet is sent on
+ *   conn  The TCP connection of the packet
+ *   flags The set of events of the send
+ *
+ * Returned Value:
+ *   The maximum amount of data to send
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_max_sndlen(FAR struct net_driver_s *dev,
+                               FAR struct tcp_conn_s *conn, uint16_t flags)
+{
+#ifdef CONFIG_NET_TCP_GSO
+  bool local;
+
+  /* Only the TX poll hands the packet straight to the driver, while the
+   * replies sent from the input path may be queued as they are.
+   */
+
+  if ((flags & TCP_POLL) == 0 ||
+      (dev->d_features & (NETDEV_GSO | NETDEV_TSO)) == 0 ||
+      CONFIG_NET_TCP_GSO_MAXSIZE < 2 * conn->mss)
+    {
+      return conn->mss;
+    }
+
+  /* Packets looped back to ourselves never reach the driver either */
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  if (conn->domain == PF_INET6)
+#endif
+    {
+      local = NETDEV_IS_MY_V6ADDR(dev, conn->u.ipv6.raddr);
+    }
+#endif /* CONFIG_NET_IPv6 */
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  else
+#endif
+    {
+      local = net_ipv4addr_cmp(conn->u.ipv4.raddr, dev->d_ipaddr);
+    }
+#endif /* CONFIG_NET_IPv4 */
+
+  if (!local)
+    {
+      return CONFIG_NET_TCP_GSO_MAXSIZE -
+             CONFIG_NET_TCP_GSO_MAXSIZE % conn->mss;
+    }
+#endif /* CONFIG_NET_TCP_GSO */
+
+  return conn->mss;
+}
+
 /****************************************************************************
  * Name: psock_insert_segment
  *
@@ -1059,12 +1124,14 @@ static uint32_t psock_send_eventhandler(FAR struct net_driver_s *dev,
       if (TCP_SEQ_LT(seq, snd_wnd_edge))
         {
           uint32_t remaining_snd_wnd;
+          uint32_t max_sndlen;
           int ret;
 
+          max_sndlen = tcp_max_sndlen(dev, conn, flags);
           sndlen = TCP_WBPKTLEN(wrb) - TCP_WBSENT(wrb);
-          if (sndlen > conn->mss)
+          if (sndlen > max_sndlen)
             {
-              sndlen = conn->mss;
+              sndlen = max_sndlen;
             }
 
           remaining_snd_wnd = TCP_SEQ_SUB(snd_wnd_edge, seq);
@@ -1089,6 +1156,18 @@ static uint32_t psock_send_eventhandler(FAR struct net_driver_s *dev,
               sndlen = CONFIG_IOB_BUFSIZE;
             }
 
+#ifdef CONFIG_NET_TCP_GSO
+          /* An oversized packet needs as many iobs again for its segments */
+
+          else if (sndlen > conn->mss &&
+                   2 * sndlen > iob_navail(false) * CONFIG_IOB_BUFSIZE)
+            {
+              sndlen = conn->mss;
+            }
+
+          dev->d_gso_size = sndlen > conn->mss ? conn->mss : 0;
+#endif
+
           ninfo("SEND: wrb=%p seq=%" PRIu32 " pktlen=%u sent=%u sndlen=%zu "
                 "mss=%u snd_wnd=%" PRIu32 " seq=%" PRIu32
                 " remaining_snd_wnd=%" PRIu32 "\n",
@@ -1223,6 +1302,17 @@ static uint32_t tcp_max_wrb_size(FAR struct tcp_conn_s *conn)
 
   size = 4 * mss;
 
+#ifdef CONFIG_NET_TCP_GSO
+  /* or rather enough for one oversized packet, if the device takes them */
+
+  if (conn->dev != NULL &&
+      (conn->dev->d_features & (NETDEV_GSO | NETDEV_TSO)) != 0 &&
+      size < CONFIG_NET_TCP_GSO_MAXSIZE)
+    {
+      size = CONFIG_NET_TCP_GSO_MAXSIZE;
+    }
+#endif
+
   /* but it should not hog too many IOB buffers */
 
   if (size > CONFIG_IOB_NBUFFERS * CONFIG_IOB_BUFSIZE / 2)
@@ -110,6 +110,13 @@ struct udp_conn_s
 
   /* UDP-specific content follows */
 
+#if CONFIG_NET_UDP_HASHTAB_SIZE > 0
+  dq_entry_t hashnode;    /* Link in the local port hash table */
+
+  /* The hash table bucket holding the connection, NULL if not bound */
+
+  FAR dq_queue_t *hashlist;
+#endif
   union ip_binding_u u;   /* IP address binding */
   uint16_t lport;         /* Bound local port number (network byte order) */
   uint16_t rport;         /* Remote port number (network byte order) */
@@ -279,6 +286,22 @@ void udp_conn_list_lock(void);
 
 void udp_conn_list_unlock(void);
 
+/****************************************************************************
+ * Name: udp_rehash
+ *
+ * Description:
+ *   Move the connection to the hash bucket of its current local port.
+ *   This must be called whenever a non-zero local port is assigned to the
+ *   connection so that udp_active() can find it.
+ *
+ ****************************************************************************/
+
+#if CONFIG_NET_UDP_HASHTAB_SIZE > 0
+void udp_rehash(FAR struct udp_conn_s *conn);
+#else
+#  define udp_rehash(conn)
+#endif
+
 /****************************************************************************
  * Name: udp_select_port
  *
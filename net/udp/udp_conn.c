@@ -57,6 +57,7 @@
 #include <arch/irq.h>
 
 #include <nuttx/clock.h>
+#include <nuttx/nuttx.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/mutex.h>
 #include <nuttx/net/netconfig.h>
@@ -82,6 +83,13 @@
 #  define CONFIG_NET_UDP_MAX_CONNS 0
 #endif
 
+#if CONFIG_NET_UDP_HASHTAB_SIZE > 0
+#  define udp_hashlist(port) \
+     (&g_udp_hashtab[NTOHS(port) % CONFIG_NET_UDP_HASHTAB_SIZE])
+#  define udp_hashentry(node) \
+     ((node) ? container_of(node, struct udp_conn_s, hashnode) : NULL)
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -96,10 +104,45 @@ NET_BUFPOOL_DECLARE(g_udp_connections, sizeof(struct udp_conn_s),
 
 static dq_queue_t g_active_udp_connections;
 
+#if CONFIG_NET_UDP_HASHTAB_SIZE > 0
+/* The bound UDP connections hashed by local port */
+
+static dq_queue_t g_udp_hashtab[CONFIG_NET_UDP_HASHTAB_SIZE];
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: udp_nextactive
+ *
+ * Description:
+ *   Traverse the connections that may be bound to the local port, which is
+ *   only the hash bucket of the port if the hash table is enabled.
+ *
+ * Assumptions:
+ *   This function must be called with the udp_conn_list_lock.
+ *
+ ****************************************************************************/
+
+#if CONFIG_NET_UDP_HASHTAB_SIZE > 0
+static inline FAR struct udp_conn_s *
+udp_nextactive(FAR struct udp_conn_s *conn, uint16_t port)
+{
+  if (conn == NULL)
+    {
+      return udp_hashentry(udp_hashlist(port)->head);
+    }
+  else
+    {
+      return udp_hashentry(conn->hashnode.flink);
+    }
+}
+#else
+#  define udp_nextactive(conn, port) udp_nextconn(conn)
+#endif
+
 /****************************************************************************
  * Name: udp_find_conn()
  *
@@ -204,7 +247,7 @@ udp_ipv4_active(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn,
 #endif
   FAR struct ipv4_hdr_s *ip = IPv4BUF;
 
-  conn = udp_nextconn(conn);
+  conn = udp_nextactive(conn, udp->destport);
 
   while (conn)
     {
@@ -318,7 +361,7 @@ udp_ipv4_active(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn,
 
       /* Look at the next active connection */
 
-      conn = udp_nextconn(conn);
+      conn = udp_nextactive(conn, udp->destport);
     }
 
   return conn;
@@ -344,7 +387,7 @@ udp_ipv6_active(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn,
 {
   FAR struct ipv6_hdr_s *ip = IPv6BUF;
 
-  conn = udp_nextconn(conn);
+  conn = udp_nextactive(conn, udp->destport);
 
   while (conn != NULL)
     {
@@ -458,7 +501,7 @@ udp_ipv6_active(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn,
 
       /* Look at the next active connection */
 
-      conn = udp_nextconn(conn);
+      conn = udp_nextactive(conn, udp->destport);
     }
 
   return conn;
@@ -562,6 +605,9 @@ FAR struct udp_conn_s *udp_alloc(uint8_t domain)
       conn->domain      = domain;
 #endif
       conn->lport       = 0;
+#if CONFIG_NET_UDP_HASHTAB_SIZE > 0
+      conn->hashlist    = NULL;
+#endif
 #if CONFIG_NET_RECV_BUFSIZE > 0
       conn->rcvbufs     = CONFIG_NET_RECV_BUFSIZE;
 #endif
@@ -611,6 +657,14 @@ void udp_free(FAR struct udp_conn_s *conn)
   /* Remove the connection from the active list */
 
   dq_rem(&conn->sconn.node, &g_active_udp_connections);
+
+#if CONFIG_NET_UDP_HASHTAB_SIZE > 0
+  if (conn->hashlist != NULL)
+    {
+      dq_rem(&conn->hashnode, conn->hashlist);
+    }
+#endif
+
   nxrmutex_destroy(&conn->sconn.s_lock);
 
   /* Release any read-ahead buffers attached to the connection, NULL is ok */
@@ -735,6 +789,35 @@ FAR struct udp_conn_s *udp_nextconn(FAR struct udp_conn_s *conn)
     }
 }
 
+/****************************************************************************
+ * Name: udp_rehash
+ *
+ * Description:
+ *   Move the connection to the hash bucket of its current local port.
+ *
+ ****************************************************************************/
+
+#if CONFIG_NET_UDP_HASHTAB_SIZE > 0
+void udp_rehash(FAR struct udp_conn_s *conn)
+{
+  NET_BUFPOOL_LOCK(g_udp_connections);
+
+  if (conn->hashlist != NULL)
+    {
+      dq_rem(&conn->hashnode, conn->hashlist);
+      conn->hashlist = NULL;
+    }
+
+  if (conn->lport != 0)
+    {
+      conn->hashlist = udp_hashlist(conn->lport);
+      dq_addlast(&conn->hashnode, conn->hashlist);
+    }
+
+  NET_BUFPOOL_UNLOCK(g_udp_connections);
+}
+#endif
+
 /****************************************************************************
  * Name: udp_bind
  *
@@ -878,6 +961,7 @@ int udp_bind(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
         {
           conn->lport = portno;
           ret         = OK;
+          udp_rehash(conn);
         }
     }
   else
@@ -903,6 +987,7 @@ int udp_bind(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
 
           conn->lport = portno;
           ret         = OK;
+          udp_rehash(conn);
         }
       else
         {
@@ -959,6 +1044,8 @@ int udp_connect(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
           nerr("ERROR: Failed to get a local port!\n");
           return -EADDRINUSE;
         }
+
+      udp_rehash(conn);
     }
 
   /* Is there a remote port (rport)? */
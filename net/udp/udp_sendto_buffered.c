@@ -275,6 +275,8 @@ static int sendto_next_transfer(FAR struct udp_conn_s *conn)
           nerr("ERROR: Failed to get a local port!\n");
           return -EADDRINUSE;
         }
+
+      udp_rehash(conn);
     }
 
   /* Get the device that will handle the remote packet transfers.  This
@@ -201,11 +201,14 @@ FAR struct udp_wrbuffer_s *udp_wrbuffer_tryalloc(void)
 
   /* Now get the first I/O buffer for the write buffer structure */
 
-  wrb->wb_iob =
 #ifdef CONFIG_NET_JUMBO_FRAME
-    iob_alloc_dynamic(len);
+  wrb->wb_iob = iob_tryalloc_size(len, false);
+  if (wrb->wb_iob == NULL)
+    {
+      wrb->wb_iob = iob_alloc_dynamic(len);
+    }
 #else
-    iob_tryalloc(false);
+  wrb->wb_iob = iob_tryalloc(false);
 #endif
   if (!wrb->wb_iob)
     {
@@ -26,6 +26,9 @@
 
 #include <nuttx/config.h>
 
+#include <assert.h>
+#include <string.h>
+
 #include <nuttx/kmalloc.h>
 #include <nuttx/net/net.h>
 #include <nuttx/semaphore.h>
@@ -47,6 +50,24 @@ struct net_bufnode_s
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: net_bufpool_ctor
+ *
+ * Description:
+ *   Zero a node taken from the object cache, like the nodes of the free
+ *   buffer list.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_BUFPOOL_OBJCACHE
+static void net_bufpool_ctor(FAR void *obj, FAR void *arg)
+{
+  FAR struct net_bufpool_s *pool = arg;
+
+  memset(obj, 0, pool->nodesize);
+}
+#endif
+
 /****************************************************************************
  * Name: net_bufpool_init
  *
@@ -71,6 +92,14 @@ static void net_bufpool_init(FAR struct net_bufpool_s *pool)
                                       (pool->pool + i * pool->nodesize);
       sq_addlast(&node->node, &pool->freebuffers);
     }
+
+#ifdef CONFIG_NET_BUFPOOL_OBJCACHE
+  if (pool->dynalloc == 1)
+    {
+      DEBUGVERIFY(objcache_init(&pool->cache, pool->name, pool->nodesize,
+                                0, net_bufpool_ctor, NULL, pool));
+    }
+#endif
 }
 
 /****************************************************************************
@@ -128,6 +157,14 @@ FAR void *net_bufpool_timedalloc(FAR struct net_bufpool_s *pool,
 
   if (pool->dynalloc > 0 && sq_peek(&pool->freebuffers) == NULL)
     {
+#ifdef CONFIG_NET_BUFPOOL_OBJCACHE
+      if (pool->dynalloc == 1)
+        {
+          buf = objcache_alloc(&pool->cache);
+          goto out;
+        }
+#endif
+
       node = kmm_zalloc(pool->nodesize * pool->dynalloc);
       if (node == NULL)
         {
@@ -172,7 +209,11 @@ void net_bufpool_free(FAR struct net_bufpool_s *pool, FAR void *node)
       ((FAR char *)node < pool->pool ||
        (FAR char *)node >= pool->pool + pool->prealloc * pool->nodesize))
     {
+#ifdef CONFIG_NET_BUFPOOL_OBJCACHE
+      objcache_free(&pool->cache, node);
+#else
       kmm_free(node);
+#endif
     }
   else
     {
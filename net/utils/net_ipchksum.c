@@ -27,9 +27,14 @@
 #include <nuttx/config.h>
 
 #include <assert.h>
+#include <stddef.h>
 
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/ip.h>
+#include <nuttx/net/icmp.h>
+#include <nuttx/net/icmpv6.h>
+#include <nuttx/net/tcp.h>
+#include <nuttx/net/udp.h>
 
 #include "utils/utils.h"
 
@@ -308,4 +313,122 @@ uint16_t ipv4_chksum(FAR struct ipv4_hdr_s *ipv4)
 }
 #endif /* CONFIG_NET_ARCH_CHKSUM */
 
+/****************************************************************************
+ * Name: net_chksum_finish
+ *
+ * Description:
+ *   The network leaves the upper layer checksum of outgoing packets to a
+ *   device with checksum offload.  Compute it in software where the device
+ *   never sees the packet whole: before the packet is fragmented, or when
+ *   it is looped back to ourself.  IPv4 fragments are left alone.
+ *
+ * Input Parameters:
+ *   dev    - The NIC device
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_IOB
+void net_chksum_finish(FAR struct net_driver_s *dev)
+{
+  FAR uint8_t *ip = IOB_DATA(dev->d_iob);
+  FAR uint16_t *chksum;
+  uint16_t iphdrlen;
+  uint16_t offset;
+  uint8_t proto;
+  uint8_t vers = ip[0] & IP_VERSION_MASK;
+
+#ifdef CONFIG_NET_IPv4
+  if (vers == IPv4_VERSION)
+    {
+      FAR struct ipv4_hdr_s *ipv4 = (FAR struct ipv4_hdr_s *)ip;
+
+      /* Packets that are fragments already (forwarded) are left alone */
+
+      if ((ipv4->ipoffset[0] & ~(IP_FLAG_DONTFRAG >> 8)) != 0 ||
+          ipv4->ipoffset[1] != 0)
+        {
+          return;
+        }
+
+      iphdrlen = (ipv4->vhl & IPv4_HLMASK) << 2;
+      proto    = ipv4->proto;
+    }
+  else
+#endif
+#ifdef CONFIG_NET_IPv6
+  if (vers == IPv6_VERSION)
+    {
+      iphdrlen = IPv6_HDRLEN;
+      proto    = ((FAR struct ipv6_hdr_s *)ip)->proto;
+    }
+  else
+#endif
+    {
+      return;
+    }
+
+  switch (proto)
+    {
+#ifdef CONFIG_NET_TCP_CHECKSUMS
+      case IP_PROTO_TCP:
+        offset = offsetof(struct tcp_hdr_s, tcpchksum);
+        break;
+#endif
+#ifdef CONFIG_NET_UDP_CHECKSUMS
+      case IP_PROTO_UDP:
+        offset = offsetof(struct udp_hdr_s, udpchksum);
+        break;
+#endif
+#if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_ICMP_CHECKSUMS)
+      case IP_PROTO_ICMP:
+        offset = offsetof(struct icmp_hdr_s, icmpchksum);
+        break;
+#endif
+#if defined(CONFIG_NET_IPv6) && defined(CONFIG_NET_ICMPv6_CHECKSUMS)
+      case IP_PROTO_ICMP6:
+        offset = offsetof(struct icmpv6_hdr_s, chksum);
+        break;
+#endif
+      default:
+        return;
+    }
+
+  if (iphdrlen + offset + sizeof(uint16_t) > dev->d_iob->io_len)
+    {
+      return;
+    }
+
+  chksum  = (FAR uint16_t *)(ip + iphdrlen + offset);
+  *chksum = 0;
+
+#ifdef CONFIG_NET_IPv4
+  if (vers == IPv4_VERSION)
+    {
+#ifdef CONFIG_NET_ICMP_CHECKSUMS
+      if (proto == IP_PROTO_ICMP)
+        {
+          *chksum = ~icmp_chksum_iob(dev->d_iob);
+        }
+      else
+#endif
+        {
+          *chksum = ~ipv4_upperlayer_chksum(dev, proto);
+        }
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv6
+  if (vers == IPv6_VERSION)
+    {
+      *chksum = ~ipv6_upperlayer_chksum(dev, proto, IPv6_HDRLEN);
+    }
+#endif
+
+  if (*chksum == 0)
+    {
+      *chksum = 0xffff;
+    }
+}
+#endif /* CONFIG_MM_IOB */
+
 #endif /* CONFIG_NET */
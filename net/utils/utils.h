@@ -33,6 +33,7 @@
 #include <stdlib.h>
 
 #include <nuttx/mutex.h>
+#include <nuttx/mm/objcache.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/ip.h>
 #include <nuttx/net/netdev.h>
@@ -89,6 +90,12 @@
 #define NET_BUFPOOL_MAX(prealloc, dynalloc, maxalloc) \
   (dynalloc) <= 0 ? (prealloc) : ((maxalloc) > 0 ? (maxalloc) : INT16_MAX)
 
+#ifdef CONFIG_NET_BUFPOOL_OBJCACHE
+#  define NET_BUFPOOL_NAME(pool) , #pool
+#else
+#  define NET_BUFPOOL_NAME(pool)
+#endif
+
 #define NET_BUFPOOL_DECLARE(pool, nodesize, prealloc, dynalloc, maxalloc) \
   static char pool##_buffer[prealloc][nodesize] aligned_data(sizeof(uintptr_t)); \
   static struct net_bufpool_s pool = \
@@ -100,6 +107,7 @@
       SEM_INITIALIZER(NET_BUFPOOL_MAX(prealloc, dynalloc, maxalloc)), \
       NXRMUTEX_INITIALIZER, \
       { NULL, NULL } \
+      NET_BUFPOOL_NAME(pool) \
     };
 
 #define NET_BUFPOOL_TIMEDALLOC(p,t) net_bufpool_timedalloc(&p, t)
@@ -139,6 +147,13 @@ struct net_bufpool_s
 
   rmutex_t   lock;     /* The lock for the pool */
   sq_queue_t freebuffers;
+
+#ifdef CONFIG_NET_BUFPOOL_OBJCACHE
+  /* The nodes allocated one by one come from this cache */
+
+  FAR const char   *name;
+  struct objcache_s cache;
+#endif
 };
 
 /****************************************************************************
@@ -546,6 +561,23 @@ void net_chksum_adjust(FAR uint16_t *chksum,
                        FAR const uint16_t *optr, ssize_t olen,
                        FAR const uint16_t *nptr, ssize_t nlen);
 
+/****************************************************************************
+ * Name: net_chksum_finish
+ *
+ * Description:
+ *   Compute in software the TCP, UDP, ICMP or ICMPv6 checksum of an
+ *   outgoing packet that the network left to the checksum offload of the
+ *   device (NETDEV_TX_CSUM or NETDEV_TX_CSUM_PARTIAL).
+ *
+ * Input Parameters:
+ *   dev - The network device.  The IP packet is in d_iob.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_IOB
+void net_chksum_finish(FAR struct net_driver_s *dev);
+#endif
+
 /****************************************************************************
  * Name: tcp_chksum, tcp_ipv4_chksum, and tcp_ipv6_chksum
  *
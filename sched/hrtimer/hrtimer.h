@@ -48,36 +48,64 @@
 RB_HEAD(hrtimer_tree_s, hrtimer_node_s);
 #endif
 
+/* Per-CPU container of the active high-resolution timers.
+ *
+ * A timer is queued on the CPU that armed it (or on the CPU given to
+ * hrtimer_start_on()) and its callback runs on that CPU, so arming and
+ * expiring local timers only takes the lock of the local queue.
+ */
+
+struct hrtimer_queue_s
+{
+  spinlock_t lock;                /* Protects the queue and its timers */
+#ifdef CONFIG_HRTIMER_TREE
+  struct hrtimer_tree_s tree;     /* Timers ordered by expiration time */
+#else
+  struct list_node list;          /* Timers ordered by expiration time */
+#endif
+#ifdef CONFIG_SMP
+  FAR hrtimer_t *running;         /* Timer whose callback is running */
+  uint64_t next;                  /* Earliest expiration of the queue */
+  bool armed;                     /* The queue holds at least one timer */
+  bool pending;                   /* The CPU was kicked to expire timers */
+#endif
+};
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
 
-/* Spinlock protecting access to the hrtimer container and timer state */
+/* Spinlock protecting the shared hardware timer.  In SMP configurations
+ * it also protects the cached earliest expiration of every queue.  It is
+ * always taken after the lock of a queue.
+ */
 
 extern spinlock_t g_hrtimer_spinlock;
 
-#ifdef CONFIG_HRTIMER_TREE
-/* Red-Black tree containing all active high-resolution timers */
-
-extern struct hrtimer_tree_s g_hrtimer_tree;
-#else
-/* List containing all active high-resolution timers */
-
-extern struct list_node g_hrtimer_list;
-#endif
-
-/* Array of pointers to currently running high-resolution timers
- * for each CPU in SMP configurations. Index corresponds to CPU ID.
- */
+/* The high-resolution timer queue of each CPU */
 
-#ifdef CONFIG_SMP
-extern FAR hrtimer_t *g_hrtimer_running[CONFIG_SMP_NCPUS];
-#endif
+extern struct hrtimer_queue_s g_hrtimer_queue[CONFIG_SMP_NCPUS];
 
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: hrtimer_initialize
+ *
+ * Description:
+ *   Initialize the high-resolution timer queue of each CPU.  Called once
+ *   from nx_start() before the system timer is started.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ ****************************************************************************/
+
+void hrtimer_initialize(void);
+
 /****************************************************************************
  * Name: hrtimer_process
  *
@@ -95,6 +123,23 @@ extern FAR hrtimer_t *g_hrtimer_running[CONFIG_SMP_NCPUS];
 
 void hrtimer_process(uint64_t now);
 
+/****************************************************************************
+ * Name: hrtimer_reprogram
+ *
+ * Description:
+ *   Update the earliest expiration of the queue after its head changed
+ *   and restart the hardware timer if the earliest expiration of all of
+ *   the queues moved.
+ *
+ * Input Parameters:
+ *   queue - The queue whose head changed, locked by the caller.
+ *
+ * Returned Value:
+ *   OK (0) on success, negated errno on failure.
+ ****************************************************************************/
+
+int hrtimer_reprogram(FAR struct hrtimer_queue_s *queue);
+
 /****************************************************************************
  * Inline Functions
  ****************************************************************************/
@@ -198,6 +243,55 @@ int hrtimer_compare(FAR const hrtimer_node_t *a,
 RB_PROTOTYPE(hrtimer_tree_s, hrtimer_node_s, entry, hrtimer_compare);
 #endif
 
+/****************************************************************************
+ * Name: hrtimer_queue
+ *
+ * Description:
+ *   Return the queue the timer is (or was last) armed on.
+ ****************************************************************************/
+
+static inline_function
+FAR struct hrtimer_queue_s *hrtimer_queue(FAR const hrtimer_t *hrtimer)
+{
+#ifdef CONFIG_SMP
+  return &g_hrtimer_queue[hrtimer->cpu];
+#else
+  UNUSED(hrtimer);
+  return &g_hrtimer_queue[0];
+#endif
+}
+
+/****************************************************************************
+ * Name: hrtimer_lock
+ *
+ * Description:
+ *   Lock the queue the timer belongs to.  The timer may be moved to
+ *   another CPU by hrtimer_start_on() while we wait for the lock, so the
+ *   owner is checked again once the lock is held.
+ *
+ * Returned Value:
+ *   The locked queue, *flags holds the interrupt state to restore.
+ ****************************************************************************/
+
+static inline_function
+FAR struct hrtimer_queue_s *hrtimer_lock(FAR hrtimer_t *hrtimer,
+                                         FAR irqstate_t *flags)
+{
+  FAR struct hrtimer_queue_s *queue;
+
+  for (; ; )
+    {
+      queue  = hrtimer_queue(hrtimer);
+      *flags = spin_lock_irqsave(&queue->lock);
+      if (queue == hrtimer_queue(hrtimer))
+        {
+          return queue;
+        }
+
+      spin_unlock_irqrestore(&queue->lock, *flags);
+    }
+}
+
 /****************************************************************************
  * Name: hrtimer_is_armed
  *
@@ -220,11 +314,14 @@ static inline_function bool hrtimer_is_armed(FAR hrtimer_t *hrtimer)
  *   Remove a timer from the container and mark it as unarmed.
  ****************************************************************************/
 
-static inline_function void hrtimer_remove(FAR hrtimer_t *hrtimer)
+static inline_function
+void hrtimer_remove(FAR struct hrtimer_queue_s *queue,
+                    FAR hrtimer_t *hrtimer)
 {
 #ifdef CONFIG_HRTIMER_TREE
-  RB_REMOVE(hrtimer_tree_s, &g_hrtimer_tree, &hrtimer->node);
+  RB_REMOVE(hrtimer_tree_s, &queue->tree, &hrtimer->node);
 #else
+  UNUSED(queue);
   list_delete_fast(&hrtimer->node.entry);
 #endif
 
@@ -241,15 +338,17 @@ static inline_function void hrtimer_remove(FAR hrtimer_t *hrtimer)
  *   expiration time.
  ****************************************************************************/
 
-static inline_function void hrtimer_insert(FAR hrtimer_t *hrtimer)
+static inline_function
+void hrtimer_insert(FAR struct hrtimer_queue_s *queue,
+                    FAR hrtimer_t *hrtimer)
 {
 #ifdef CONFIG_HRTIMER_TREE
-  RB_INSERT(hrtimer_tree_s, &g_hrtimer_tree, &hrtimer->node);
+  RB_INSERT(hrtimer_tree_s, &queue->tree, &hrtimer->node);
 #else
   FAR hrtimer_t *curr;
   uint64_t expired = hrtimer->expired;
 
-  list_for_every_entry(&g_hrtimer_list, curr, hrtimer_t, node.entry)
+  list_for_every_entry(&queue->list, curr, hrtimer_t, node.entry)
     {
       /* Until curr->expired has not timed out relative to expired */
 
@@ -273,12 +372,18 @@ static inline_function void hrtimer_insert(FAR hrtimer_t *hrtimer)
  *   Pointer to the earliest timer, or NULL if none are armed.
  ****************************************************************************/
 
-static inline_function FAR hrtimer_t *hrtimer_get_first(void)
+static inline_function
+FAR hrtimer_t *hrtimer_get_first(FAR struct hrtimer_queue_s *queue)
 {
 #ifdef CONFIG_HRTIMER_TREE
-  return (FAR hrtimer_t *)RB_MIN(hrtimer_tree_s, &g_hrtimer_tree);
+  return (FAR hrtimer_t *)RB_MIN(hrtimer_tree_s, &queue->tree);
 #else
-  return list_first_entry(&g_hrtimer_list, FAR hrtimer_t, node.entry);
+  if (list_is_empty(&queue->list))
+    {
+      return NULL;
+    }
+
+  return list_first_entry(&queue->list, FAR hrtimer_t, node.entry);
 #endif
 }
 
@@ -294,6 +399,7 @@ static inline_function FAR hrtimer_t *hrtimer_get_first(void)
  *   earliest one if it has no left child.
  *
  * Input Parameters:
+ *   queue   - The queue the timer is armed on.
  *   hrtimer - Pointer to the high-resolution timer to be tested.
  *
  * Returned Value:
@@ -301,12 +407,15 @@ static inline_function FAR hrtimer_t *hrtimer_get_first(void)
  *   false - The timer is not the earliest timer.
  ****************************************************************************/
 
-static inline_function bool hrtimer_is_first(FAR hrtimer_t *hrtimer)
+static inline_function
+bool hrtimer_is_first(FAR struct hrtimer_queue_s *queue,
+                      FAR hrtimer_t *hrtimer)
 {
 #ifdef CONFIG_HRTIMER_TREE
+  UNUSED(queue);
   return RB_LEFT(&hrtimer->node, entry) == NULL;
 #else
-  return hrtimer == list_first_entry(&g_hrtimer_list, hrtimer_t, node.entry);
+  return hrtimer == list_first_entry(&queue->list, hrtimer_t, node.entry);
 #endif
 }
 
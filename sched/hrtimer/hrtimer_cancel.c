@@ -64,7 +64,7 @@ static inline_function bool hrtimer_is_active(FAR hrtimer_t *hrtimer)
 
   for (int i = 0; i < CONFIG_SMP_NCPUS; i++)
     {
-      if (g_hrtimer_running[i] == hrtimer)
+      if (g_hrtimer_queue[i].running == hrtimer)
         {
           is_active = true;
           break;
@@ -106,8 +106,8 @@ static inline_function bool hrtimer_is_active(FAR hrtimer_t *hrtimer)
  *   OK (0) on success; a negated errno value on failure.
  *
  * Assumptions/Notes:
- *   - This function acquires the global hrtimer spinlock to protect
- *     the container.
+ *   - This function acquires the lock of the queue the timer is armed
+ *     on to protect the container.
  *   - The caller must ensure that the timer structure is not freed until
  *     it is guaranteed that any running callback has returned.
  *
@@ -115,19 +115,21 @@ static inline_function bool hrtimer_is_active(FAR hrtimer_t *hrtimer)
 
 int hrtimer_cancel(FAR hrtimer_t *hrtimer)
 {
-  FAR hrtimer_t *first;
+  FAR struct hrtimer_queue_s *queue;
   irqstate_t flags;
+  bool first = false;
   int ret = OK;
 
   DEBUGASSERT(hrtimer != NULL);
 
   /* Enter critical section to protect the hrtimer container */
 
-  flags = spin_lock_irqsave(&g_hrtimer_spinlock);
+  queue = hrtimer_lock(hrtimer, &flags);
 
   if (hrtimer_is_armed(hrtimer))
     {
-      hrtimer_remove(hrtimer);
+      first = hrtimer_is_first(queue, hrtimer);
+      hrtimer_remove(queue, hrtimer);
     }
 
   /* If the timer was running, increment its expiration count to prevent
@@ -138,18 +140,14 @@ int hrtimer_cancel(FAR hrtimer_t *hrtimer)
 
   /* If the canceled timer was the earliest one, update the hardware timer */
 
-  if (hrtimer_is_first(hrtimer))
+  if (first)
     {
-      first = hrtimer_get_first();
-      if (first != NULL)
-        {
-          ret = hrtimer_starttimer(first->expired);
-        }
+      ret = hrtimer_reprogram(queue);
     }
 
   /* Leave critical section */
 
-  spin_unlock_irqrestore(&g_hrtimer_spinlock, flags);
+  spin_unlock_irqrestore(&queue->lock, flags);
   return ret;
 }
 
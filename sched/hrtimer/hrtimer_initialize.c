@@ -32,41 +32,25 @@
  * Public Data
  ****************************************************************************/
 
-/* Array of pointers to currently running high-resolution timers
- * for each CPU in SMP configurations. Index corresponds to CPU ID.
- */
-
-#ifdef CONFIG_SMP
-FAR hrtimer_t *g_hrtimer_running[CONFIG_SMP_NCPUS];
-#endif
-
-/* Global spinlock protecting the high-resolution timer subsystem.
+/* Spinlock protecting the shared hardware timer.
  *
- * This spinlock serializes access to the hrtimer container and
- * protects timer state transitions. It must be held whenever the
- * timer container is modified.
+ * Each CPU queue has its own lock; this one is only taken when the head
+ * of a queue changes, to keep the hardware timer programmed with the
+ * earliest expiration of all of the queues.
  */
 
 spinlock_t g_hrtimer_spinlock = SP_UNLOCKED;
 
-/* Container for all active high-resolution timers.
+/* Per-CPU containers of the active high-resolution timers.
  *
- * When CONFIG_HRTIMER_TREE is enabled, timers are stored in a container.
- * When disabled, timers are stored in a linked list.
+ * When CONFIG_HRTIMER_TREE is enabled, timers are stored in a red-black
+ * tree.  When disabled, timers are stored in a linked list.
  *
  * The container is ordered by absolute expiration time in
  * both configurations.
  */
 
-#ifdef CONFIG_HRTIMER_TREE
-/* Red-black tree for hrtimer storage (requires CONFIG_HRTIMER_TREE) */
-
-struct hrtimer_tree_s g_hrtimer_tree = RB_INITIALIZER(g_hrtimer_tree);
-#else
-/* Linked list for hrtimer storage (fallback when tree is disabled) */
-
-struct list_node g_hrtimer_list = LIST_INITIAL_VALUE(g_hrtimer_list);
-#endif
+struct hrtimer_queue_s g_hrtimer_queue[CONFIG_SMP_NCPUS];
 
 /****************************************************************************
  * Public Functions
@@ -89,7 +73,7 @@ struct list_node g_hrtimer_list = LIST_INITIAL_VALUE(g_hrtimer_list);
  *   - The tree key is the absolute expiration time stored in
  *     hrtimer_node_s and compared via hrtimer_compare().
  *   - All accesses to the tree must be serialized using
- *     g_hrtimer_spinlock.
+ *     the lock of the queue.
  *   - These generated functions are used internally by the hrtimer
  *     core (e.g., hrtimer_start(), hrtimer_cancel(), and expire paths).
  ****************************************************************************/
@@ -97,3 +81,34 @@ struct list_node g_hrtimer_list = LIST_INITIAL_VALUE(g_hrtimer_list);
 #ifdef CONFIG_HRTIMER_TREE
 RB_GENERATE(hrtimer_tree_s, hrtimer_node_s, entry, hrtimer_compare);
 #endif
+
+/****************************************************************************
+ * Name: hrtimer_initialize
+ *
+ * Description:
+ *   Initialize the high-resolution timer queue of each CPU.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void hrtimer_initialize(void)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_SMP_NCPUS; i++)
+    {
+      FAR struct hrtimer_queue_s *queue = &g_hrtimer_queue[i];
+
+      spin_lock_init(&queue->lock);
+#ifdef CONFIG_HRTIMER_TREE
+      RB_INIT(&queue->tree);
+#else
+      list_initialize(&queue->list);
+#endif
+    }
+}
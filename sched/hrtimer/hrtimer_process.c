@@ -26,34 +26,150 @@
 
 #include <nuttx/config.h>
 #include <assert.h>
+#include <debug.h>
 #include <nuttx/arch.h>
 #include <nuttx/clock.h>
+#include <nuttx/sched.h>
 
 #include "hrtimer/hrtimer.h"
 
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+static int hrtimer_process_cpu(FAR void *arg);
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+/* Expiration time the shared hardware timer is currently programmed with,
+ * protected by g_hrtimer_spinlock.
+ */
+
+static uint64_t g_hrtimer_expired;
+static bool g_hrtimer_started;
+
+/* Used to ask another CPU to expire the timers of its own queue */
+
+static struct smp_call_data_s g_hrtimer_call =
+SMP_CALL_INITIALIZER(hrtimer_process_cpu, NULL);
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: hrtimer_process_cpu
+ *
+ * Description:
+ *   SMP call handler run on a CPU whose queue holds expired timers.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+static int hrtimer_process_cpu(FAR void *arg)
+{
+  UNUSED(arg);
+
+  hrtimer_process(hrtimer_gettime());
+  return OK;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: hrtimer_reprogram
+ *
+ * Description:
+ *   Update the earliest expiration of the queue after its head changed
+ *   and restart the hardware timer if the earliest expiration of all of
+ *   the queues moved.
+ *
+ *   Queues that are waiting for their CPU to expire them are skipped,
+ *   otherwise an expiration in the past would retrigger the hardware
+ *   timer until the other CPU gets around to it.
+ *
+ * Input Parameters:
+ *   queue - The queue whose head changed, locked by the caller.
+ *
+ * Returned Value:
+ *   OK (0) on success, negated errno on failure.
+ ****************************************************************************/
+
+int hrtimer_reprogram(FAR struct hrtimer_queue_s *queue)
+{
+  FAR hrtimer_t *first = hrtimer_get_first(queue);
+#ifdef CONFIG_SMP
+  uint64_t next = 0;
+  bool armed = false;
+  int ret = OK;
+  int i;
+
+  spin_lock(&g_hrtimer_spinlock);
+
+  queue->armed = first != NULL;
+  if (first != NULL)
+    {
+      queue->next = first->expired;
+    }
+
+  for (i = 0; i < CONFIG_SMP_NCPUS; i++)
+    {
+      queue = &g_hrtimer_queue[i];
+      if (queue->armed && !queue->pending &&
+          (!armed || clock_compare(queue->next, next)))
+        {
+          next  = queue->next;
+          armed = true;
+        }
+    }
+
+  /* Only touch the hardware if the earliest expiration really moved */
+
+  if (armed && (!g_hrtimer_started || next != g_hrtimer_expired))
+    {
+      ret = hrtimer_starttimer(next);
+
+      /* Don't pretend the timer is armed, the next change retries it */
+
+      g_hrtimer_expired = next;
+      g_hrtimer_started = ret >= 0;
+    }
+
+  spin_unlock(&g_hrtimer_spinlock);
+  return ret;
+#else
+  return first != NULL ? hrtimer_starttimer(first->expired) : OK;
+#endif
+}
+
 /****************************************************************************
  * Name: hrtimer_process
  *
  * Description:
- *   Process all expired high-resolution timers. This function repeatedly
- *   retrieves the earliest timer from the active timer container, checks
- *   if it has expired relative to the current time, removes it from the
- *   container, and invokes its callback function. Processing continues
- *   until:
+ *   Process all expired high-resolution timers of the current CPU. This
+ *   function repeatedly retrieves the earliest timer from the timer queue
+ *   of the CPU, checks if it has expired relative to the current time,
+ *   removes it from the queue, and invokes its callback function.
+ *   Processing continues until:
  *
  *     1. No additional timers have expired, or
- *     2. The active timer set is empty.
+ *     2. The queue is empty.
  *
- *   After all expired timers are processed, the next expiration event is
- *   scheduled based on:
+ *   In SMP configurations the other CPUs holding expired timers are then
+ *   asked to expire them, so that every callback runs on the CPU its
+ *   timer was armed on.
  *
- *     - The earliest remaining timer, or
- *     - A fallback expiration (current time + HRTIMER_DEFAULT_INCREMENT)
- *       if no timers remain.
+ *   After all expired timers are processed, the hardware timer is
+ *   restarted with the earliest expiration of all of the queues.
  *
  * Input Parameters:
  *   now - Current high-resolution timestamp.
@@ -62,7 +178,7 @@
  *   None.
  *
  * Assumptions/Notes:
- *   - This function acquires a spinlock to protect the timer container.
+ *   - This function acquires the lock of the local queue only.
  *   - Timer callbacks are invoked with interrupts enabled
  *     to avoid deadlocks.
  *   - DEBUGASSERT ensures that timer callbacks are valid.
@@ -70,22 +186,30 @@
 
 void hrtimer_process(uint64_t now)
 {
+  FAR struct hrtimer_queue_s *queue;
   FAR hrtimer_t *hrtimer;
   irqstate_t flags;
   hrtimer_entry_t func;
   uint64_t expired;
   uint64_t period;
+  int ret;
 #ifdef CONFIG_SMP
   int cpu = this_cpu();
+  cpu_set_t cpuset;
+  int i;
+
+  queue = &g_hrtimer_queue[cpu];
+#else
+  queue = &g_hrtimer_queue[0];
 #endif
 
-  /* Lock the hrtimer container to protect access */
+  /* Lock the local queue to protect access */
 
-  flags = spin_lock_irqsave(&g_hrtimer_spinlock);
+  flags = spin_lock_irqsave(&queue->lock);
 
   /* Fetch the earliest active timer */
 
-  hrtimer = hrtimer_get_first();
+  hrtimer = hrtimer_get_first(queue);
 
   while (hrtimer != NULL)
     {
@@ -104,16 +228,16 @@ void hrtimer_process(uint64_t now)
           break;
         }
 
-      /* Remove the expired timer from the timer container */
+      /* Remove the expired timer from the timer queue */
 
-      hrtimer_remove(hrtimer);
+      hrtimer_remove(queue, hrtimer);
 
 #ifdef CONFIG_SMP
-      g_hrtimer_running[cpu] = hrtimer;
+      queue->running = hrtimer;
 #endif
       /* Leave critical section before invoking the callback */
 
-      spin_unlock_irqrestore(&g_hrtimer_spinlock, flags);
+      spin_unlock_irqrestore(&queue->lock, flags);
 
       /* Invoke the timer callback */
 
@@ -121,18 +245,19 @@ void hrtimer_process(uint64_t now)
 
       /* Re-enter critical section to update timer state */
 
-      flags = spin_lock_irqsave(&g_hrtimer_spinlock);
+      flags = spin_lock_irqsave(&queue->lock);
 
 #ifdef CONFIG_SMP
-      g_hrtimer_running[cpu] = NULL;
+      queue->running = NULL;
 #endif
 
-      /* If the timer is periodic and has not been rearmed or
+      /* If the timer is periodic and has not been rearmed, moved or
        * cancelled concurrently,
-       * compute next expiration and reinsert into container
+       * compute next expiration and reinsert into the queue
        */
 
-      if (period > 0 && hrtimer->expired == expired)
+      if (period > 0 && hrtimer->expired == expired &&
+          hrtimer_queue(hrtimer) == queue)
         {
           hrtimer->expired += period;
 
@@ -141,24 +266,57 @@ void hrtimer_process(uint64_t now)
           DEBUGASSERT(hrtimer->expired > period);
 
           hrtimer->func = func;
-          hrtimer_insert(hrtimer);
+          hrtimer_insert(queue, hrtimer);
         }
 
       /* Fetch the next earliest timer */
 
-      hrtimer = hrtimer_get_first();
+      hrtimer = hrtimer_get_first(queue);
     }
 
-  /* Schedule the next timer expiration */
+#ifdef CONFIG_SMP
+  /* The hardware timer has fired, kick the other CPUs whose earliest
+   * timer has expired too.
+   */
+
+  CPU_ZERO(&cpuset);
+
+  spin_lock(&g_hrtimer_spinlock);
 
-  if (hrtimer != NULL)
+  g_hrtimer_started = false;
+  queue->pending    = false;
+
+  for (i = 0; i < CONFIG_SMP_NCPUS; i++)
     {
-      /* Start timer for the next earliest expiration */
+      FAR struct hrtimer_queue_s *other = &g_hrtimer_queue[i];
+
+      if (i != cpu && other->armed && !other->pending &&
+          clock_compare(other->next, now))
+        {
+          other->pending = true;
+          CPU_SET(i, &cpuset);
+        }
+    }
 
-      (void)hrtimer_starttimer(hrtimer->expired);
+  spin_unlock(&g_hrtimer_spinlock);
+#endif
+
+  /* Schedule the next timer expiration */
+
+  ret = hrtimer_reprogram(queue);
+  if (ret < 0)
+    {
+      serr("ERROR: hrtimer_reprogram failed: %d\n", ret);
     }
 
   /* Leave critical section */
 
-  spin_unlock_irqrestore(&g_hrtimer_spinlock, flags);
+  spin_unlock_irqrestore(&queue->lock, flags);
+
+#ifdef CONFIG_SMP
+  if (CPU_COUNT(&cpuset) > 0)
+    {
+      nxsched_smp_call_async(cpuset, &g_hrtimer_call);
+    }
+#endif
 }
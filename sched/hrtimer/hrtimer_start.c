@@ -36,11 +36,12 @@
  ****************************************************************************/
 
 /****************************************************************************
- * Name: hrtimer_start
+ * Name: hrtimer_start_on
  *
  * Description:
  *   Start a high-resolution timer to expire after a specified duration
- *   in nanoseconds, either as an absolute or relative time.
+ *   in nanoseconds, either as an absolute or relative time.  The timer is
+ *   queued on the given CPU, which will run the callback.
  *
  * Input Parameters:
  *   hrtimer - Pointer to the hrtimer structure.
@@ -48,35 +49,70 @@
  *   expired - Expiration time in nanoseconds. Interpretation
  *             depends on mode.
  *   mode    - Timer mode (HRTIMER_MODE_ABS or HRTIMER_MODE_REL).
+ *   cpu     - The CPU whose queue the timer is inserted into.
  *
  * Returned Value:
  *   OK (0) on success, or a negated errno value on failure.
  *
  * Assumptions/Notes:
  *   - This function disables interrupts briefly via spinlock to safely
- *     insert the timer into the container.
+ *     insert the timer into the queue.  Only the lock of the queue is
+ *     taken, unless the timer becomes the earliest one of the queue.
  *   - Absolute mode sets the timer to expire at the given absolute time.
  *   - Relative mode sets the timer to expire after 'ns'
  *     nanoseconds from the current time.
  ****************************************************************************/
 
-int hrtimer_start(FAR hrtimer_t *hrtimer, hrtimer_entry_t func,
-                  uint64_t expired,
-                  enum hrtimer_mode_e mode)
+int hrtimer_start_on(FAR hrtimer_t *hrtimer, hrtimer_entry_t func,
+                     uint64_t expired, enum hrtimer_mode_e mode,
+                     int cpu)
 {
+  FAR struct hrtimer_queue_s *queue;
   irqstate_t flags;
+  bool first = false;
   int ret = OK;
 
   DEBUGASSERT(hrtimer != NULL);
+  DEBUGASSERT(cpu >= 0 && cpu < CONFIG_SMP_NCPUS);
 
-  /* Protect container manipulation with spinlock and disable interrupts */
+  /* Protect queue manipulation with spinlock and disable interrupts */
 
-  flags = spin_lock_irqsave(&g_hrtimer_spinlock);
+  queue = hrtimer_lock(hrtimer, &flags);
 
   if (hrtimer_is_armed(hrtimer))
     {
-      hrtimer_remove(hrtimer);
+      first = hrtimer_is_first(queue, hrtimer);
+      hrtimer_remove(queue, hrtimer);
+    }
+
+#ifdef CONFIG_SMP
+  if (hrtimer->cpu != cpu)
+    {
+      /* Move the timer to the queue of the target CPU.  A concurrent
+       * hrtimer_start_on() may move it again once the lock is dropped,
+       * so the timer goes into whatever queue owns it when relocked.
+       */
+
+      if (first)
+        {
+          ret = hrtimer_reprogram(queue);
+        }
+
+      hrtimer->cpu = cpu;
+      spin_unlock_irqrestore(&queue->lock, flags);
+
+      queue = hrtimer_lock(hrtimer, &flags);
+      first = false;
+
+      if (hrtimer_is_armed(hrtimer))
+        {
+          first = hrtimer_is_first(queue, hrtimer);
+          hrtimer_remove(queue, hrtimer);
+        }
     }
+#else
+  UNUSED(cpu);
+#endif
 
   hrtimer->func = func;
 
@@ -95,20 +131,36 @@ int hrtimer_start(FAR hrtimer_t *hrtimer, hrtimer_entry_t func,
 
   DEBUGASSERT(hrtimer->expired >= expired);
 
-  /* Insert the timer into the container */
+  /* Insert the timer into the queue */
 
-  hrtimer_insert(hrtimer);
+  hrtimer_insert(queue, hrtimer);
 
-  /* If the inserted timer is now the earliest, start hardware timer */
+  /* If the timer was or now is the earliest, update the hardware timer */
 
-  if (hrtimer_is_first(hrtimer))
+  if (first || hrtimer_is_first(queue, hrtimer))
     {
-      ret = hrtimer_starttimer(hrtimer->expired);
+      ret = hrtimer_reprogram(queue);
     }
 
   /* Release spinlock and restore interrupts */
 
-  spin_unlock_irqrestore(&g_hrtimer_spinlock, flags);
+  spin_unlock_irqrestore(&queue->lock, flags);
 
   return ret;
 }
+
+/****************************************************************************
+ * Name: hrtimer_start
+ *
+ * Description:
+ *   Start a high-resolution timer on the calling CPU.  See
+ *   hrtimer_start_on().
+ *
+ ****************************************************************************/
+
+int hrtimer_start(FAR hrtimer_t *hrtimer, hrtimer_entry_t func,
+                  uint64_t expired,
+                  enum hrtimer_mode_e mode)
+{
+  return hrtimer_start_on(hrtimer, func, expired, mode, this_cpu());
+}
@@ -56,6 +56,7 @@
 #include "mqueue/mqueue.h"
 #include "mqueue/msg.h"
 #include "clock/clock.h"
+#include "hrtimer/hrtimer.h"
 #include "timer/timer.h"
 #include "irq/irq.h"
 #include "group/group.h"
@@ -115,6 +116,14 @@ dq_queue_t g_readytorun;
 #ifdef CONFIG_SMP
 FAR struct tcb_s *g_assignedtasks[CONFIG_SMP_NCPUS];
 enum task_deliver_e g_delivertasks[CONFIG_SMP_NCPUS];
+
+#ifdef CONFIG_SCHED_CPU_RUNQUEUE
+/* These are the ready-to-run lists of the tasks that can only run on one
+ * CPU.  They are prioritized like g_readytorun.
+ */
+
+dq_queue_t g_cpureadytorun[CONFIG_SMP_NCPUS];
+#endif
 #endif
 
 /* g_running_tasks[] holds a references to the running task for each CPU.
@@ -133,6 +142,15 @@ FAR struct tcb_s *g_running_tasks[CONFIG_SMP_NCPUS];
 dq_queue_t g_pendingtasks;
 #endif
 
+#ifdef CONFIG_SCHED_PRIORITY_BITMAP
+/* These are the priority indexes of g_readytorun and g_pendingtasks */
+
+struct prioindex_s g_readytorun_index;
+#ifndef CONFIG_SMP
+struct prioindex_s g_pendingtasks_index;
+#endif
+#endif
+
 /* This is the list of all tasks that are blocked waiting for a signal */
 
 dq_queue_t g_waitingforsignal;
@@ -406,6 +424,9 @@ static void idle_task_initialize(void)
       g_assignedtasks[i] = tcb;
 #else
       dq_addfirst((FAR dq_entry_t *)tcb, TLIST_HEAD(tcb));
+#  ifdef CONFIG_SCHED_PRIORITY_BITMAP
+      nxsched_prioindex_add(&g_readytorun_index, tcb);
+#  endif
 #endif
 
       /* Mark the idle task as the running task */
@@ -630,6 +651,12 @@ void nx_start(void)
 
   irq_initialize();
 
+#ifdef CONFIG_HRTIMER
+  /* Initialize the high-resolution timer queues */
+
+  hrtimer_initialize();
+#endif
+
   /* Initialize the POSIX timer facility (if included in the link) */
 
   clock_initialize();
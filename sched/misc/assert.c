@@ -118,9 +118,9 @@ static uintptr_t g_last_regs[CONFIG_SMP_NCPUS][XCPTCONTEXT_REGS]
                  aligned_data(XCPTCONTEXT_ALIGN);
 
 #ifdef CONFIG_DEBUG_ALERT
-static FAR const char * const g_policy[4] =
+static FAR const char * const g_policy[8] =
 {
-  "FIFO", "RR", "SPORADIC"
+  "FIFO", "RR", "SPORADIC", "DEADLINE", "FAIR"
 };
 
 static FAR const char * const g_ttypenames[4] =
@@ -377,6 +377,18 @@ int nx_pthread_create(pthread_trampoline_t trampoline, FAR pthread_t *thread,
     }
 #endif
 
+#ifdef CONFIG_SCHED_FAIR
+  if (policy == SCHED_BATCH || policy == SCHED_IDLE)
+    {
+      /* The priority is the nice value of the fair thread, which runs in
+       * the fair share band.
+       */
+
+      nxsched_setup_fair(ptcb, policy, param.sched_priority);
+      param.sched_priority = CONFIG_SCHED_FAIR_PRIORITY;
+    }
+#endif
+
   /* Initialize the task control block */
 
   ret = pthread_setup_scheduler(ptcb, param.sched_priority, pthread_start,
@@ -443,8 +455,18 @@ int nx_pthread_create(pthread_trampoline_t trampoline, FAR pthread_t *thread,
         ptcb->flags    |= TCB_FLAG_SCHED_SPORADIC;
         break;
 #endif
+
+#ifdef CONFIG_SCHED_FAIR
+      case SCHED_BATCH:
+      case SCHED_IDLE:
+        ptcb->flags    |= TCB_FLAG_SCHED_FAIR;
+        ptcb->timeslice = MSEC2TICK(CONFIG_RR_INTERVAL);
+        break;
+#endif
     }
 
+  nxsched_reset_timerslack(ptcb);
+
   /* Return the thread information to the caller */
 
   if (thread != NULL)
@@ -31,6 +31,8 @@
 
 #include <sys/types.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <strings.h>
 #include <sched.h>
 
 #include <nuttx/arch.h>
@@ -53,6 +55,9 @@
  */
 
 #define list_readytorun()        (&g_readytorun)
+#ifdef CONFIG_SCHED_CPU_RUNQUEUE
+#define list_cpureadytorun(cpu)  (&g_cpureadytorun[cpu])
+#endif
 #ifndef CONFIG_SMP
 #define list_pendingtasks()      (&g_pendingtasks)
 #endif
@@ -119,6 +124,24 @@
 #  define CRITMONITOR_PANIC(fmt, ...) _alert(fmt, ##__VA_ARGS__)
 #endif
 
+/* Geometry of the priority index of the ready-to-run lists */
+
+#ifdef CONFIG_SCHED_PRIORITY_BITMAP
+#  define PRIOINDEX_NLEVELS      (SCHED_PRIORITY_MAX + 1)
+#  define PRIOINDEX_NWORDS       ((PRIOINDEX_NLEVELS + 31) >> 5)
+#endif
+
+/* Load weights of the fair share threads:  A nice 0 thread has the weight
+ * FAIR_WEIGHT_NICE0, each nice step changes it by about 25%.
+ */
+
+#ifdef CONFIG_SCHED_FAIR
+#  define FAIR_NICE_MIN          (-20)
+#  define FAIR_NICE_MAX          19
+#  define FAIR_WEIGHT_NICE0      1024
+#  define FAIR_WEIGHT_IDLE       3
+#endif
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -133,6 +156,17 @@ struct tasklist_s
   uint8_t attr;          /* List attribute flags */
 };
 
+#ifdef CONFIG_SCHED_PRIORITY_BITMAP
+/* This is the priority index of a prioritized task list */
+
+struct prioindex_s
+{
+  uint32_t summary;                          /* Bit n set: map[n] != 0 */
+  uint32_t map[PRIOINDEX_NWORDS];            /* Bit n set: level n in use */
+  FAR struct tcb_s *tail[PRIOINDEX_NLEVELS]; /* Last TCB of each level */
+};
+#endif
+
 /* This enumeration defines smp schedule task switch rule */
 
 enum task_deliver_e
@@ -189,6 +223,15 @@ extern dq_queue_t g_readytorun;
 
 extern FAR struct tcb_s *g_assignedtasks[CONFIG_SMP_NCPUS];
 
+#ifdef CONFIG_SCHED_CPU_RUNQUEUE
+/* Ready-to-run tasks that can only run on one CPU are kept in the
+ * g_cpureadytorun list of that CPU rather than in g_readytorun.  Such a TCB
+ * has TCB_FLAG_CPU_RUNQUEUE set while it is queued.
+ */
+
+extern dq_queue_t g_cpureadytorun[CONFIG_SMP_NCPUS];
+#endif
+
 /* g_delivertasks is used to indicate that a task switch is scheduled for
  * another cpu to be processed.
  */
@@ -211,6 +254,21 @@ extern struct tcb_s g_idletcb[CONFIG_SMP_NCPUS];
 extern dq_queue_t g_pendingtasks;
 #endif
 
+#ifdef CONFIG_SCHED_PRIORITY_BITMAP
+/* The g_readytorun and g_pendingtasks lists are shadowed by a priority
+ * index:  A bitmap of the priority levels present in the list and the last
+ * TCB of each of these levels.  A new TCB goes right after the last TCB of
+ * the lowest level at or above its own priority, so the insertion point is
+ * found with two find-first-set operations instead of a walk of the list.
+ * The tail[] entry of a level is only meaningful while its bit is set.
+ */
+
+extern struct prioindex_s g_readytorun_index;
+#ifndef CONFIG_SMP
+extern struct prioindex_s g_pendingtasks_index;
+#endif
+#endif
+
 /* This is the list of all tasks that are blocked waiting for a signal */
 
 extern dq_queue_t g_waitingforsignal;
@@ -362,6 +420,22 @@ clock_t nxsched_process_sporadic(FAR struct tcb_s *tcb, clock_t ticks,
 void nxsched_sporadic_lowpriority(FAR struct tcb_s *tcb);
 #endif
 
+#ifdef CONFIG_SCHED_DEADLINE
+int  nxsched_start_deadline(FAR struct tcb_s *tcb,
+                            FAR const struct sched_param *param);
+void nxsched_stop_deadline(FAR struct tcb_s *tcb);
+void nxsched_wakeup_deadline(FAR struct tcb_s *tcb);
+void nxsched_resume_deadline(FAR struct tcb_s *tcb);
+void nxsched_suspend_deadline(FAR struct tcb_s *tcb);
+#endif
+
+#ifdef CONFIG_SCHED_FAIR
+void nxsched_setup_fair(FAR struct tcb_s *tcb, int policy, int priority);
+void nxsched_wakeup_fair(FAR struct tcb_s *tcb);
+clock_t nxsched_process_fair(FAR struct tcb_s *tcb, clock_t ticks,
+                             bool noswitches);
+#endif
+
 #ifdef CONFIG_SIG_SIGSTOP_ACTION
 void nxsched_suspend(FAR struct tcb_s *tcb);
 #endif
@@ -455,6 +529,214 @@ FAR char **nxsched_get_stackargs(FAR struct tcb_s *tcb);
  * Inline functions
  ****************************************************************************/
 
+#ifdef CONFIG_SCHED_PRIORITY_BITMAP
+/* Return the priority index of a task list, or NULL if it has none */
+
+static inline_function FAR struct prioindex_s *
+nxsched_prioindex(DSEG dq_queue_t *list)
+{
+  if (list == list_readytorun())
+    {
+      return &g_readytorun_index;
+    }
+
+#ifndef CONFIG_SMP
+  if (list == list_pendingtasks())
+    {
+      return &g_pendingtasks_index;
+    }
+#endif
+
+  return NULL;
+}
+
+/* Forget all of the levels of an index whose list has been emptied */
+
+static inline_function void
+nxsched_prioindex_reset(FAR struct prioindex_s *index)
+{
+  int i;
+
+  for (i = 0; i < PRIOINDEX_NWORDS; i++)
+    {
+      index->map[i] = 0;
+    }
+
+  index->summary = 0;
+}
+
+/* Account a TCB that has just been linked into the indexed list.  It
+ * becomes the tail of its level unless a TCB of the same priority follows.
+ */
+
+static inline_function void
+nxsched_prioindex_add(FAR struct prioindex_s *index, FAR struct tcb_s *tcb)
+{
+  FAR struct tcb_s *next = tcb->flink;
+  uint8_t prio = tcb->sched_priority;
+
+  if (next == NULL || next->sched_priority != prio)
+    {
+      index->tail[prio]     = tcb;
+      index->map[prio >> 5] |= UINT32_C(1) << (prio & 31);
+      index->summary        |= UINT32_C(1) << (prio >> 5);
+    }
+}
+
+/* Account a TCB that is about to be unlinked from the indexed list */
+
+static inline_function void
+nxsched_prioindex_remove(FAR struct prioindex_s *index,
+                         FAR struct tcb_s *tcb)
+{
+  FAR struct tcb_s *prev = tcb->blink;
+  uint8_t prio = tcb->sched_priority;
+
+  if (index->tail[prio] != tcb)
+    {
+      return;
+    }
+
+  if (prev != NULL && prev->sched_priority == prio)
+    {
+      index->tail[prio] = prev;
+    }
+  else
+    {
+      index->map[prio >> 5] &= ~(UINT32_C(1) << (prio & 31));
+      if (index->map[prio >> 5] == 0)
+        {
+          index->summary &= ~(UINT32_C(1) << (prio >> 5));
+        }
+    }
+}
+
+/* Return the last TCB of the lowest level at or above prio, or NULL if the
+ * list holds no TCB of that priority or higher.
+ */
+
+static inline_function FAR struct tcb_s *
+nxsched_prioindex_find(FAR struct prioindex_s *index, uint8_t prio)
+{
+  int word = prio >> 5;
+  uint32_t bits = index->map[word] & (UINT32_MAX << (prio & 31));
+
+  if (bits == 0)
+    {
+      uint32_t words = index->summary & ~((UINT32_C(2) << word) - 1);
+
+      if (words == 0)
+        {
+          return NULL;
+        }
+
+      word = ffs((int)words) - 1;
+      bits = index->map[word];
+    }
+
+  return index->tail[(word << 5) + ffs((int)bits) - 1];
+}
+#endif
+
+/* Return true if tcb must be queued ahead of next, a TCB of the same
+ * priority:  Deadline threads are kept in earliest deadline first order and
+ * fair share threads in order of increasing virtual run time.
+ */
+
+#if defined(CONFIG_SCHED_DEADLINE) || defined(CONFIG_SCHED_FAIR)
+static inline_function bool nxsched_queue_before(FAR struct tcb_s *tcb,
+                                                 FAR struct tcb_s *next)
+{
+  uint32_t policy = tcb->flags & TCB_FLAG_POLICY_MASK;
+
+  if (policy != (next->flags & TCB_FLAG_POLICY_MASK))
+    {
+      return false;
+    }
+
+#ifdef CONFIG_SCHED_DEADLINE
+  if (policy == TCB_FLAG_SCHED_DEADLINE)
+    {
+      return (sclock_t)(tcb->deadline->abs_deadline -
+                        next->deadline->abs_deadline) < 0;
+    }
+#endif
+
+#ifdef CONFIG_SCHED_FAIR
+  if (policy == TCB_FLAG_SCHED_FAIR)
+    {
+      return (int64_t)(tcb->vruntime - next->vruntime) < 0;
+    }
+#endif
+
+  return false;
+}
+#else
+#  define nxsched_queue_before(tcb, next) false
+#endif
+
+/* Update the timer slack after the policy of the thread changed:  The
+ * real-time threads keep their timed waits exact, the sporadic and fair
+ * share threads start with the default slack unless they set their own
+ * with prctl(PR_SET_TIMERSLACK).
+ */
+
+#ifdef CONFIG_SCHED_TIMER_SLACK
+static inline_function void nxsched_reset_timerslack(FAR struct tcb_s *tcb)
+{
+  uint32_t policy = tcb->flags & TCB_FLAG_POLICY_MASK;
+
+  if (policy == TCB_FLAG_SCHED_SPORADIC || policy == TCB_FLAG_SCHED_FAIR)
+    {
+      if (tcb->timerslack == 0)
+        {
+          tcb->timerslack = CONFIG_SCHED_TIMER_SLACK_DEFAULT /
+                            USEC_PER_TICK;
+        }
+    }
+  else
+    {
+      tcb->timerslack = 0;
+    }
+}
+#else
+#  define nxsched_reset_timerslack(tcb)
+#endif
+
+/* Remove a TCB from a prioritized task list */
+
+static inline_function void
+nxsched_remove_prioritized(FAR struct tcb_s *tcb, DSEG dq_queue_t *list)
+{
+#ifdef CONFIG_SCHED_PRIORITY_BITMAP
+  FAR struct prioindex_s *index = nxsched_prioindex(list);
+
+  if (index != NULL)
+    {
+      nxsched_prioindex_remove(index, tcb);
+    }
+#endif
+
+  dq_rem((FAR dq_entry_t *)tcb, list);
+}
+
+/* Change the priority of the running task without moving it.  The running
+ * task is the head of g_readytorun in the non-SMP case, so the caller must
+ * make sure that the list stays in priority order.
+ */
+
+static inline_function void
+nxsched_set_running_priority(FAR struct tcb_s *tcb, uint8_t sched_priority)
+{
+#if defined(CONFIG_SCHED_PRIORITY_BITMAP) && !defined(CONFIG_SMP)
+  nxsched_prioindex_remove(&g_readytorun_index, tcb);
+  tcb->sched_priority = sched_priority;
+  nxsched_prioindex_add(&g_readytorun_index, tcb);
+#else
+  tcb->sched_priority = sched_priority;
+#endif
+}
+
 static inline_function bool nxsched_add_prioritized(FAR struct tcb_s *tcb,
                                                     DSEG dq_queue_t *list)
 {
@@ -462,17 +744,73 @@ static inline_function bool nxsched_add_prioritized(FAR struct tcb_s *tcb,
   FAR struct tcb_s *prev;
   uint8_t sched_priority = tcb->sched_priority;
   bool ret = false;
+#ifdef CONFIG_SCHED_PRIORITY_BITMAP
+  FAR struct prioindex_s *index = nxsched_prioindex(list);
+#endif
 
   /* Lets do a sanity check before we get started. */
 
   DEBUGASSERT(sched_priority >= SCHED_PRIORITY_MIN);
 
+#ifdef CONFIG_SCHED_PRIORITY_BITMAP
+  /* Indexed lists:  The tcb goes just after the last TCB with the same or
+   * the next higher priority, or at the head of the list if there is none.
+   */
+
+  if (index != NULL)
+    {
+      prev = nxsched_prioindex_find(index, sched_priority);
+
+#if defined(CONFIG_SCHED_DEADLINE) || defined(CONFIG_SCHED_FAIR)
+      /* Deadline and fair threads may have to go ahead of the TCBs of their
+       * level.
+       */
+
+      while (prev != NULL && prev->sched_priority == sched_priority &&
+             nxsched_queue_before(tcb, prev))
+        {
+          prev = prev->blink;
+        }
+#endif
+
+      if (prev == NULL)
+        {
+          next        = (FAR struct tcb_s *)list->head;
+          tcb->flink  = next;
+          tcb->blink  = NULL;
+          list->head  = (FAR dq_entry_t *)tcb;
+          ret         = true;
+        }
+      else
+        {
+          next        = prev->flink;
+          tcb->flink  = next;
+          tcb->blink  = prev;
+          prev->flink = tcb;
+        }
+
+      if (next == NULL)
+        {
+          list->tail  = (FAR dq_entry_t *)tcb;
+        }
+      else
+        {
+          next->blink = tcb;
+        }
+
+      nxsched_prioindex_add(index, tcb);
+      return ret;
+    }
+#endif
+
   /* Search the list to find the location to insert the new Tcb.
    * Each is list is maintained in descending sched_priority order.
    */
 
   for (next = (FAR struct tcb_s *)list->head;
-       (next && sched_priority <= next->sched_priority);
+       (next && (sched_priority < next->sched_priority ||
+                 (sched_priority == next->sched_priority &&
+                  !nxsched_queue_before(tcb, next))));
        next = next->flink);
 
   /* Add the tcb to the spot found in the list.  Check if the tcb
@@ -536,6 +874,83 @@ static inline_function bool nxsched_add_prioritized(FAR struct tcb_s *tcb,
 
 #  ifdef CONFIG_SMP
 
+/* Return the ready-to-run list that holds a queued, non-running TCB */
+
+static inline_function DSEG dq_queue_t *
+nxsched_runqueue(FAR struct tcb_s *tcb)
+{
+#ifdef CONFIG_SCHED_CPU_RUNQUEUE
+  if ((tcb->flags & TCB_FLAG_CPU_RUNQUEUE) != 0)
+    {
+      return list_cpureadytorun(tcb->cpu);
+    }
+#endif
+
+  return list_readytorun();
+}
+
+/* Queue a TCB in the right ready-to-run list:  The list of its CPU if it
+ * can only run on one CPU, otherwise the shared g_readytorun list.
+ */
+
+static inline_function void nxsched_add_runqueue(FAR struct tcb_s *tcb)
+{
+#ifdef CONFIG_SCHED_CPU_RUNQUEUE
+  cpu_set_t affinity = tcb->affinity;
+
+  /* An empty affinity would give no CPU at all, keep such a task in the
+   * shared list.
+   */
+
+  DEBUGASSERT(affinity != 0);
+  if ((tcb->flags & TCB_FLAG_CPU_LOCKED) == 0 && affinity != 0 &&
+      (affinity & (affinity - 1)) == 0 &&
+      ffs((int)affinity) <= CONFIG_SMP_NCPUS)
+    {
+      tcb->cpu = ffs((int)affinity) - 1;
+      tcb->flags |= TCB_FLAG_CPU_RUNQUEUE;
+    }
+  else if ((tcb->flags & TCB_FLAG_CPU_LOCKED) != 0)
+    {
+      tcb->flags |= TCB_FLAG_CPU_RUNQUEUE;
+    }
+#endif
+
+  nxsched_add_prioritized(tcb, nxsched_runqueue(tcb));
+}
+
+/* Remove a queued, non-running TCB from its ready-to-run list */
+
+static inline_function void nxsched_remove_runqueue(FAR struct tcb_s *tcb)
+{
+  nxsched_remove_prioritized(tcb, nxsched_runqueue(tcb));
+#ifdef CONFIG_SCHED_CPU_RUNQUEUE
+  tcb->flags &= ~TCB_FLAG_CPU_RUNQUEUE;
+#endif
+}
+
+/* Return the highest priority ready-to-run task that may be a candidate
+ * for "cpu", or NULL if there is none.  The head of the shared list may
+ * still be excluded from "cpu" by its affinity.
+ */
+
+static inline_function FAR struct tcb_s *nxsched_peek_runqueue(int cpu)
+{
+  FAR struct tcb_s *tcb = (FAR struct tcb_s *)dq_peek(list_readytorun());
+#ifdef CONFIG_SCHED_CPU_RUNQUEUE
+  FAR struct tcb_s *ltcb =
+    (FAR struct tcb_s *)dq_peek(list_cpureadytorun(cpu));
+
+  if (ltcb != NULL &&
+      (tcb == NULL || ltcb->sched_priority > tcb->sched_priority))
+    {
+      tcb = ltcb;
+    }
+#endif
+
+  return tcb;
+}
+
 /* Try to switch the head of the ready-to-run list to active on "target_cpu".
  * "cpu" is "this_cpu()", and passed only for optimization.
  */
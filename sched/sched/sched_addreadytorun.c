@@ -153,7 +153,8 @@ bool nxsched_switch_running(int cpu, bool switch_equal)
 {
   FAR struct tcb_s *rtcb = current_task(cpu);
   int sched_priority = rtcb->sched_priority;
-  FAR struct tcb_s *btcb;
+  FAR struct tcb_s *btcb = NULL;
+  FAR struct tcb_s *tcb;
   bool ret = false;
 
   DEBUGASSERT(cpu == this_cpu());
@@ -168,48 +169,76 @@ bool nxsched_switch_running(int cpu, bool switch_equal)
       sched_priority--;
     }
 
+#ifdef CONFIG_SCHED_CPU_RUNQUEUE
+  /* The tasks that can only run on this CPU are queued in its own list, so
+   * its head is the best of them.
+   */
+
+  tcb = (FAR struct tcb_s *)dq_peek(list_cpureadytorun(cpu));
+  if (tcb != NULL && tcb->sched_priority > sched_priority)
+    {
+      btcb = tcb;
+      sched_priority = tcb->sched_priority;
+    }
+#endif
+
   /* If there is a task in readytorun list, which is eglible to run on this
    * CPU, and has higher priority than the current task,
    * switch the current task to that one.
    */
 
-  for (btcb = (FAR struct tcb_s *)dq_peek(list_readytorun());
-       btcb && btcb->sched_priority > sched_priority;
-       btcb = btcb->flink)
+  for (tcb = (FAR struct tcb_s *)dq_peek(list_readytorun());
+       tcb && tcb->sched_priority > sched_priority;
+       tcb = tcb->flink)
     {
       /* Check if the task found in ready-to-run list is allowed to run on
        * this CPU. TCB_FLAG_CPU_LOCKED may be used to override affinity. If
-       * the flag is set, assume that btcb->cpu is valid, and it is the only
-       * CPU on which the btcb can run.
+       * the flag is set, assume that tcb->cpu is valid, and it is the only
+       * CPU on which the tcb can run.
        */
 
-      if (CPU_ISSET(cpu, &btcb->affinity) &&
-          ((btcb->flags & TCB_FLAG_CPU_LOCKED) == 0 || btcb->cpu == cpu))
+      if (CPU_ISSET(cpu, &tcb->affinity) &&
+          ((tcb->flags & TCB_FLAG_CPU_LOCKED) == 0 || tcb->cpu == cpu))
         {
-          /* Found a task, remove it from ready-to-run list */
+          btcb = tcb;
+          break;
+        }
+    }
 
-          dq_rem((FAR struct dq_entry_s *)btcb, list_readytorun());
+  /* Deadline and fair tasks keep the CPU if they would be queued ahead of
+   * the task found at the same priority anyway.
+   */
+
+  if (btcb != NULL && btcb->sched_priority == rtcb->sched_priority &&
+      nxsched_queue_before(rtcb, btcb))
+    {
+      btcb = NULL;
+    }
 
-          if (!is_idle_task(rtcb))
-            {
-              /* Put currently running task back to ready-to-run list */
+  if (btcb != NULL)
+    {
+      /* Found a task, remove it from its ready-to-run list */
 
-              rtcb->task_state = TSTATE_TASK_READYTORUN;
-              nxsched_add_prioritized(rtcb, list_readytorun());
-            }
-          else
-            {
-              rtcb->task_state = TSTATE_TASK_ASSIGNED;
-            }
+      nxsched_remove_runqueue(btcb);
 
-          g_assignedtasks[cpu] = btcb;
-          up_update_task(btcb);
+      if (!is_idle_task(rtcb))
+        {
+          /* Put currently running task back to ready-to-run list */
 
-          btcb->cpu = cpu;
-          btcb->task_state = TSTATE_TASK_RUNNING;
-          ret = true;
-          break;
+          rtcb->task_state = TSTATE_TASK_READYTORUN;
+          nxsched_add_runqueue(rtcb);
+        }
+      else
+        {
+          rtcb->task_state = TSTATE_TASK_ASSIGNED;
         }
+
+      g_assignedtasks[cpu] = btcb;
+      up_update_task(btcb);
+
+      btcb->cpu = cpu;
+      btcb->task_state = TSTATE_TASK_RUNNING;
+      ret = true;
     }
 
   return ret;
@@ -261,7 +290,7 @@ bool nxsched_add_readytorun(FAR struct tcb_s *btcb)
    */
 
   btcb->task_state = TSTATE_TASK_READYTORUN;
-  nxsched_add_prioritized(btcb, list_readytorun());
+  nxsched_add_runqueue(btcb);
 
   if (target_cpu < CONFIG_SMP_NCPUS)
     {
@@ -0,0 +1,433 @@
+/****************************************************************************
+ * sched/sched/sched_deadline.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+#include <debug.h>
+#include <errno.h>
+
+#include <nuttx/sched.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/wdog.h>
+#include <nuttx/clock.h>
+
+#include "clock/clock.h"
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_DEADLINE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Bandwidths are runtime / period ratios in fixed point */
+
+#define DEADLINE_BW_SHIFT     20
+#define DEADLINE_BW_ONE       (UINT32_C(1) << DEADLINE_BW_SHIFT)
+#define DEADLINE_BW_LIMIT \
+  ((DEADLINE_BW_ONE / 100) * CONFIG_SCHED_DEADLINE_MAX_BW * CONFIG_SMP_NCPUS)
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The bandwidth reserved by all of the deadline threads */
+
+static uint32_t g_deadline_bw;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: deadline_set_priority
+ *
+ * Description:
+ *   Move the thread to the throttled or to its normal priority.  A thread
+ *   whose priority is boosted by priority inheritance keeps running at the
+ *   boosted priority, only its base priority is changed.
+ *
+ ****************************************************************************/
+
+static void deadline_set_priority(FAR struct tcb_s *tcb, int priority)
+{
+  int ret;
+
+#ifdef CONFIG_PRIORITY_INHERITANCE
+  if (tcb->sched_priority > tcb->base_priority &&
+      tcb->sched_priority >= priority)
+    {
+      tcb->base_priority = priority;
+      return;
+    }
+#endif
+
+  ret = nxsched_reprioritize(tcb, priority);
+  if (ret < 0)
+    {
+      serr("ERROR: nxsched_reprioritize failed: %d\n", ret);
+    }
+}
+
+/****************************************************************************
+ * Name: deadline_replenish_expire
+ *
+ * Description:
+ *   The throttled thread reached the start of its next period:  Refill the
+ *   budget and give it back its priority.
+ *
+ * Input Parameters:
+ *   arg - The TCB of the thread
+ *
+ * Assumptions:
+ *   Called from the watchdog timer handler with interrupts disabled.
+ *
+ ****************************************************************************/
+
+static void deadline_replenish_expire(wdparm_t arg)
+{
+  FAR struct tcb_s *tcb = (FAR struct tcb_s *)arg;
+  FAR struct deadline_s *dl = tcb->deadline;
+
+  DEBUGASSERT(dl != NULL && dl->throttled);
+
+  dl->throttled = false;
+  dl->budget    = dl->runtime;
+
+  deadline_set_priority(tcb, dl->priority);
+
+  /* Start to account the budget if the thread kept running */
+
+  if (tcb->task_state == TSTATE_TASK_RUNNING)
+    {
+      nxsched_resume_deadline(tcb);
+    }
+}
+
+/****************************************************************************
+ * Name: deadline_budget_expire
+ *
+ * Description:
+ *   The running thread used up its budget.  Following the constant
+ *   bandwidth server rules, its deadline is postponed by one period.  The
+ *   budget for that new deadline only becomes available at the old
+ *   deadline, until then the thread is throttled to the lowest priority.
+ *
+ * Input Parameters:
+ *   arg - The TCB of the thread
+ *
+ * Assumptions:
+ *   Called from the watchdog timer handler with interrupts disabled.
+ *
+ ****************************************************************************/
+
+static void deadline_budget_expire(wdparm_t arg)
+{
+  FAR struct tcb_s *tcb = (FAR struct tcb_s *)arg;
+  FAR struct deadline_s *dl = tcb->deadline;
+  clock_t now = clock_systime_ticks();
+  clock_t replenish;
+
+  DEBUGASSERT(dl != NULL && dl->running);
+
+  dl->running       = false;
+  dl->budget        = 0;
+  replenish         = dl->abs_deadline;
+  dl->abs_deadline += dl->period;
+
+  if ((sclock_t)(replenish - now) > 0)
+    {
+      dl->throttled = true;
+      wd_start_abstick(&dl->timer, replenish, deadline_replenish_expire,
+                       arg);
+      deadline_set_priority(tcb, SCHED_PRIORITY_MIN);
+      return;
+    }
+
+  /* The old deadline has already passed, so the budget is refilled at
+   * once.
+   */
+
+  dl->budget = dl->runtime;
+  if ((sclock_t)(dl->abs_deadline - now) <= 0)
+    {
+      dl->abs_deadline = now + dl->deadline;
+    }
+
+  /* Requeue the thread behind the threads with an earlier deadline */
+
+  nxsched_set_priority(tcb, tcb->sched_priority);
+  if (tcb->task_state == TSTATE_TASK_RUNNING)
+    {
+      nxsched_resume_deadline(tcb);
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_start_deadline
+ *
+ * Description:
+ *   Set up or update the deadline scheduling parameters of a thread.  This
+ *   is called from sched_setscheduler() and sched_setparam().  The new
+ *   parameters are accepted only if the sum of the bandwidths of all of the
+ *   deadline threads stays within CONFIG_SCHED_DEADLINE_MAX_BW.  The first
+ *   period starts now with a full budget.
+ *
+ *   All of the deadline threads run at CONFIG_SCHED_DEADLINE_PRIORITY and
+ *   the sched_priority of the parameters is ignored:  With a single band
+ *   no deadline thread can starve another one of a lower band, so the
+ *   global sum bounds the CPU time they take together.
+ *
+ * Input Parameters:
+ *   tcb   - The TCB of the thread
+ *   param - The new runtime, deadline and period
+ *
+ * Returned Value:
+ *   Returns zero (OK) on success or a negated errno value on failure:
+ *
+ *   EINVAL The runtime, deadline and period are not ordered that way.
+ *   EBUSY  The bandwidth of the thread does not fit.
+ *   ENOMEM The deadline data could not be allocated.
+ *
+ * Assumptions:
+ *   Interrupts are disabled.
+ *
+ ****************************************************************************/
+
+int nxsched_start_deadline(FAR struct tcb_s *tcb,
+                           FAR const struct sched_param *param)
+{
+  FAR struct deadline_s *dl = tcb->deadline;
+  sclock_t runtime;
+  sclock_t deadline;
+  sclock_t period;
+  uint32_t bandwidth;
+  uint32_t total;
+
+  /* Convert timespec values to system clock ticks */
+
+  runtime  = clock_time2ticks(&param->sched_dl_runtime);
+  deadline = clock_time2ticks(&param->sched_dl_deadline);
+  period   = clock_time2ticks(&param->sched_dl_period);
+
+  if (period == 0)
+    {
+      period = deadline;
+    }
+
+  if (runtime < 1 || runtime > deadline || deadline > period ||
+      period > UINT32_MAX)
+    {
+      return -EINVAL;
+    }
+
+  /* Admission control */
+
+  bandwidth = ((uint64_t)runtime << DEADLINE_BW_SHIFT) / period;
+  total     = g_deadline_bw + bandwidth;
+  if (dl != NULL)
+    {
+      total -= dl->bandwidth;
+    }
+
+  if (total > DEADLINE_BW_LIMIT)
+    {
+      return -EBUSY;
+    }
+
+  if (dl == NULL)
+    {
+      dl = kmm_zalloc(sizeof(struct deadline_s));
+      if (dl == NULL)
+        {
+          serr("ERROR: Failed to allocate deadline data structure\n");
+          return -ENOMEM;
+        }
+
+      dl->tcb       = tcb;
+      tcb->deadline = dl;
+    }
+  else
+    {
+      wd_cancel(&dl->timer);
+    }
+
+  g_deadline_bw    = total;
+
+  dl->running      = false;
+  dl->throttled    = false;
+  dl->priority     = CONFIG_SCHED_DEADLINE_PRIORITY;
+  dl->runtime      = runtime;
+  dl->deadline     = deadline;
+  dl->period       = period;
+  dl->budget       = runtime;
+  dl->bandwidth    = bandwidth;
+  dl->abs_deadline = clock_systime_ticks() + deadline;
+
+  if (tcb->task_state == TSTATE_TASK_RUNNING)
+    {
+      nxsched_resume_deadline(tcb);
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: nxsched_stop_deadline
+ *
+ * Description:
+ *   Release the bandwidth and the resources of a deadline thread.  This is
+ *   called when the thread exits or changes to another policy.  The thread
+ *   falls back to SCHED_FIFO, so that the context switches don't charge a
+ *   budget that is gone.
+ *
+ * Assumptions:
+ *   Interrupts are disabled.
+ *
+ ****************************************************************************/
+
+void nxsched_stop_deadline(FAR struct tcb_s *tcb)
+{
+  FAR struct deadline_s *dl = tcb->deadline;
+
+  DEBUGASSERT(dl != NULL);
+
+  wd_cancel(&dl->timer);
+  g_deadline_bw -= dl->bandwidth;
+
+  kmm_free(dl);
+  tcb->deadline = NULL;
+
+  tcb->flags &= ~TCB_FLAG_POLICY_MASK;
+  tcb->flags |= TCB_FLAG_SCHED_FIFO;
+}
+
+/****************************************************************************
+ * Name: nxsched_wakeup_deadline
+ *
+ * Description:
+ *   Called when a deadline thread leaves a blocked state.  The current
+ *   deadline is kept only if the budget left would not exceed the reserved
+ *   bandwidth until then:
+ *
+ *     budget / (abs_deadline - now) <= runtime / period
+ *
+ *   Otherwise a new period starts now with a full budget.
+ *
+ * Assumptions:
+ *   Interrupts are disabled.
+ *
+ ****************************************************************************/
+
+void nxsched_wakeup_deadline(FAR struct tcb_s *tcb)
+{
+  FAR struct deadline_s *dl = tcb->deadline;
+  clock_t now = clock_systime_ticks();
+  sclock_t left;
+
+  DEBUGASSERT(dl != NULL);
+
+  if (dl->throttled)
+    {
+      return;
+    }
+
+  left = (sclock_t)(dl->abs_deadline - now);
+  if (left <= 0 ||
+      (uint64_t)dl->budget * dl->period > (uint64_t)left * dl->runtime)
+    {
+      dl->abs_deadline = now + dl->deadline;
+      dl->budget       = dl->runtime;
+    }
+}
+
+/****************************************************************************
+ * Name: nxsched_resume_deadline
+ *
+ * Description:
+ *   Called when a deadline thread starts running:  Arm the timer that ends
+ *   the budget of the current period.
+ *
+ * Assumptions:
+ *   Interrupts are disabled.
+ *
+ ****************************************************************************/
+
+void nxsched_resume_deadline(FAR struct tcb_s *tcb)
+{
+  FAR struct deadline_s *dl = tcb->deadline;
+
+  DEBUGASSERT(dl != NULL);
+
+  if (dl->running || dl->throttled)
+    {
+      return;
+    }
+
+  dl->running   = true;
+  dl->eventtime = clock_systime_ticks();
+  wd_start(&dl->timer, dl->budget, deadline_budget_expire, (wdparm_t)tcb);
+}
+
+/****************************************************************************
+ * Name: nxsched_suspend_deadline
+ *
+ * Description:
+ *   Called when a deadline thread stops running:  Charge the time it ran to
+ *   its budget.
+ *
+ * Assumptions:
+ *   Interrupts are disabled.
+ *
+ ****************************************************************************/
+
+void nxsched_suspend_deadline(FAR struct tcb_s *tcb)
+{
+  FAR struct deadline_s *dl = tcb->deadline;
+  clock_t used;
+
+  DEBUGASSERT(dl != NULL);
+
+  if (!dl->running)
+    {
+      return;
+    }
+
+  wd_cancel(&dl->timer);
+
+  used        = clock_systime_ticks() - dl->eventtime;
+  dl->budget  = used < dl->budget ? dl->budget - used : 0;
+  dl->running = false;
+}
+
+#endif /* CONFIG_SCHED_DEADLINE */
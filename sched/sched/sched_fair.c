@@ -0,0 +1,205 @@
+/****************************************************************************
+ * sched/sched/sched_fair.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <limits.h>
+#include <sched.h>
+#include <assert.h>
+
+#include <nuttx/sched.h>
+#include <nuttx/clock.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_FAIR
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The virtual run time is counted in 1/65536 ticks of a nice 0 thread */
+
+#define FAIR_VRUNTIME_SHIFT   16
+#define FAIR_VRUNTIME_SCALE   ((uint32_t)FAIR_WEIGHT_NICE0 << FAIR_VRUNTIME_SHIFT)
+
+/* A waking thread may lag the others by half a time slice at most */
+
+#define FAIR_WAKEUP_LAG \
+  ((uint64_t)MSEC2TICK(CONFIG_RR_INTERVAL) << (FAIR_VRUNTIME_SHIFT - 1))
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* Weight of each nice value, from FAIR_NICE_MIN to FAIR_NICE_MAX */
+
+static const uint32_t g_fair_weight[FAIR_NICE_MAX - FAIR_NICE_MIN + 1] =
+{
+  88761, 71755, 56483, 46273, 36291,   /* -20 .. -16 */
+  29154, 23254, 18705, 14949, 11916,   /* -15 .. -11 */
+  9548,  7620,  6100,  4904,  3906,    /* -10 ..  -6 */
+  3121,  2501,  1991,  1586,  1277,    /*  -5 ..  -1 */
+  1024,  820,   655,   526,   423,     /*   0 ..   4 */
+  335,   272,   215,   172,   137,     /*   5 ..   9 */
+  110,   87,    70,    56,    45,      /*  10 ..  14 */
+  36,    29,    23,    18,    15       /*  15 ..  19 */
+};
+
+/* The smallest virtual run time of the fair threads that are ready to run.
+ * It only moves forward.
+ */
+
+static uint64_t g_fair_min_vruntime;
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_setup_fair
+ *
+ * Description:
+ *   Set the weight of a thread that uses or is going to use the fair share
+ *   policy.  A thread that joins the fair class starts at the minimum
+ *   virtual run time, so it neither owes nor is owed any CPU time.
+ *
+ * Input Parameters:
+ *   tcb      - The TCB of the thread
+ *   policy   - SCHED_BATCH or SCHED_IDLE
+ *   priority - NZERO - nice, as passed in sched_param
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Interrupts are disabled.
+ *
+ ****************************************************************************/
+
+void nxsched_setup_fair(FAR struct tcb_s *tcb, int policy, int priority)
+{
+  int nice = NZERO - priority;
+
+  if (nice < FAIR_NICE_MIN)
+    {
+      nice = FAIR_NICE_MIN;
+    }
+  else if (nice > FAIR_NICE_MAX)
+    {
+      nice = FAIR_NICE_MAX;
+    }
+
+  tcb->nice   = nice;
+  tcb->weight = policy == SCHED_IDLE ? FAIR_WEIGHT_IDLE :
+                g_fair_weight[nice - FAIR_NICE_MIN];
+
+  if ((tcb->flags & TCB_FLAG_POLICY_MASK) != TCB_FLAG_SCHED_FAIR)
+    {
+      tcb->vruntime = g_fair_min_vruntime;
+    }
+}
+
+/****************************************************************************
+ * Name: nxsched_wakeup_fair
+ *
+ * Description:
+ *   Called when a fair thread leaves a blocked state.  The time it slept
+ *   is not credited beyond FAIR_WAKEUP_LAG, otherwise it could monopolize
+ *   the CPU until it has caught up with the threads that kept running.
+ *
+ * Assumptions:
+ *   Interrupts are disabled.
+ *
+ ****************************************************************************/
+
+void nxsched_wakeup_fair(FAR struct tcb_s *tcb)
+{
+  uint64_t vruntime = g_fair_min_vruntime - FAIR_WAKEUP_LAG;
+
+  if ((int64_t)(tcb->vruntime - vruntime) < 0)
+    {
+      tcb->vruntime = vruntime;
+    }
+}
+
+/****************************************************************************
+ * Name:  nxsched_process_fair
+ *
+ * Description:
+ *   Charge the time the currently executing fair thread ran to its virtual
+ *   run time and check if it has exceeded its time slice.  Since the fair
+ *   threads are queued by virtual run time, requeuing the thread at the
+ *   end of its slice selects the thread that got the least CPU time so far.
+ *
+ * Input Parameters:
+ *   tcb - The TCB of the currently executing task
+ *   ticks - The number of ticks that have elapsed on the interval timer.
+ *   noswitches - True: Can't do context switches now.
+ *
+ * Returned Value:
+ *   The number if ticks remaining until the next time slice expires, see
+ *   nxsched_process_roundrobin().
+ *
+ * Assumptions:
+ *   - Interrupts are disabled
+ *   - The task associated with TCB uses the fair share scheduling policy
+ *
+ ****************************************************************************/
+
+clock_t nxsched_process_fair(FAR struct tcb_s *tcb, clock_t ticks,
+                             bool noswitches)
+{
+  FAR struct tcb_s *next = tcb->flink;
+  uint64_t vruntime;
+
+  DEBUGASSERT(tcb != NULL && tcb->weight != 0);
+
+  tcb->vruntime += (uint64_t)ticks * (FAIR_VRUNTIME_SCALE / tcb->weight);
+
+  /* Advance the minimum virtual run time.  In SMP mode the running thread
+   * is not in the ready-to-run list, then only its own time is known.
+   */
+
+  vruntime = tcb->vruntime;
+  if (next != NULL && next->sched_priority == tcb->sched_priority &&
+      (next->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_FAIR &&
+      (int64_t)(next->vruntime - vruntime) < 0)
+    {
+      vruntime = next->vruntime;
+    }
+
+  if ((int64_t)(vruntime - g_fair_min_vruntime) > 0)
+    {
+      g_fair_min_vruntime = vruntime;
+    }
+
+  return nxsched_process_roundrobin(tcb, ticks, noswitches);
+}
+
+#endif /* CONFIG_SCHED_FAIR */
@@ -27,6 +27,7 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <limits.h>
 #include <sched.h>
 #include <assert.h>
 #include <errno.h>
@@ -88,6 +89,15 @@ int nxsched_get_param(pid_t pid, FAR struct sched_param *param)
       /* Return the priority if the calling task. */
 
       param->sched_priority = (int)rtcb->sched_priority;
+
+#ifdef CONFIG_SCHED_FAIR
+      /* Fair threads report their nice value, like setpriority() takes it */
+
+      if ((rtcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_FAIR)
+        {
+          param->sched_priority = NZERO - rtcb->nice;
+        }
+#endif
     }
 
   /* This PID is not for the calling task, we will have to look it up */
@@ -112,6 +122,13 @@ int nxsched_get_param(pid_t pid, FAR struct sched_param *param)
 
           param->sched_priority = (int)tcb->sched_priority;
 
+#ifdef CONFIG_SCHED_FAIR
+          if ((tcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_FAIR)
+            {
+              param->sched_priority = NZERO - tcb->nice;
+            }
+#endif
+
 #ifdef CONFIG_SCHED_SPORADIC
           if ((tcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_SPORADIC)
             {
@@ -138,6 +155,31 @@ int nxsched_get_param(pid_t pid, FAR struct sched_param *param)
               param->sched_ss_init_budget.tv_nsec = 0;
             }
 #endif
+
+#ifdef CONFIG_SCHED_DEADLINE
+          if ((tcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE)
+            {
+              FAR struct deadline_s *dl = tcb->deadline;
+              DEBUGASSERT(dl != NULL);
+
+              /* Return parameters associated with SCHED_DEADLINE */
+
+              param->sched_priority = dl->priority;
+
+              clock_ticks2time(&param->sched_dl_runtime, dl->runtime);
+              clock_ticks2time(&param->sched_dl_deadline, dl->deadline);
+              clock_ticks2time(&param->sched_dl_period, dl->period);
+            }
+          else
+            {
+              param->sched_dl_runtime.tv_sec   = 0;
+              param->sched_dl_runtime.tv_nsec  = 0;
+              param->sched_dl_deadline.tv_sec  = 0;
+              param->sched_dl_deadline.tv_nsec = 0;
+              param->sched_dl_period.tv_sec    = 0;
+              param->sched_dl_period.tv_nsec   = 0;
+            }
+#endif
         }
 
       leave_critical_section(flags);
@@ -96,7 +96,9 @@ bool nxsched_merge_pending(void)
            */
 
           for (;
-               (rtcb && ptcb->sched_priority <= rtcb->sched_priority);
+               (rtcb && (ptcb->sched_priority < rtcb->sched_priority ||
+                         (ptcb->sched_priority == rtcb->sched_priority &&
+                          !nxsched_queue_before(ptcb, rtcb))));
                rtcb = rtcb->flink)
             {
             }
@@ -137,6 +139,14 @@ bool nxsched_merge_pending(void)
               ptcb->task_state  = TSTATE_TASK_READYTORUN;
             }
 
+#ifdef CONFIG_SCHED_PRIORITY_BITMAP
+          /* ptcb is the new tail of its level in the ready-to-run list,
+           * unless it went ahead of deadline threads of the same priority.
+           */
+
+          nxsched_prioindex_add(&g_readytorun_index, ptcb);
+#endif
+
           /* Set up for the next time through */
 
           rtcb = ptcb;
@@ -146,6 +156,9 @@ bool nxsched_merge_pending(void)
 
       list_pendingtasks()->head = NULL;
       list_pendingtasks()->tail = NULL;
+#ifdef CONFIG_SCHED_PRIORITY_BITMAP
+      nxsched_prioindex_reset(&g_pendingtasks_index);
+#endif
     }
 
   return ret;
@@ -86,10 +86,10 @@ void nxsched_process_delivered(int cpu)
        *    before this SMP call was executed
        * To avoid schedule latency/priority inversion, just check once more
        * if there is another CPU eglible to run the delivered task, and
-       * pass it forward.
+       * pass it forward.  A task bound to this CPU can't be passed.
        */
 
-      FAR struct tcb_s *tcb = (FAR struct tcb_s *)dq_peek(list_readytorun());
+      FAR struct tcb_s *tcb = nxsched_peek_runqueue(cpu);
       if (tcb)
         {
           int target_cpu = tcb->flags & TCB_FLAG_CPU_LOCKED ?
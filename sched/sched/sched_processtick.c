@@ -83,6 +83,19 @@ static inline void nxsched_cpu_scheduler(int cpu)
     }
 #endif
 
+#ifdef CONFIG_SCHED_FAIR
+  /* Check if the currently executing task uses fair share scheduling. */
+
+  if ((rtcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_FAIR)
+    {
+      /* Yes, charge the tick to its virtual run time and check if it has
+       * exceeded its timeslice.
+       */
+
+      nxsched_process_fair(rtcb, 1, false);
+    }
+#endif
+
 #ifdef CONFIG_SCHED_SPORADIC
   /* Check if the currently executing task uses sporadic scheduling. */
 
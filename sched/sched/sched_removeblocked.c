@@ -74,6 +74,24 @@ void nxsched_remove_blocked(FAR struct tcb_s *btcb)
 
   btcb->waitobj = NULL;
 
+#ifdef CONFIG_SCHED_DEADLINE
+  /* Start a new period if the old deadline can't be kept */
+
+  if ((btcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE)
+    {
+      nxsched_wakeup_deadline(btcb);
+    }
+#endif
+
+#ifdef CONFIG_SCHED_FAIR
+  /* Limit the credit a fair thread gets for the time it slept */
+
+  if ((btcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_FAIR)
+    {
+      nxsched_wakeup_fair(btcb);
+    }
+#endif
+
   /* Make sure the TCB's state corresponds to not being in
    * any list
    */
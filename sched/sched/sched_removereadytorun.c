@@ -93,7 +93,7 @@ bool nxsched_remove_readytorun(FAR struct tcb_s *rtcb)
    * is always the g_readytorun list.
    */
 
-  dq_rem((FAR dq_entry_t *)rtcb, tasklist);
+  nxsched_remove_prioritized(rtcb, tasklist);
 
   /* Since the TCB is not in any list, it is now invalid */
 
@@ -179,13 +179,9 @@ bool nxsched_remove_readytorun(FAR struct tcb_s *tcb)
     }
   else
     {
-      FAR dq_queue_t *tasklist;
-
-      tasklist = TLIST_HEAD(tcb, tcb->cpu);
-
       /* The task is not running.  Just remove its TCB from the task list */
 
-      dq_rem((FAR dq_entry_t *)tcb, tasklist);
+      nxsched_remove_runqueue(tcb);
 
       /* Since the TCB is no longer in any list, it is now invalid */
 
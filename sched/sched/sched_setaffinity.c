@@ -130,10 +130,12 @@ int nxsched_set_affinity(pid_t pid, size_t cpusetsize,
       tcb->task_state <= LAST_READY_TO_RUN_STATE)
     {
       /* Yes... is the CPU associated with the assigned task in the new
-       * affinity mask?
+       * affinity mask?  A task waiting in the ready-to-run list of its CPU
+       * is moved as well, it may no longer be bound to that CPU.
        */
 
-      if ((tcb->affinity & (1 << tcb->cpu)) == 0)
+      if ((tcb->affinity & (1 << tcb->cpu)) == 0 ||
+          (tcb->flags & TCB_FLAG_CPU_RUNQUEUE) != 0)
         {
           /* No.. then we will need to move the task from the assigned
            * task list to some other ready to run list.
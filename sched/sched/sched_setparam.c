@@ -80,6 +80,7 @@ int nxsched_set_param(pid_t pid, FAR const struct sched_param *param)
 {
   FAR struct tcb_s *rtcb;
   FAR struct tcb_s *tcb;
+  int priority;
   int ret;
 
   /* Verify that the requested priority is in the valid range */
@@ -205,9 +206,47 @@ int nxsched_set_param(pid_t pid, FAR const struct sched_param *param)
     }
 #endif
 
+  priority = param->sched_priority;
+
+#ifdef CONFIG_SCHED_DEADLINE
+  /* Update parameters associated with SCHED_DEADLINE, the thread stays in
+   * the deadline band.
+   */
+
+  if ((tcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE)
+    {
+      irqstate_t flags = enter_critical_section();
+      ret = nxsched_start_deadline(tcb, param);
+      leave_critical_section(flags);
+
+      if (ret < 0)
+        {
+          goto errout_with_lock;
+        }
+
+      priority = CONFIG_SCHED_DEADLINE_PRIORITY;
+    }
+#endif
+
+#ifdef CONFIG_SCHED_FAIR
+  /* Fair threads take the priority as their new nice value and stay in the
+   * fair share band.
+   */
+
+  if ((tcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_FAIR)
+    {
+      irqstate_t flags = enter_critical_section();
+      nxsched_setup_fair(tcb, tcb->weight == FAIR_WEIGHT_IDLE ?
+                         SCHED_IDLE : SCHED_BATCH, priority);
+      leave_critical_section(flags);
+
+      priority = CONFIG_SCHED_FAIR_PRIORITY;
+    }
+#endif
+
   /* Then perform the reprioritization */
 
-  ret = nxsched_reprioritize(tcb, param->sched_priority);
+  ret = nxsched_reprioritize(tcb, priority);
 
 errout_with_lock:
   sched_unlock();
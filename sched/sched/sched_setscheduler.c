@@ -82,6 +82,7 @@ int nxsched_set_scheduler(pid_t pid, int policy,
 {
   FAR struct tcb_s *tcb;
   irqstate_t flags;
+  int priority;
   int ret;
 
   /* Check for supported scheduling policy */
@@ -93,6 +94,13 @@ int nxsched_set_scheduler(pid_t pid, int policy,
 #endif
 #ifdef CONFIG_SCHED_SPORADIC
       && policy != SCHED_SPORADIC
+#endif
+#ifdef CONFIG_SCHED_DEADLINE
+      && policy != SCHED_DEADLINE
+#endif
+#ifdef CONFIG_SCHED_FAIR
+      && policy != SCHED_BATCH
+      && policy != SCHED_IDLE
 #endif
      )
     {
@@ -130,10 +138,45 @@ int nxsched_set_scheduler(pid_t pid, int policy,
    */
 
   sched_lock();
+  priority = param->sched_priority;
 
   /* Further, disable timer interrupts while we set up scheduling policy. */
 
   flags = enter_critical_section();
+
+#ifdef CONFIG_SCHED_DEADLINE
+  /* Reserve the bandwidth of a deadline thread first, or release it if the
+   * thread leaves SCHED_DEADLINE.  Deadline threads run in a single band.
+   */
+
+  if (policy == SCHED_DEADLINE)
+    {
+      ret = nxsched_start_deadline(tcb, param);
+      if (ret < 0)
+        {
+          goto errout_with_irq;
+        }
+
+      priority = CONFIG_SCHED_DEADLINE_PRIORITY;
+    }
+  else if ((tcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE)
+    {
+      nxsched_stop_deadline(tcb);
+    }
+#endif
+
+#ifdef CONFIG_SCHED_FAIR
+  /* The weight of a fair thread follows from the nice value that is passed
+   * as the priority.  The thread itself runs in the fair share band.
+   */
+
+  if (policy == SCHED_BATCH || policy == SCHED_IDLE)
+    {
+      nxsched_setup_fair(tcb, policy, param->sched_priority);
+      priority = CONFIG_SCHED_FAIR_PRIORITY;
+    }
+#endif
+
   tcb->flags &= ~TCB_FLAG_POLICY_MASK;
   switch (policy)
     {
@@ -269,17 +312,61 @@ int nxsched_set_scheduler(pid_t pid, int policy,
         }
         break;
 #endif
+
+#ifdef CONFIG_SCHED_FAIR
+      case SCHED_BATCH:
+      case SCHED_IDLE:
+        {
+#ifdef CONFIG_SCHED_SPORADIC
+          /* Cancel any on-going sporadic scheduling */
+
+          if (tcb->sporadic != NULL)
+            {
+              DEBUGVERIFY(nxsched_stop_sporadic(tcb));
+            }
+#endif
+
+          /* Save the fair share scheduling parameters */
+
+          tcb->flags     |= TCB_FLAG_SCHED_FAIR;
+          tcb->timeslice  = MSEC2TICK(CONFIG_RR_INTERVAL);
+        }
+        break;
+#endif
+
+#ifdef CONFIG_SCHED_DEADLINE
+      case SCHED_DEADLINE:
+        {
+#ifdef CONFIG_SCHED_SPORADIC
+          /* Cancel any on-going sporadic scheduling */
+
+          if (tcb->sporadic != NULL)
+            {
+              DEBUGVERIFY(nxsched_stop_sporadic(tcb));
+            }
+#endif
+
+          /* The budget is enforced by the deadline timer */
+
+          tcb->flags     |= TCB_FLAG_SCHED_DEADLINE;
+#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC)
+          tcb->timeslice  = 0;
+#endif
+        }
+        break;
+#endif
     }
 
+  nxsched_reset_timerslack(tcb);
   leave_critical_section(flags);
 
   /* Set the new priority */
 
-  ret = nxsched_reprioritize(tcb, param->sched_priority);
+  ret = nxsched_reprioritize(tcb, priority);
   sched_unlock();
   return ret;
 
-#ifdef CONFIG_SCHED_SPORADIC
+#if defined(CONFIG_SCHED_SPORADIC) || defined(CONFIG_SCHED_DEADLINE)
 errout_with_irq:
   leave_critical_section(flags);
   sched_unlock();
@@ -206,6 +206,19 @@ static clock_t nxsched_cpu_scheduler(int cpu, clock_t ticks,
     }
 #endif
 
+#ifdef CONFIG_SCHED_FAIR
+  /* Check if the currently executing task uses fair share scheduling. */
+
+  if ((rtcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_FAIR)
+    {
+      /* Yes, charge the elapsed time to its virtual run time and check if
+       * it has exceeded its timeslice.
+       */
+
+      ret = nxsched_process_fair(rtcb, elapsed, noswitches);
+    }
+#endif
+
 #ifdef CONFIG_SCHED_SPORADIC
   /* Check if the currently executing task uses sporadic scheduling. */
 
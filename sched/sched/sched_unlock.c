@@ -90,7 +90,7 @@ void sched_unlock(void)
            */
 
 #ifdef CONFIG_SMP
-          ptcb = (FAR struct tcb_s *)dq_peek(list_readytorun());
+          ptcb = nxsched_peek_runqueue(rtcb->cpu);
           if (ptcb && ptcb->sched_priority > rtcb->sched_priority &&
               nxsched_deliver_task(rtcb->cpu, rtcb->cpu, SWITCH_HIGHER))
 #else
@@ -102,15 +102,16 @@ void sched_unlock(void)
             }
 
 #if CONFIG_RR_INTERVAL > 0
-          /* If (1) the task that was running supported round-robin
-           * scheduling and (2) if its time slice has already expired, but
-           * (3) it could not slice out because pre-emption was disabled,
-           * then we need to swap the task out now and reassess the interval
-           * timer for the next time slice.
+          /* If (1) the task that was running supported round-robin or fair
+           * share scheduling and (2) if its time slice has already expired,
+           * but (3) it could not slice out because pre-emption was
+           * disabled, then we need to swap the task out now and reassess
+           * the interval timer for the next time slice.
            */
 
-          if ((rtcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_RR &&
-              rtcb->timeslice == 0)
+          if (((rtcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_RR ||
+               (rtcb->flags & TCB_FLAG_POLICY_MASK) ==
+               TCB_FLAG_SCHED_FAIR) && rtcb->timeslice == 0)
             {
               /* Yes.. that is the situation.  But one more thing.  The call
                * to nxsched_merge_pending() above may have actually replaced
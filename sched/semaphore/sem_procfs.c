@@ -0,0 +1,288 @@
+/****************************************************************************
+ * sched/semaphore/sem_procfs.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/stat.h>
+#include <stdio.h>
+#include <fcntl.h>
+#include <string.h>
+#include <assert.h>
+#include <debug.h>
+#include <errno.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+
+#include "semaphore/semaphore.h"
+
+#ifdef CONFIG_SEM_ADAPTIVE_SPIN_STATS
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Output format:
+ *
+ *        SPINS   ACQUIRED SUCCESS
+ *   DDDDDDDDDD DDDDDDDDDD    DDD%
+ */
+
+#define SEMSPIN_HDR_FMT "     SPINS   ACQUIRED SUCCESS\n"
+#define SEMSPIN_FMT     "%10u %10u    %3u%%\n"
+
+/* Determines the size of an intermediate buffer that must be large enough
+ * to handle the longest line generated by this logic (plus a couple of
+ * bytes).
+ */
+
+#define SEMSPIN_LINELEN 64
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct semspin_file_s
+{
+  struct procfs_file_s base;   /* Base open file structure */
+  char line[SEMSPIN_LINELEN];  /* Pre-allocated buffer for formatted lines */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int     semspin_open(FAR struct file *filep, FAR const char *relpath,
+                 int oflags, mode_t mode);
+static int     semspin_close(FAR struct file *filep);
+static ssize_t semspin_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+static int     semspin_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+static int     semspin_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* The statistics of the adaptive spinning */
+
+struct nxsem_spinstats_s g_nxsem_spinstats;
+
+/* See fs_mount.c -- this structure is explicitly extern'ed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations g_semspin_operations =
+{
+  semspin_open,   /* open */
+  semspin_close,  /* close */
+  semspin_read,   /* read */
+  NULL,           /* write */
+  NULL,           /* poll */
+
+  semspin_dup,    /* dup */
+
+  NULL,           /* opendir */
+  NULL,           /* closedir */
+  NULL,           /* readdir */
+  NULL,           /* rewinddir */
+
+  semspin_stat    /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: semspin_open
+ ****************************************************************************/
+
+static int semspin_open(FAR struct file *filep, FAR const char *relpath,
+                        int oflags, mode_t mode)
+{
+  FAR struct semspin_file_s *ssfile;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* This PROCFS file is read-only.  Any attempt to open with write access
+   * is not permitted.
+   */
+
+  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+    {
+      ferr("ERROR: Only O_RDONLY supported\n");
+      return -EACCES;
+    }
+
+  /* Allocate a container to hold the file attributes */
+
+  ssfile = kmm_zalloc(sizeof(struct semspin_file_s));
+  if (!ssfile)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)ssfile;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: semspin_close
+ ****************************************************************************/
+
+static int semspin_close(FAR struct file *filep)
+{
+  FAR struct semspin_file_s *ssfile;
+
+  /* Recover our private data from the struct file instance */
+
+  ssfile = (FAR struct semspin_file_s *)filep->f_priv;
+  DEBUGASSERT(ssfile);
+
+  /* Release the file attributes structure */
+
+  kmm_free(ssfile);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: semspin_read
+ ****************************************************************************/
+
+static ssize_t semspin_read(FAR struct file *filep, FAR char *buffer,
+                            size_t buflen)
+{
+  FAR struct semspin_file_s *ssfile;
+  unsigned int acquired;
+  unsigned int spins;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  off_t offset;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  /* Recover our private data from the struct file instance */
+
+  ssfile = (FAR struct semspin_file_s *)filep->f_priv;
+  DEBUGASSERT(ssfile);
+
+  offset = filep->f_pos;
+
+  linesize  = snprintf(ssfile->line, SEMSPIN_LINELEN, SEMSPIN_HDR_FMT);
+  copysize  = procfs_memcpy(ssfile->line, linesize, buffer, buflen,
+                            &offset);
+  totalsize = copysize;
+
+  if (totalsize < buflen)
+    {
+      acquired = atomic_read(&g_nxsem_spinstats.acquired);
+      spins    = atomic_read(&g_nxsem_spinstats.spins);
+
+      linesize = snprintf(ssfile->line, SEMSPIN_LINELEN, SEMSPIN_FMT,
+                          spins, acquired,
+                          spins != 0 ?
+                          (unsigned int)((uint64_t)acquired * 100 / spins) :
+                          0);
+      copysize = procfs_memcpy(ssfile->line, linesize, buffer + totalsize,
+                               buflen - totalsize, &offset);
+      totalsize += copysize;
+    }
+
+  /* Update the file position */
+
+  filep->f_pos += totalsize;
+  return totalsize;
+}
+
+/****************************************************************************
+ * Name: semspin_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int semspin_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct semspin_file_s *oldattr;
+  FAR struct semspin_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct semspin_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = kmm_malloc(sizeof(struct semspin_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct semspin_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: semspin_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int semspin_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "semspin" is the name for a read-only file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+  return OK;
+}
+
+#endif /* CONFIG_SEM_ADAPTIVE_SPIN_STATS */
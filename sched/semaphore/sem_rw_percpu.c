@@ -0,0 +1,334 @@
+/****************************************************************************
+ * sched/semaphore/sem_rw_percpu.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/arch.h>
+#include <nuttx/rwsem.h>
+#include <nuttx/sched.h>
+#include <assert.h>
+
+#ifdef CONFIG_SMP
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The writer state.  A writer first announces itself with
+ * PERCPU_RWSEM_LOCKED and then checks the reader counts.  If readers are
+ * still inside, it falls back to PERCPU_RWSEM_WAITING so that nested read
+ * locks of those readers can still be taken, and waits for them to leave.
+ */
+
+#define PERCPU_RWSEM_NONE     0  /* No writer */
+#define PERCPU_RWSEM_WAITING  1  /* A writer waits for readers to leave */
+#define PERCPU_RWSEM_LOCKED   2  /* A writer holds the lock */
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static inline void percpu_up_wait(FAR percpu_rw_semaphore_t *rwsem)
+{
+  int i;
+
+  for (i = 0; i < rwsem->waiter; i++)
+    {
+      /* If there are some waiter for unlock, then post the lock wait queue.
+       */
+
+      nxsem_post(&rwsem->waiting);
+    }
+}
+
+static inline void percpu_wait(FAR percpu_rw_semaphore_t *rwsem)
+{
+  rwsem->waiter++;
+  nxmutex_unlock(&rwsem->protected);
+  nxsem_wait(&rwsem->waiting);
+  nxmutex_lock(&rwsem->protected);
+  rwsem->waiter--;
+}
+
+static int percpu_readers(FAR percpu_rw_semaphore_t *rwsem)
+{
+  int readers = 0;
+  int cpu;
+
+  /* A reader may migrate between taking and releasing the lock, so only the
+   * sum of the counts is meaningful.
+   */
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      readers += atomic_read(&rwsem->readers[cpu].count);
+    }
+
+  return readers;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: percpu_down_read
+ *
+ * Description:
+ *   Acquire a read lock on a per-CPU read-write-lock object.
+ *
+ * Input Parameters:
+ *   rwsem  - Pointer to the per-CPU read-write-lock descriptor.
+ *
+ ****************************************************************************/
+
+void percpu_down_read(FAR percpu_rw_semaphore_t *rwsem)
+{
+  FAR atomic_t *count;
+
+  /* If the write lock is already held by oneself, this operation is
+   * converted to a write lock to avoid deadlock.
+   */
+
+  if (nxrmutex_is_hold(&rwsem->wlock))
+    {
+      nxrmutex_lock(&rwsem->wlock);
+      return;
+    }
+
+  for (; ; )
+    {
+      /* Announce the reader first, then check for a writer.  The writer
+       * does the opposite, so at least one of us sees the other.
+       */
+
+      count = &rwsem->readers[this_cpu()].count;
+      atomic_fetch_add(count, 1);
+      UP_DMB();
+
+      if (atomic_read(&rwsem->writer) != PERCPU_RWSEM_LOCKED)
+        {
+          return;
+        }
+
+      /* A writer got in first, back off and wait until it is done */
+
+      atomic_fetch_sub(count, 1);
+
+      nxmutex_lock(&rwsem->protected);
+      percpu_up_wait(rwsem);
+
+      while (atomic_read(&rwsem->writer) == PERCPU_RWSEM_LOCKED)
+        {
+          percpu_wait(rwsem);
+        }
+
+      nxmutex_unlock(&rwsem->protected);
+    }
+}
+
+/****************************************************************************
+ * Name: percpu_up_read
+ *
+ * Description:
+ *   Unlock a read lock on a per-CPU read-write-lock object.
+ *
+ * Input Parameters:
+ *   rwsem  - Pointer to the per-CPU read-write-lock descriptor.
+ *
+ ****************************************************************************/
+
+void percpu_up_read(FAR percpu_rw_semaphore_t *rwsem)
+{
+  /* When the holder is oneself, the read lock is a write lock that has
+   * been converted.
+   */
+
+  if (nxrmutex_is_hold(&rwsem->wlock))
+    {
+      nxrmutex_unlock(&rwsem->wlock);
+      return;
+    }
+
+  atomic_fetch_sub(&rwsem->readers[this_cpu()].count, 1);
+  UP_DMB();
+
+  /* Wake up the writer if it is waiting for the readers to leave */
+
+  if (atomic_read(&rwsem->writer) != PERCPU_RWSEM_NONE)
+    {
+      nxmutex_lock(&rwsem->protected);
+      percpu_up_wait(rwsem);
+      nxmutex_unlock(&rwsem->protected);
+    }
+}
+
+/****************************************************************************
+ * Name: percpu_down_write
+ *
+ * Description:
+ *   Acquire a write lock on a per-CPU read-write-lock object.
+ *
+ * Input Parameters:
+ *   rwsem  - Pointer to the per-CPU read-write-lock descriptor.
+ *
+ ****************************************************************************/
+
+void percpu_down_write(FAR percpu_rw_semaphore_t *rwsem)
+{
+  nxrmutex_lock(&rwsem->wlock);
+  if (nxrmutex_is_recursive(&rwsem->wlock))
+    {
+      return;
+    }
+
+  nxmutex_lock(&rwsem->protected);
+
+  for (; ; )
+    {
+      atomic_set(&rwsem->writer, PERCPU_RWSEM_LOCKED);
+      UP_DMB();
+
+      if (percpu_readers(rwsem) == 0)
+        {
+          break;
+        }
+
+      /* Readers are still inside, let the ones that backed off in again
+       * since they may be nested inside a read lock we are waiting for.
+       */
+
+      atomic_set(&rwsem->writer, PERCPU_RWSEM_WAITING);
+      percpu_up_wait(rwsem);
+      percpu_wait(rwsem);
+    }
+
+  nxmutex_unlock(&rwsem->protected);
+}
+
+/****************************************************************************
+ * Name: percpu_up_write
+ *
+ * Description:
+ *   Unlock a write lock on a per-CPU read-write-lock object.
+ *
+ * Input Parameters:
+ *   rwsem  - Pointer to the per-CPU read-write-lock descriptor.
+ *
+ ****************************************************************************/
+
+void percpu_up_write(FAR percpu_rw_semaphore_t *rwsem)
+{
+  DEBUGASSERT(nxrmutex_is_hold(&rwsem->wlock));
+
+  if (!nxrmutex_is_recursive(&rwsem->wlock))
+    {
+      nxmutex_lock(&rwsem->protected);
+      atomic_set(&rwsem->writer, PERCPU_RWSEM_NONE);
+      percpu_up_wait(rwsem);
+      nxmutex_unlock(&rwsem->protected);
+    }
+
+  nxrmutex_unlock(&rwsem->wlock);
+}
+
+/****************************************************************************
+ * Name: percpu_init_rwsem
+ *
+ * Description:
+ *   Initialize a per-CPU read-write-lock object.
+ *
+ * Input Parameters:
+ *   rwsem  - Pointer to the per-CPU read-write-lock descriptor.
+ *
+ * Returned Value:
+ *   It follows the NuttX internal error return policy: Zero (OK) is
+ *   returned on success. A negated errno value is returned on failure.
+ *
+ ****************************************************************************/
+
+int percpu_init_rwsem(FAR percpu_rw_semaphore_t *rwsem)
+{
+  int ret;
+  int cpu;
+
+  ret = nxrmutex_init(&rwsem->wlock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  ret = nxmutex_init(&rwsem->protected);
+  if (ret < 0)
+    {
+      goto errout_with_wlock;
+    }
+
+  ret = nxsem_init(&rwsem->waiting, 0, 0);
+  if (ret < 0)
+    {
+      goto errout_with_protected;
+    }
+
+  rwsem->waiter = 0;
+  atomic_set(&rwsem->writer, PERCPU_RWSEM_NONE);
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      atomic_set(&rwsem->readers[cpu].count, 0);
+    }
+
+  return OK;
+
+errout_with_protected:
+  nxmutex_destroy(&rwsem->protected);
+errout_with_wlock:
+  nxrmutex_destroy(&rwsem->wlock);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: percpu_destroy_rwsem
+ *
+ * Description:
+ *   Destroy a per-CPU read-write-lock object.
+ *
+ * Input Parameters:
+ *   rwsem - Pointer to the per-CPU read-write-lock descriptor.
+ *
+ ****************************************************************************/
+
+void percpu_destroy_rwsem(FAR percpu_rw_semaphore_t *rwsem)
+{
+  /* Need to check if there is still an unlocked or waiting state */
+
+  DEBUGASSERT(rwsem->waiter == 0 && percpu_readers(rwsem) == 0 &&
+              atomic_read(&rwsem->writer) == PERCPU_RWSEM_NONE);
+
+  nxrmutex_destroy(&rwsem->wlock);
+  nxmutex_destroy(&rwsem->protected);
+  nxsem_destroy(&rwsem->waiting);
+}
+
+#endif /* CONFIG_SMP */
@@ -38,6 +38,98 @@
 #include "sched/sched.h"
 #include "semaphore/semaphore.h"
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsem_spin
+ *
+ * Description:
+ *   Spin on a mutex while its holder is running on another CPU, in the
+ *   hope that the holder releases it before the caller would be able to
+ *   block and be woken up again.
+ *
+ * Input Parameters:
+ *   sem  - The mutex to acquire.
+ *   rtcb - The TCB of the calling thread.
+ *
+ * Returned Value:
+ *   true if the mutex was acquired, false if the caller has to take the
+ *   slow path.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SEM_ADAPTIVE_SPIN
+static bool nxsem_spin(FAR sem_t *sem, FAR struct tcb_s *rtcb)
+{
+  FAR atomic_t *mholder = NXSEM_MHOLDER(sem);
+  FAR struct tcb_s *htcb;
+  irqstate_t flags;
+  int32_t holder;
+  int32_t old;
+  bool running;
+  int spin;
+
+#ifdef CONFIG_PRIORITY_PROTECT
+  if ((sem->flags & SEM_PRIO_MASK) == SEM_PRIO_PROTECT)
+    {
+      return false;
+    }
+#endif
+
+  /* Never jump ahead of threads that are already blocked on the mutex */
+
+  holder = atomic_read(mholder);
+  if (!NXSEM_MACQUIRED(holder) || NXSEM_MBLOCKING(holder))
+    {
+      return false;
+    }
+
+  /* Spinning is only worthwhile if the holder is running on another CPU,
+   * otherwise it cannot release the mutex before we give up the CPU.
+   */
+
+  flags = enter_critical_section();
+  htcb = nxsched_get_tcb(holder);
+  running = htcb != NULL && htcb->task_state == TSTATE_TASK_RUNNING;
+  leave_critical_section(flags);
+
+  if (!running)
+    {
+      return false;
+    }
+
+#ifdef CONFIG_SEM_ADAPTIVE_SPIN_STATS
+  atomic_fetch_add(&g_nxsem_spinstats.spins, 1);
+#endif
+
+  for (spin = 0; spin < CONFIG_SEM_ADAPTIVE_SPIN_COUNT; spin++)
+    {
+      old = atomic_read(mholder);
+      if (old == NXSEM_NO_MHOLDER)
+        {
+          if (atomic_try_cmpxchg_acquire(mholder, &old, rtcb->pid))
+            {
+#ifdef CONFIG_SEM_ADAPTIVE_SPIN_STATS
+              atomic_fetch_add(&g_nxsem_spinstats.acquired, 1);
+#endif
+              return true;
+            }
+        }
+
+      /* Stop once the mutex is passed on or another thread blocks on it */
+
+      if (old != holder)
+        {
+          break;
+        }
+    }
+
+  return false;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -78,6 +170,13 @@ int nxsem_wait_slow(FAR sem_t *sem)
   FAR struct tcb_s *htcb = NULL;
   bool mutex = NXSEM_IS_MUTEX(sem);
 
+#ifdef CONFIG_SEM_ADAPTIVE_SPIN
+  if (mutex && nxsem_spin(sem, rtcb))
+    {
+      return OK;
+    }
+
+#endif
   /* The following operations must be performed with interrupts
    * disabled because nxsem_post() may be called from an interrupt
    * handler.
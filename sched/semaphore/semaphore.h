@@ -29,6 +29,7 @@
 
 #include <nuttx/config.h>
 #include <nuttx/compiler.h>
+#include <nuttx/atomic.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/sched.h>
 
@@ -39,6 +40,28 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+#ifdef CONFIG_SEM_ADAPTIVE_SPIN_STATS
+/* The statistics of the adaptive spinning on mutexes */
+
+struct nxsem_spinstats_s
+{
+  atomic_t spins;                  /* Number of times a waiter spun */
+  atomic_t acquired;               /* Number of spins that got the mutex */
+};
+#endif
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+#ifdef CONFIG_SEM_ADAPTIVE_SPIN_STATS
+extern struct nxsem_spinstats_s g_nxsem_spinstats;
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
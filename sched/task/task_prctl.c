@@ -27,7 +27,9 @@
 #include <nuttx/config.h>
 
 #include <sys/prctl.h>
+#include <stdint.h>
 #include <stdarg.h>
+#include <limits.h>
 #include <string.h>
 #include <errno.h>
 #include <debug.h>
@@ -52,6 +54,7 @@
  * Returned Value:
  *   The returned value may depend on the specific command.  For PR_SET_NAME
  *   and PR_GET_NAME, the returned value of 0 indicates successful operation.
+ *   PR_GET_TIMERSLACK returns the timer slack of the thread.
  *   On any failure, -1 is retruend and the errno value is set appropriately.
  *
  *     EINVAL The value of 'option' is not recognized.
@@ -148,17 +151,35 @@ int prctl(int option, ...)
         goto errout;
 #endif
 
+#ifdef CONFIG_SCHED_TIMER_SLACK
+      case PR_SET_TIMERSLACK:
+        {
+          unsigned long slack = va_arg(ap, unsigned long);
+
+          this_task()->timerslack = slack / NSEC_PER_TICK;
+        }
+        break;
+
+      case PR_GET_TIMERSLACK:
+        {
+          uint64_t slack = TICK2NSEC((uint64_t)this_task()->timerslack);
+
+          va_end(ap);
+          return slack > INT_MAX ? INT_MAX : (int)slack;
+        }
+#endif
+
       default:
         serr("ERROR: Unrecognized option: %d\n", option);
         errcode = EINVAL;
         goto errout;
     }
 
-  /* Not reachable unless CONFIG_TASK_NAME_SIZE is > 0.  NOTE: This might
-   * change if additional commands are supported.
+  /* Not reachable unless CONFIG_TASK_NAME_SIZE is > 0 or the timer slack
+   * is supported.
    */
 
-#if CONFIG_TASK_NAME_SIZE > 0
+#if CONFIG_TASK_NAME_SIZE > 0 || defined(CONFIG_SCHED_TIMER_SLACK)
   va_end(ap);
   return OK;
 #endif
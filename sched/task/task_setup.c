@@ -440,6 +440,8 @@ static int nxthread_setup_scheduler(FAR struct tcb_s *tcb, int priority,
       tcb->flags         |= TCB_FLAG_SCHED_FIFO;
 #endif
 
+      nxsched_reset_timerslack(tcb);
+
       /* Save the task ID of the parent task in the TCB and allocate
        * a child status structure.
        */
@@ -60,8 +60,8 @@
 
 int wd_cancel(FAR struct wdog_s *wdog)
 {
-  FAR struct wdog_s *first;
   irqstate_t         flags;
+  bool               head;
   int                  ret = -EINVAL;
 
   if (wdog != NULL)
@@ -76,24 +76,22 @@ int wd_cancel(FAR struct wdog_s *wdog)
 
       if (WDOG_ISACTIVE(wdog))
         {
-          first = list_first_entry(&g_wdactivelist, struct wdog_s, node);
-
           /* Now, remove the watchdog from the timer queue */
 
-          list_delete_fast(&wdog->node);
+          head = wd_remove(wdog);
 
           /* Mark the watchdog inactive */
 
           wdog->func = NULL;
 
-          if (first == wdog && !wd_in_callback())
+          if (head && !wd_in_callback())
             {
               /* If the watchdog is at the head of the timer queue, then
                * we will need to re-adjust the interval timer that will
                * generate the next interval event.
                */
 
-              if (!list_is_empty(&g_wdactivelist))
+              if (!wd_is_empty())
                 {
                   wd_timer_start(wd_next_expire());
                 }
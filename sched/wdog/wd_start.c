@@ -122,23 +122,11 @@ static inline_function void wd_expiration(clock_t ticks)
    * other watchdogs that became ready to run at this time
    */
 
-  while (!list_is_empty(&g_wdactivelist))
+  while ((wdog = wd_expired(ticks)) != NULL)
     {
-      wdog = list_first_entry(&g_wdactivelist, struct wdog_s, node);
-
-      /* Check if watchdog has expired;
-       * re-evaluate after updating current ticks if needed
-       */
-
-      if (!clock_compare(wdog->expired, ticks))
-        {
-          next_ticks = wdog->expired;
-          break;
-        }
-
       /* Remove the watchdog from the head of the list */
 
-      list_delete_fast(&wdog->node);
+      wd_remove(wdog);
 
       /* Indicate that the watchdog is no longer active. */
 
@@ -154,6 +142,13 @@ static inline_function void wd_expiration(clock_t ticks)
 
   wd_set_nested(false);
 
+#ifdef CONFIG_SCHED_TICKLESS
+  if (!wd_is_empty())
+    {
+      next_ticks = wd_next_expire();
+    }
+#endif
+
   if (next_ticks != ticks)
     {
       wd_timer_start(next_ticks);
@@ -167,7 +162,8 @@ static inline_function void wd_expiration(clock_t ticks)
  *
  * Description:
  *   Insert the timer into the global list to ensure that
- *   the list is sorted in increasing order of expiration absolute time.
+ *   the list is sorted in increasing order of expiration absolute time,
+ *   or into the timing wheel.
  *
  * Input Parameters:
  *   wdog     - Watchdog ID
@@ -187,6 +183,16 @@ static inline_function
 bool wd_insert(FAR struct wdog_s *wdog, clock_t expired,
                wdentry_t wdentry, wdparm_t arg)
 {
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+  wdog->func = wdentry;
+  up_getpicbase(&wdog->picbase);
+  wdog->arg = arg;
+  wdog->expired = expired;
+
+  /* Return whether the earliest expiration time has changed. */
+
+  return wd_add(wdog);
+#else
   FAR struct wdog_s *curr;
   FAR struct wdog_s *head;
 
@@ -221,6 +227,7 @@ bool wd_insert(FAR struct wdog_s *wdog, clock_t expired,
   /* Return whether the head of the watchdog list has changed. */
 
   return head == curr;
+#endif
 }
 
 /****************************************************************************
@@ -279,6 +286,17 @@ int wd_start_abstick(FAR struct wdog_s *wdog, clock_t ticks,
        * the critical section is established.
        */
 
+#ifdef CONFIG_SCHED_TIMER_SLACK
+      /* The timed waits of a thread may be coalesced with other timers
+       * within the slack of the thread.
+       */
+
+      if (!up_interrupt_context() && wdog == &this_task()->waitdog)
+        {
+          ticks = wd_slack_abstick(ticks, this_task()->timerslack);
+        }
+#endif
+
       flags = enter_critical_section();
 
       /* If the wdog is canceling, restarting the wdog is not allowed. */
@@ -290,8 +308,7 @@ int wd_start_abstick(FAR struct wdog_s *wdog, clock_t ticks,
 
       if (WDOG_ISACTIVE(wdog))
         {
-          reassess |= list_is_head(&g_wdactivelist, &wdog->node);
-          list_delete_fast(&wdog->node);
+          reassess |= wd_remove(wdog);
         }
 
       reassess |= wd_insert(wdog, ticks, wdentry, arg);
@@ -313,7 +330,7 @@ int wd_start_abstick(FAR struct wdog_s *wdog, clock_t ticks,
 
       if (WDOG_ISACTIVE(wdog))
         {
-          list_delete_fast(&wdog->node);
+          wd_remove(wdog);
         }
 
       wd_insert(wdog, ticks, wdentry, arg);
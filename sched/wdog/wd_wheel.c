@@ -0,0 +1,276 @@
+/****************************************************************************
+ * sched/wdog/wd_wheel.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <strings.h>
+
+#include <nuttx/list.h>
+#include <nuttx/wdog.h>
+
+#include "wdog/wdog.h"
+
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_wheel_distance
+ *
+ * Description:
+ *   Return the distance in slots from 'index' to the next slot in use,
+ *   from 1 up to WDOG_WHEEL_SIZE when only 'index' itself is in use.
+ *
+ ****************************************************************************/
+
+static inline_function int wd_wheel_distance(uint32_t map, int index)
+{
+  int shift = (index + 1) & WDOG_WHEEL_MASK;
+
+  if (shift != 0)
+    {
+      map = (map >> shift) | (map << (WDOG_WHEEL_SIZE - shift));
+    }
+
+  return ffs((int)map);
+}
+
+/****************************************************************************
+ * Name: wd_wheel_start
+ *
+ * Description:
+ *   Return the first tick after base where a slot of 'level' in use starts
+ *   its block.  For level 0 that is the expiration time of the timers of
+ *   the slot, for the upper levels the time the slot is cascaded, which is
+ *   no later than any of its timers expire.
+ *
+ ****************************************************************************/
+
+static inline_function clock_t wd_wheel_start(FAR struct wdog_wheel_s *wheel,
+                                              int level)
+{
+  int shift = WDOG_WHEEL_BITS * level;
+  clock_t start;
+
+  start = (wheel->base >> shift) +
+          wd_wheel_distance(wheel->map[level],
+                            (wheel->base >> shift) & WDOG_WHEEL_MASK);
+  return start << shift;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_cascade
+ *
+ * Description:
+ *   The wheel has just reached the start of a new block of one of the
+ *   upper levels:  Re-hash the timers of the slot of that block into the
+ *   lower levels.  The cached next expiration may be the start of that
+ *   block, so it has to be looked up again.
+ *
+ ****************************************************************************/
+
+static void wd_wheel_cascade(FAR struct wdog_wheel_s *wheel)
+{
+  FAR struct list_node *slot;
+  FAR struct wdog_s *wdog;
+  uint32_t bit;
+  int level;
+  int index;
+
+  for (level = 1; level < WDOG_WHEEL_LEVELS; level++)
+    {
+      index = (wheel->base >> (WDOG_WHEEL_BITS * level)) & WDOG_WHEEL_MASK;
+      slot  = &wheel->slot[level][index];
+      bit   = UINT32_C(1) << index;
+
+      if ((wheel->map[level] & bit) != 0)
+        {
+          /* The timers never go back to the slot being emptied, they
+           * expire within the block that starts now.
+           */
+
+          while (!list_is_empty(slot))
+            {
+              wdog = list_first_entry(slot, struct wdog_s, node);
+              list_delete_fast(&wdog->node);
+              wd_wheel_link(wheel, wdog);
+            }
+
+          wheel->map[level] &= ~bit;
+          wheel->nextvalid   = false;
+        }
+
+      /* Only continue if this is also the start of an upper block */
+
+      if (index != 0)
+        {
+          break;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: wd_wheel_skip
+ *
+ * Description:
+ *   The current level 0 slot is empty:  Move the wheel to the next tick
+ *   where there is something to do, but not beyond ticks + 1.  That is
+ *   either a level 0 slot in use or the start of the block of an upper
+ *   level slot in use.  The blocks of the empty slots in between need no
+ *   cascading.
+ *
+ ****************************************************************************/
+
+static void wd_wheel_skip(FAR struct wdog_wheel_s *wheel, clock_t ticks)
+{
+  clock_t target = ticks + 1;
+  clock_t start;
+  int level;
+
+  for (level = 0; level < WDOG_WHEEL_LEVELS; level++)
+    {
+      if (wheel->map[level] == 0)
+        {
+          continue;
+        }
+
+      start = wd_wheel_start(wheel, level);
+      if ((sclock_t)(start - target) < 0)
+        {
+          target = start;
+        }
+    }
+
+  wheel->base = target;
+  if ((target & WDOG_WHEEL_MASK) == 0)
+    {
+      wd_wheel_cascade(wheel);
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_wheel_next
+ *
+ * Description:
+ *   Return the next tick the wheel has to be turned at, no later than the
+ *   earliest expiration time of the active watchdog timers.  In level 0 it
+ *   is the expiration time of the first slot in use from base on.  In the
+ *   upper levels the timers of a slot are not sorted, so the start of the
+ *   block of the first slot in use is taken instead:  Its timers are then
+ *   cascaded and the lookup is repeated.  Either way it only takes a look
+ *   at the slot bitmaps, one per level.
+ *
+ * Assumptions:
+ *   The wheel is not empty and interrupts are disabled.
+ *
+ ****************************************************************************/
+
+clock_t wd_wheel_next(void)
+{
+  FAR struct wdog_wheel_s *wheel = &g_wdwheel;
+  bool found = false;
+  clock_t next = 0;
+  clock_t start;
+  int level;
+  int index;
+
+  if (wheel->nextvalid)
+    {
+      return wheel->next;
+    }
+
+  if (wheel->map[0] != 0)
+    {
+      index = wheel->base & WDOG_WHEEL_MASK;
+      next  = wheel->base +
+              wd_wheel_distance(wheel->map[0],
+                                (index - 1) & WDOG_WHEEL_MASK) - 1;
+      found = true;
+    }
+
+  for (level = 1; level < WDOG_WHEEL_LEVELS; level++)
+    {
+      if (wheel->map[level] == 0)
+        {
+          continue;
+        }
+
+      start = wd_wheel_start(wheel, level);
+      if (!found || (sclock_t)(start - next) < 0)
+        {
+          next  = start;
+          found = true;
+        }
+    }
+
+  wheel->next      = next;
+  wheel->nextvalid = true;
+  return next;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_expired
+ *
+ * Description:
+ *   Turn the wheel up to 'ticks' and return the next timer that expired by
+ *   then, or NULL if there is none.  The timer is left in the wheel.
+ *
+ * Assumptions:
+ *   Interrupts are disabled.
+ *
+ ****************************************************************************/
+
+FAR struct wdog_s *wd_wheel_expired(clock_t ticks)
+{
+  FAR struct wdog_wheel_s *wheel = &g_wdwheel;
+  int index;
+
+  while (wheel->count > 0 && clock_compare(wheel->base, ticks))
+    {
+      /* All of the timers in the current level 0 slot have expired */
+
+      index = wheel->base & WDOG_WHEEL_MASK;
+      if ((wheel->map[0] & (UINT32_C(1) << index)) != 0)
+        {
+          return list_first_entry(&wheel->slot[0][index],
+                                  struct wdog_s, node);
+        }
+
+      wd_wheel_skip(wheel, ticks);
+    }
+
+  return NULL;
+}
+
+#endif /* CONFIG_WDOG_TIMER_WHEEL */
@@ -42,6 +42,41 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+/* Geometry of the timing wheel */
+
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+#  define WDOG_WHEEL_BITS    5
+#  define WDOG_WHEEL_SIZE    (1 << WDOG_WHEEL_BITS)
+#  define WDOG_WHEEL_MASK    (WDOG_WHEEL_SIZE - 1)
+#  define WDOG_WHEEL_LEVELS  CONFIG_WDOG_TIMER_WHEEL_LEVELS
+#  define WDOG_WHEEL_RANGE   ((clock_t)1 << (WDOG_WHEEL_BITS * WDOG_WHEEL_LEVELS))
+#endif
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+
+/* The timing wheel.  A timer that expires d ticks after base is kept in
+ * the level where 32^level <= d < 32^(level + 1), in the slot selected by
+ * the bits of its expiration time for that level.  The bits of map tell
+ * which slots are in use, the list heads of the free slots are not
+ * initialized.
+ */
+
+struct wdog_wheel_s
+{
+  struct list_node slot[WDOG_WHEEL_LEVELS][WDOG_WHEEL_SIZE];
+  uint32_t         map[WDOG_WHEEL_LEVELS];
+  clock_t          base;      /* Next tick to be processed */
+  clock_t          next;      /* Cached next tick to turn the wheel at */
+  bool             nextvalid; /* next is up to date */
+  unsigned int     count;     /* Number of active timers */
+};
+
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -54,12 +89,18 @@ extern "C"
 #define EXTERN extern
 #endif
 
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+/* The g_wdwheel holds the active watchdog timers */
+
+extern struct wdog_wheel_s g_wdwheel;
+#else
 /* The g_wdactivelist data structure is a singly linked list ordered by
  * watchdog expiration time. When watchdog timers expire,the functions on
  * this linked list are removed and the function is called.
  */
 
 extern struct list_node g_wdactivelist;
+#endif
 
 #ifdef CONFIG_SCHED_TICKLESS
 extern bool g_wdtimernested;
@@ -134,21 +175,194 @@ static inline_function void wd_timer_cancel(void)
 #  define wd_timer_cancel()
 #endif
 
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+#  define wd_is_empty()      (g_wdwheel.count == 0)
+#  define wd_next_expire()   wd_wheel_next()
+#  define wd_expired(ticks)  wd_wheel_expired(ticks)
+
+/* Hash the timer into the wheel slot of its expiration time */
+
+static inline_function void wd_wheel_link(FAR struct wdog_wheel_s *wheel,
+                                          FAR struct wdog_s *wdog)
+{
+  FAR struct list_node *slot;
+  clock_t expired = wdog->expired;
+  clock_t delta   = expired - wheel->base;
+  int     level   = 0;
+  int     index;
+
+  if ((sclock_t)delta < 0)
+    {
+      /* Already expired, run it with the next tick processed */
+
+      expired = wheel->base;
+      delta   = 0;
+    }
+  else if (delta >= WDOG_WHEEL_RANGE)
+    {
+      /* Beyond the wheel, park it in the top level */
+
+      delta   = WDOG_WHEEL_RANGE - 1;
+      expired = wheel->base + delta;
+    }
+
+  while (delta >= ((clock_t)1 << (WDOG_WHEEL_BITS * (level + 1))))
+    {
+      level++;
+    }
+
+  index = (expired >> (WDOG_WHEEL_BITS * level)) & WDOG_WHEEL_MASK;
+  slot  = &wheel->slot[level][index];
+
+  if ((wheel->map[level] & (UINT32_C(1) << index)) == 0)
+    {
+      list_initialize(slot);
+      wheel->map[level] |= UINT32_C(1) << index;
+    }
+
+  list_add_tail(slot, &wdog->node);
+  wdog->slot = (level << WDOG_WHEEL_BITS) | index;
+}
+
+/* Unhash the timer from its wheel slot */
+
+static inline_function void wd_wheel_unlink(FAR struct wdog_wheel_s *wheel,
+                                            FAR struct wdog_s *wdog)
+{
+  int level = wdog->slot >> WDOG_WHEEL_BITS;
+  int index = wdog->slot & WDOG_WHEEL_MASK;
+
+  list_delete_fast(&wdog->node);
+  if (list_is_empty(&wheel->slot[level][index]))
+    {
+      wheel->map[level] &= ~(UINT32_C(1) << index);
+    }
+}
+
+/* Add an active timer, return true if it is the new earliest timer */
+
+static inline_function bool wd_add(FAR struct wdog_s *wdog)
+{
+  FAR struct wdog_wheel_s *wheel = &g_wdwheel;
+
+  if (wheel->count++ == 0)
+    {
+      /* Resynchronize the idle wheel with the system time */
+
+      wheel->base      = clock_systime_ticks();
+      wheel->next      = wdog->expired;
+      wheel->nextvalid = true;
+      wd_wheel_link(wheel, wdog);
+      return true;
+    }
+
+  wd_wheel_link(wheel, wdog);
+
+  if (!wheel->nextvalid)
+    {
+      return true;
+    }
+
+  if ((sclock_t)(wdog->expired - wheel->next) < 0)
+    {
+      wheel->next = wdog->expired;
+      return true;
+    }
+
+  return false;
+}
+
+/* Remove an active timer, return true if it may have been the earliest */
+
+static inline_function bool wd_remove(FAR struct wdog_s *wdog)
+{
+  FAR struct wdog_wheel_s *wheel = &g_wdwheel;
+
+  wd_wheel_unlink(wheel, wdog);
+  wheel->count--;
+
+  if (wheel->nextvalid && !clock_compare(wdog->expired, wheel->next))
+    {
+      return false;
+    }
+
+  wheel->nextvalid = false;
+  return true;
+}
+#else
+#  define wd_is_empty() list_is_empty(&g_wdactivelist)
+
 static inline_function clock_t wd_next_expire(void)
 {
   return list_first_entry(&g_wdactivelist, struct wdog_s, node)->expired;
 }
 
+/* Return the head of the list if it has expired by 'ticks' */
+
+static inline_function FAR struct wdog_s *wd_expired(clock_t ticks)
+{
+  FAR struct wdog_s *wdog;
+
+  if (list_is_empty(&g_wdactivelist))
+    {
+      return NULL;
+    }
+
+  wdog = list_first_entry(&g_wdactivelist, struct wdog_s, node);
+  return clock_compare(wdog->expired, ticks) ? wdog : NULL;
+}
+
+/* Remove an active timer, return true if it was the earliest */
+
+static inline_function bool wd_remove(FAR struct wdog_s *wdog)
+{
+  bool head = list_is_head(&g_wdactivelist, &wdog->node);
+
+  list_delete_fast(&wdog->node);
+  return head;
+}
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
 
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+/****************************************************************************
+ * Name: wd_wheel_next
+ *
+ * Description:
+ *   Return the next tick the wheel has to be turned at, which is no later
+ *   than the earliest expiration time of the active watchdog timers.
+ *
+ * Assumptions:
+ *   The wheel is not empty and interrupts are disabled.
+ *
+ ****************************************************************************/
+
+clock_t wd_wheel_next(void);
+
+/****************************************************************************
+ * Name: wd_wheel_expired
+ *
+ * Description:
+ *   Turn the wheel up to 'ticks' and return the next timer that expired by
+ *   then, or NULL if there is none.  The timer is left in the wheel.
+ *
+ * Assumptions:
+ *   Interrupts are disabled.
+ *
+ ****************************************************************************/
+
+FAR struct wdog_s *wd_wheel_expired(clock_t ticks);
+#endif
+
 static inline_function clock_t wd_get_next_expire(clock_t curr)
 {
   clock_t     next = curr;
   irqstate_t flags = enter_critical_section();
 
-  if (!list_is_empty(&g_wdactivelist))
+  if (!wd_is_empty())
     {
       next = wd_next_expire();
     }
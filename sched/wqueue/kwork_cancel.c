@@ -84,7 +84,7 @@ static int work_qcancel(FAR struct kwork_wqueue_s *wqueue, bool sync,
 
       /* Wait until the worker thread finished the work. */
 
-      for (wndx = 0; wndx < wqueue->nthreads; wndx++)
+      for (wndx = 0; wndx < WORK_NWORKERS(wqueue->nthreads); wndx++)
         {
           if (worker[wndx].work == work && worker[wndx].pid != pid)
             {
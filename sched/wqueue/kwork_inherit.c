@@ -66,7 +66,12 @@ static void lpwork_boostworker(pid_t wpid, uint8_t reqprio)
   /* Get the TCB of the low priority worker thread from the process ID. */
 
   wtcb = nxsched_get_tcb(wpid);
-  DEBUGASSERT(wtcb);
+  if (wtcb == NULL)
+    {
+      /* An extra worker that has just exited */
+
+      return;
+    }
 
   /* REVISIT: Priority multi-boost is not supported */
 
@@ -132,7 +137,12 @@ static void lpwork_restoreworker(pid_t wpid, uint8_t reqprio)
   /* Get the TCB of the low priority worker thread from the process ID. */
 
   wtcb = nxsched_get_tcb(wpid);
-  DEBUGASSERT(wtcb);
+  if (wtcb == NULL)
+    {
+      /* An extra worker that has just exited */
+
+      return;
+    }
 
   /* REVISIT: Priority multi-boost is not supported. */
 
@@ -224,9 +234,14 @@ void lpwork_boostpriority(uint8_t reqprio)
 
   /* Adjust the priority of every worker thread */
 
-  for (wndx = 0; wndx < CONFIG_SCHED_LPNTHREADS; wndx++)
+  for (wndx = 0; wndx < WORK_NWORKERS(CONFIG_SCHED_LPNTHREADS); wndx++)
     {
-      lpwork_boostworker(g_lpwork.worker[wndx].pid, reqprio);
+      /* Skip the free slots of the extra workers */
+
+      if (g_lpwork.worker[wndx].pid > 0)
+        {
+          lpwork_boostworker(g_lpwork.worker[wndx].pid, reqprio);
+        }
     }
 
   leave_critical_section(flags);
@@ -268,9 +283,12 @@ void lpwork_restorepriority(uint8_t reqprio)
 
   /* Adjust the priority of every worker thread */
 
-  for (wndx = 0; wndx < CONFIG_SCHED_LPNTHREADS; wndx++)
+  for (wndx = 0; wndx < WORK_NWORKERS(CONFIG_SCHED_LPNTHREADS); wndx++)
     {
-      lpwork_restoreworker(g_lpwork.worker[wndx].pid, reqprio);
+      if (g_lpwork.worker[wndx].pid > 0)
+        {
+          lpwork_restoreworker(g_lpwork.worker[wndx].pid, reqprio);
+        }
     }
 
   leave_critical_section(flags);
@@ -0,0 +1,481 @@
+/****************************************************************************
+ * sched/wqueue/kwork_procfs.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/stat.h>
+#include <stdio.h>
+#include <fcntl.h>
+#include <string.h>
+#include <assert.h>
+#include <debug.h>
+#include <errno.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/clock.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+
+#include "wqueue/wqueue.h"
+
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Output format:
+ *
+ *   QUEUE    WORKERS    READY  DELAYED
+ *   SSSSSSSS DDDDDDD DDDDDDDD DDDDDDDD
+ *
+ *   FUNCTION      COUNT  LAT_AVG  LAT_MAX  RUN_AVG  RUN_MAX
+ *   XXXXXXXX DDDDDDDDDD DDDDDDDD DDDDDDDD DDDDDDDD DDDDDDDD
+ *
+ * Latencies are measured from the due time of the work to the start of
+ * the work function, run times are the time spent in the work function.
+ * Both are in microseconds.
+ */
+
+#define QUEUE_HDR_FMT "QUEUE    WORKERS    READY  DELAYED\n"
+#define QUEUE_FMT     "%-8s %7u %8u %8u\n"
+#define FUNC_HDR_FMT  "\nFUNCTION      COUNT  LAT_AVG  LAT_MAX  RUN_AVG  RUN_MAX\n"
+#define FUNC_FMT      "%08lx %10lu %8lu %8lu %8lu %8lu\n"
+
+/* Determines the size of an intermediate buffer that must be large enough
+ * to handle the longest line generated by this logic (plus a couple of
+ * bytes).
+ */
+
+#define WQUEUE_LINELEN 64
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct wqueue_file_s
+{
+  struct procfs_file_s base;  /* Base open file structure */
+  FAR char *buffer;           /* User provided buffer */
+  size_t remaining;           /* Number of available characters in buffer */
+  size_t ncopied;             /* Number of characters in buffer */
+  off_t offset;               /* Current file offset */
+  char line[WQUEUE_LINELEN];  /* Pre-allocated buffer for formatted lines */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int     wqueue_open(FAR struct file *filep, FAR const char *relpath,
+                 int oflags, mode_t mode);
+static int     wqueue_close(FAR struct file *filep);
+static ssize_t wqueue_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+static int     wqueue_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+static int     wqueue_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* The statistics of the work functions */
+
+struct work_stats_s g_work_stats[CONFIG_SCHED_WORKQUEUE_STATS_NFUNCS];
+spinlock_t g_work_stats_lock = SP_UNLOCKED;
+
+/* See fs_mount.c -- this structure is explicitly extern'ed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations g_wqueue_operations =
+{
+  wqueue_open,    /* open */
+  wqueue_close,   /* close */
+  wqueue_read,    /* read */
+  NULL,           /* write */
+  NULL,           /* poll */
+
+  wqueue_dup,     /* dup */
+
+  NULL,           /* opendir */
+  NULL,           /* closedir */
+  NULL,           /* readdir */
+  NULL,           /* rewinddir */
+
+  wqueue_stat     /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wqueue_output
+ *
+ * Description:
+ *   Copy the formatted line to the user buffer.
+ *
+ * Returned Value:
+ *   true if the user buffer is full.
+ *
+ ****************************************************************************/
+
+static bool wqueue_output(FAR struct wqueue_file_s *wqfile, size_t linesize)
+{
+  size_t copysize;
+
+  copysize = procfs_memcpy(wqfile->line, linesize, wqfile->buffer,
+                           wqfile->remaining, &wqfile->offset);
+
+  wqfile->ncopied   += copysize;
+  wqfile->buffer    += copysize;
+  wqfile->remaining -= copysize;
+
+  return wqfile->remaining == 0;
+}
+
+/****************************************************************************
+ * Name: wqueue_queue
+ *
+ * Description:
+ *   Output the number of workers and the depth of one work queue.
+ *
+ ****************************************************************************/
+
+static bool wqueue_queue(FAR struct wqueue_file_s *wqfile,
+                         FAR const char *name,
+                         FAR struct kwork_wqueue_s *wqueue)
+{
+  FAR struct list_node *node;
+  unsigned int nworkers;
+  unsigned int nready = 0;
+  unsigned int ndelayed = 0;
+  irqstate_t flags;
+  size_t linesize;
+
+  flags = spin_lock_irqsave(&wqueue->lock);
+
+  nworkers = wqueue->nthreads;
+#if CONFIG_SCHED_WORKQUEUE_DYNAMIC > 0
+  nworkers += wqueue->ndynamic;
+#endif
+
+  list_for_every(&wqueue->expired, node)
+    {
+      nready++;
+    }
+
+  list_for_every(&wqueue->pending, node)
+    {
+      ndelayed++;
+    }
+
+  spin_unlock_irqrestore(&wqueue->lock, flags);
+
+  linesize = snprintf(wqfile->line, WQUEUE_LINELEN, QUEUE_FMT,
+                      name, nworkers, nready, ndelayed);
+  return wqueue_output(wqfile, linesize);
+}
+
+/****************************************************************************
+ * Name: wqueue_open
+ ****************************************************************************/
+
+static int wqueue_open(FAR struct file *filep, FAR const char *relpath,
+                       int oflags, mode_t mode)
+{
+  FAR struct wqueue_file_s *wqfile;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* This PROCFS file is read-only.  Any attempt to open with write access
+   * is not permitted.
+   */
+
+  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+    {
+      ferr("ERROR: Only O_RDONLY supported\n");
+      return -EACCES;
+    }
+
+  /* Allocate a container to hold the file attributes */
+
+  wqfile = kmm_zalloc(sizeof(struct wqueue_file_s));
+  if (!wqfile)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)wqfile;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: wqueue_close
+ ****************************************************************************/
+
+static int wqueue_close(FAR struct file *filep)
+{
+  FAR struct wqueue_file_s *wqfile;
+
+  /* Recover our private data from the struct file instance */
+
+  wqfile = (FAR struct wqueue_file_s *)filep->f_priv;
+  DEBUGASSERT(wqfile);
+
+  /* Release the file attributes structure */
+
+  kmm_free(wqfile);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: wqueue_read
+ ****************************************************************************/
+
+static ssize_t wqueue_read(FAR struct file *filep, FAR char *buffer,
+                           size_t buflen)
+{
+  FAR struct wqueue_file_s *wqfile;
+  struct work_stats_s stats;
+  struct timespec runavg;
+  struct timespec runmax;
+  irqstate_t flags;
+  size_t linesize;
+  int i;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  /* Recover our private data from the struct file instance */
+
+  wqfile = (FAR struct wqueue_file_s *)filep->f_priv;
+  DEBUGASSERT(wqfile);
+
+  /* Save the file offset and the user buffer information */
+
+  wqfile->offset    = filep->f_pos;
+  wqfile->buffer    = buffer;
+  wqfile->remaining = buflen;
+  wqfile->ncopied   = 0;
+
+  /* The depth of the kernel work queues comes first */
+
+  linesize = snprintf(wqfile->line, WQUEUE_LINELEN, QUEUE_HDR_FMT);
+  if (wqueue_output(wqfile, linesize))
+    {
+      goto out;
+    }
+
+#ifdef CONFIG_SCHED_HPWORK
+  if (wqueue_queue(wqfile, HPWORKNAME, work_qid2wq(HPWORK)))
+    {
+      goto out;
+    }
+#endif
+
+#ifdef CONFIG_SCHED_LPWORK
+  if (wqueue_queue(wqfile, LPWORKNAME, work_qid2wq(LPWORK)))
+    {
+      goto out;
+    }
+#endif
+
+  /* Then the statistics of each work function */
+
+  linesize = snprintf(wqfile->line, WQUEUE_LINELEN, FUNC_HDR_FMT);
+  if (wqueue_output(wqfile, linesize))
+    {
+      goto out;
+    }
+
+  for (i = 0; i < CONFIG_SCHED_WORKQUEUE_STATS_NFUNCS; i++)
+    {
+      flags = spin_lock_irqsave(&g_work_stats_lock);
+      memcpy(&stats, &g_work_stats[i], sizeof(stats));
+      spin_unlock_irqrestore(&g_work_stats_lock, flags);
+
+      if (stats.worker == NULL || stats.count == 0)
+        {
+          continue;
+        }
+
+      perf_convert(stats.runtime / stats.count, &runavg);
+      perf_convert(stats.runtime_max, &runmax);
+
+      linesize = snprintf(wqfile->line, WQUEUE_LINELEN, FUNC_FMT,
+                          (unsigned long)(uintptr_t)stats.worker,
+                          (unsigned long)stats.count,
+                          (unsigned long)TICK2USEC(stats.latency /
+                                                   stats.count),
+                          (unsigned long)TICK2USEC(stats.latency_max),
+                          (unsigned long)(runavg.tv_sec * USEC_PER_SEC +
+                                          runavg.tv_nsec / NSEC_PER_USEC),
+                          (unsigned long)(runmax.tv_sec * USEC_PER_SEC +
+                                          runmax.tv_nsec / NSEC_PER_USEC));
+      if (wqueue_output(wqfile, linesize))
+        {
+          break;
+        }
+    }
+
+out:
+
+  /* Update the file position */
+
+  filep->f_pos += wqfile->ncopied;
+  return wqfile->ncopied;
+}
+
+/****************************************************************************
+ * Name: wqueue_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int wqueue_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct wqueue_file_s *oldattr;
+  FAR struct wqueue_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct wqueue_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = kmm_malloc(sizeof(struct wqueue_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct wqueue_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: wqueue_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int wqueue_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "wqueue" is the name for a read-only file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: work_stats_update
+ *
+ * Description:
+ *   Account one run of a work function.  The entry of the function is
+ *   found by open addressing on the function address; functions that do
+ *   not fit in the table any more are not recorded.
+ *
+ * Input Parameters:
+ *   worker  - The work function
+ *   latency - Ticks from the due time of the work until it started
+ *   runtime - Perf counts the work function ran
+ *
+ ****************************************************************************/
+
+void work_stats_update(worker_t worker, clock_t latency, clock_t runtime)
+{
+  FAR struct work_stats_s *stats;
+  irqstate_t flags;
+  int index;
+  int i;
+
+  index = ((uintptr_t)worker >> 2) % CONFIG_SCHED_WORKQUEUE_STATS_NFUNCS;
+
+  flags = spin_lock_irqsave(&g_work_stats_lock);
+
+  for (i = 0; i < CONFIG_SCHED_WORKQUEUE_STATS_NFUNCS; i++)
+    {
+      stats = &g_work_stats[index];
+      if (stats->worker == worker || stats->worker == NULL)
+        {
+          stats->worker   = worker;
+          stats->count++;
+          stats->latency += latency;
+          stats->runtime += runtime;
+
+          if (latency > stats->latency_max)
+            {
+              stats->latency_max = latency;
+            }
+
+          if (runtime > stats->runtime_max)
+            {
+              stats->runtime_max = runtime;
+            }
+
+          break;
+        }
+
+      if (++index >= CONFIG_SCHED_WORKQUEUE_STATS_NFUNCS)
+        {
+          index = 0;
+        }
+    }
+
+  spin_unlock_irqrestore(&g_work_stats_lock, flags);
+}
+
+#endif /* CONFIG_SCHED_WORKQUEUE_STATS */
@@ -74,6 +74,15 @@
 #  define CALL_WORKER(worker, arg) worker(arg)
 #endif
 
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int work_thread(int argc, FAR char *argv[]);
+#if CONFIG_SCHED_WORKQUEUE_DYNAMIC > 0
+static int work_manager(int argc, FAR char *argv[]);
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -116,6 +125,207 @@ struct lp_wqueue_s g_lpwork =
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: work_spawn_reserve
+ *
+ * Description:
+ *   Called with the queue locked by the manager of the queue.  If no
+ *   worker is left waiting for work, reserve a free worker slot for an
+ *   extra worker, so that the work queued while the busy workers run (and
+ *   possibly block) still finds a worker.
+ *
+ * Returned Value:
+ *   The reserved worker slot, or NULL if no worker is needed or the limit
+ *   of extra workers is reached.
+ *
+ ****************************************************************************/
+
+#if CONFIG_SCHED_WORKQUEUE_DYNAMIC > 0
+static FAR struct kworker_s *
+work_spawn_reserve(FAR struct kwork_wqueue_s *wqueue)
+{
+  FAR struct kworker_s *worker = wq_get_worker(wqueue);
+  int wndx;
+
+  if (wqueue->nidle > 0 || wqueue->exit ||
+      wqueue->ndynamic >= CONFIG_SCHED_WORKQUEUE_DYNAMIC)
+    {
+      return NULL;
+    }
+
+  for (wndx = wqueue->nthreads; wndx < WORK_NWORKERS(wqueue->nthreads);
+       wndx++)
+    {
+      if (worker[wndx].pid == 0)
+        {
+          /* Mark the slot as taken until the thread is created */
+
+          worker[wndx].pid = -1;
+          wqueue->ndynamic++;
+          return &worker[wndx];
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: work_spawn
+ *
+ * Description:
+ *   Create an extra worker thread for the reserved slot.  The new worker
+ *   inherits the name, base priority and stack size of the first worker.
+ *
+ ****************************************************************************/
+
+static void work_spawn(FAR struct kwork_wqueue_s *wqueue,
+                       FAR struct kworker_s *kworker)
+{
+  FAR struct kworker_s *worker = wq_get_worker(wqueue);
+  FAR struct tcb_s *rtcb = nxsched_get_tcb(worker[0].pid);
+  FAR char *argv[3];
+  irqstate_t flags;
+  char arg0[32];
+  char arg1[32];
+  pid_t pid;
+
+  nxsem_init(&kworker->wait, 0, 0);
+  kworker->wait_count = 0;
+
+  snprintf(arg0, sizeof(arg0), "%p", wqueue);
+  snprintf(arg1, sizeof(arg1), "%p", kworker);
+  argv[0] = arg0;
+  argv[1] = arg1;
+  argv[2] = NULL;
+
+  sched_lock();
+  if (rtcb == NULL)
+    {
+      pid = -ESRCH;
+    }
+  else
+    {
+#if CONFIG_TASK_NAME_SIZE > 0
+      pid = kthread_create(rtcb->name, rtcb->init_priority,
+                           rtcb->adj_stack_size, work_thread, argv);
+#else
+      pid = kthread_create(NULL, rtcb->init_priority,
+                           rtcb->adj_stack_size, work_thread, argv);
+#endif
+    }
+
+  if (pid > 0)
+    {
+      kworker->pid = pid;
+      sched_unlock();
+      return;
+    }
+
+  sched_unlock();
+
+  /* Give the slot back.  work_queue_free() may already count on this
+   * worker to exit, so answer for it.
+   */
+
+  serr("ERROR: Failed to spawn a worker: %d\n", pid);
+  nxsem_destroy(&kworker->wait);
+
+  flags = spin_lock_irqsave(&wqueue->lock);
+  kworker->pid = 0;
+  wqueue->ndynamic--;
+  if (wqueue->exit)
+    {
+      nxsem_post(&wqueue->exsem);
+    }
+
+  spin_unlock_irqrestore(&wqueue->lock, flags);
+}
+
+/****************************************************************************
+ * Name: work_retire
+ *
+ * Description:
+ *   Called by an extra worker that has been idle for
+ *   CONFIG_SCHED_WORKQUEUE_IDLE_MS.  The worker exits if another worker is
+ *   still waiting for work.
+ *
+ * Returned Value:
+ *   true if the worker must exit.
+ *
+ ****************************************************************************/
+
+static bool work_retire(FAR struct kwork_wqueue_s *wqueue,
+                        FAR struct kworker_s *kworker)
+{
+  irqstate_t flags;
+  bool retire = false;
+
+  flags = spin_lock_irqsave(&wqueue->lock);
+  if (!wqueue->exit && wqueue->nidle > 1)
+    {
+      wqueue->nidle--;
+      wqueue->ndynamic--;
+      kworker->pid = 0;
+      retire = true;
+    }
+
+  spin_unlock_irqrestore(&wqueue->lock, flags);
+
+  if (retire)
+    {
+      nxsem_destroy(&kworker->wait);
+    }
+
+  return retire;
+}
+
+/****************************************************************************
+ * Name: work_manager
+ *
+ * Description:
+ *   The manager of a work queue adds the extra workers, so that the busy
+ *   workers never pay for the thread creation.  A worker that takes the
+ *   last idle slot only wakes it up.  The manager runs at the priority of
+ *   the workers, so unless another CPU is free it only gets to run once
+ *   the busy worker blocks or finishes, and it checks again whether a
+ *   worker is still missing before it creates one.
+ *
+ * Input Parameters:
+ *   argc, argv
+ *
+ * Returned Value:
+ *   Does not return until the queue is freed
+ *
+ ****************************************************************************/
+
+static int work_manager(int argc, FAR char *argv[])
+{
+  FAR struct kwork_wqueue_s *wqueue;
+  FAR struct kworker_s *spawn;
+  irqstate_t flags;
+
+  wqueue = (FAR struct kwork_wqueue_s *)
+           ((uintptr_t)strtoul(argv[1], NULL, 16));
+
+  while (!wqueue->exit)
+    {
+      nxsem_wait_uninterruptible(&wqueue->spawnsem);
+
+      flags = spin_lock_irqsave(&wqueue->lock);
+      spawn = work_spawn_reserve(wqueue);
+      spin_unlock_irqrestore(&wqueue->lock, flags);
+
+      if (spawn != NULL)
+        {
+          work_spawn(wqueue, spawn);
+        }
+    }
+
+  nxsem_post(&wqueue->exsem);
+  return OK;
+}
+#endif
+
 static inline_function
 void work_dispatch(FAR struct kwork_wqueue_s *wq)
 {
@@ -191,6 +401,15 @@ static int work_thread(int argc, FAR char *argv[])
   worker_t      worker;
   irqstate_t    flags;
   FAR void     *arg;
+#if CONFIG_SCHED_WORKQUEUE_DYNAMIC > 0
+  bool          dynamic;
+  int           sval;
+  bool          idle = false;
+#endif
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+  clock_t       latency;
+  clock_t       start;
+#endif
 
   /* Get the handle from argv */
 
@@ -199,6 +418,10 @@ static int work_thread(int argc, FAR char *argv[])
   kworker = (FAR struct kworker_s *)
             ((uintptr_t)strtoul(argv[2], NULL, 16));
 
+#if CONFIG_SCHED_WORKQUEUE_DYNAMIC > 0
+  dynamic = kworker >= wq_get_worker(wqueue) + wqueue->nthreads;
+#endif
+
   /* Loop until wqueue->exit != 0.
    * Since the only way to set wqueue->exit is to call work_queue_free(),
    * there is no need for entering the critical section.
@@ -213,6 +436,14 @@ static int work_thread(int argc, FAR char *argv[])
 
        flags = spin_lock_irqsave_nopreempt(&wqueue->lock);
 
+#if CONFIG_SCHED_WORKQUEUE_DYNAMIC > 0
+      if (idle)
+        {
+          wqueue->nidle--;
+          idle = false;
+        }
+#endif
+
       /* If the wqueue timer is expired and non-active, it indicates that
        * there might be expired work in the pending queue.
        */
@@ -238,6 +469,14 @@ static int work_thread(int argc, FAR char *argv[])
 
           arg = work->arg;
 
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+          latency = clock_systime_ticks() - work->qtime;
+          if ((sclock_t)latency < 0)
+            {
+              latency = 0;
+            }
+#endif
+
           /* Return the work structure ownership to the work owner. */
 
           work->worker = NULL;
@@ -246,13 +485,32 @@ static int work_thread(int argc, FAR char *argv[])
 
           kworker->work = work;
 
+#if CONFIG_SCHED_WORKQUEUE_DYNAMIC > 0
+          /* Nobody else is waiting for work: ask the manager for a worker
+           * for the work that may be queued while this one runs.
+           */
+
+          if (wqueue->nidle == 0 &&
+              wqueue->ndynamic < CONFIG_SCHED_WORKQUEUE_DYNAMIC &&
+              nxsem_get_value(&wqueue->spawnsem, &sval) >= 0 && sval <= 0)
+            {
+              nxsem_post(&wqueue->spawnsem);
+            }
+#endif
+
           spin_unlock_irqrestore_nopreempt(&wqueue->lock, flags);
 
           /* Do the work.  Re-enable interrupts while the work is being
            * performed... we don't have any idea how long this will take!
            */
 
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+          start = perf_gettime();
+          CALL_WORKER(worker, arg);
+          work_stats_update(worker, latency, perf_gettime() - start);
+#else
           CALL_WORKER(worker, arg);
+#endif
           flags = spin_lock_irqsave_nopreempt(&wqueue->lock);
 
           /* Mark the thread un-busy */
@@ -268,11 +526,32 @@ static int work_thread(int argc, FAR char *argv[])
             }
         }
 
+#if CONFIG_SCHED_WORKQUEUE_DYNAMIC > 0
+      wqueue->nidle++;
+      idle = true;
+#endif
+
       spin_unlock_irqrestore_nopreempt(&wqueue->lock, flags);
 
       /* Wait for the semaphore to be posted by the wqueue timer. */
 
-      nxsem_wait_uninterruptible(&wqueue->sem);
+#if CONFIG_SCHED_WORKQUEUE_DYNAMIC > 0
+      if (dynamic)
+        {
+          /* Extra workers exit once they are no longer needed */
+
+          if (nxsem_tickwait_uninterruptible(&wqueue->sem,
+                MSEC2TICK(CONFIG_SCHED_WORKQUEUE_IDLE_MS)) == -ETIMEDOUT &&
+              work_retire(wqueue, kworker))
+            {
+              return OK;
+            }
+        }
+      else
+#endif
+        {
+          nxsem_wait_uninterruptible(&wqueue->sem);
+        }
     }
 
   nxsem_post(&wqueue->exsem);
@@ -339,6 +618,26 @@ static int work_thread_create(FAR const char *name, int priority,
       worker[wndx].pid = pid;
     }
 
+#if CONFIG_SCHED_WORKQUEUE_DYNAMIC > 0
+  /* Start the manager that adds the extra workers */
+
+  nxsem_init(&wqueue->spawnsem, 0, 0);
+
+  snprintf(arg0, sizeof(arg0), "%p", wqueue);
+  argv[0] = arg0;
+  argv[1] = NULL;
+
+  pid = kthread_create(name, priority, stack_size, work_manager, argv);
+
+  DEBUGASSERT(pid > 0);
+  if (pid < 0)
+    {
+      serr("ERROR: work_thread_create manager failed: %d\n", pid);
+      sched_unlock();
+      return pid;
+    }
+#endif
+
   sched_unlock();
   return OK;
 }
@@ -406,7 +705,7 @@ FAR struct kwork_wqueue_s *work_queue_create(FAR const char *name,
   /* Allocate a new work queue */
 
   wqueue = kmm_zalloc(sizeof(struct kwork_wqueue_s) +
-                      nthreads * sizeof(struct kworker_s));
+                      WORK_NWORKERS(nthreads) * sizeof(struct kworker_s));
   if (wqueue == NULL)
     {
       return NULL;
@@ -452,6 +751,8 @@ FAR struct kwork_wqueue_s *work_queue_create(FAR const char *name,
 
 int work_queue_free(FAR struct kwork_wqueue_s *wqueue)
 {
+  irqstate_t flags;
+  int nthreads;
   int wndx;
 
   if (wqueue == NULL)
@@ -463,22 +764,38 @@ int work_queue_free(FAR struct kwork_wqueue_s *wqueue)
 
   /* Mark the work queue as exiting */
 
+  flags = spin_lock_irqsave(&wqueue->lock);
   wqueue->exit = true;
+  nthreads = wqueue->nthreads;
+#if CONFIG_SCHED_WORKQUEUE_DYNAMIC > 0
+  nthreads += wqueue->ndynamic;
+#endif
+  spin_unlock_irqrestore(&wqueue->lock, flags);
 
   /* Queue a exit work for all threads */
 
-  for (wndx = 0; wndx < wqueue->nthreads; wndx++)
+  for (wndx = 0; wndx < nthreads; wndx++)
     {
       nxsem_post(&wqueue->sem);
     }
 
-  for (wndx = 0; wndx < wqueue->nthreads; wndx++)
+#if CONFIG_SCHED_WORKQUEUE_DYNAMIC > 0
+  /* And stop the manager */
+
+  nxsem_post(&wqueue->spawnsem);
+  nthreads++;
+#endif
+
+  for (wndx = 0; wndx < nthreads; wndx++)
     {
       nxsem_wait_uninterruptible(&wqueue->exsem);
     }
 
   nxsem_destroy(&wqueue->sem);
   nxsem_destroy(&wqueue->exsem);
+#if CONFIG_SCHED_WORKQUEUE_DYNAMIC > 0
+  nxsem_destroy(&wqueue->spawnsem);
+#endif
   kmm_free(wqueue);
 
   return OK;
@@ -48,6 +48,16 @@
 #define HPWORKNAME "hpwork"
 #define LPWORKNAME "lpwork"
 
+#ifndef CONFIG_SCHED_WORKQUEUE_DYNAMIC
+#  define CONFIG_SCHED_WORKQUEUE_DYNAMIC 0
+#endif
+
+/* Number of worker slots of a queue with nthreads fixed workers; the extra
+ * slots are used by the workers spawned on demand.
+ */
+
+#define WORK_NWORKERS(nthreads) ((nthreads) + CONFIG_SCHED_WORKQUEUE_DYNAMIC)
+
 /* Get the worker structure from the work queue.
  * This function requires the workers are located next to the wqueue.
  */
@@ -79,10 +89,31 @@ struct kwork_wqueue_s
   sem_t            exsem;     /* Sync waiting for thread exit */
   spinlock_t       lock;      /* Spinlock */
   uint8_t          nthreads;  /* Number of worker threads */
+#if CONFIG_SCHED_WORKQUEUE_DYNAMIC > 0
+  uint8_t          nidle;     /* Number of workers waiting for work */
+  uint8_t          ndynamic;  /* Number of extra workers spawned */
+#endif
   bool             exit;      /* A flag to request the thread to exit */
   struct wdog_s    timer;     /* Timer to pending. */
+#if CONFIG_SCHED_WORKQUEUE_DYNAMIC > 0
+  sem_t            spawnsem;  /* Wakes up the manager to add a worker */
+#endif
 };
 
+/* Run-time statistics of one work function */
+
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+struct work_stats_s
+{
+  worker_t         worker;      /* The work function, NULL if unused */
+  uint32_t         count;       /* Number of times the function ran */
+  clock_t          latency;     /* Total ticks from due time to start */
+  clock_t          latency_max; /* Longest time from due time to start */
+  clock_t          runtime;     /* Total perf counts spent running */
+  clock_t          runtime_max; /* Longest run in perf counts */
+};
+#endif
+
 /* This structure defines the state of one high-priority work queue.  This
  * structure must be cast-compatible with kwork_wqueue_s.
  */
@@ -94,7 +125,7 @@ struct hp_wqueue_s
 
   /* Describes each thread in the high priority queue's thread pool */
 
-  struct kworker_s      worker[CONFIG_SCHED_HPNTHREADS];
+  struct kworker_s      worker[WORK_NWORKERS(CONFIG_SCHED_HPNTHREADS)];
 };
 #endif
 
@@ -109,7 +140,7 @@ struct lp_wqueue_s
 
   /* Describes each thread in the low priority queue's thread pool */
 
-  struct kworker_s      worker[CONFIG_SCHED_LPNTHREADS];
+  struct kworker_s      worker[WORK_NWORKERS(CONFIG_SCHED_LPNTHREADS)];
 };
 #endif
 
@@ -129,6 +160,13 @@ extern struct hp_wqueue_s g_hpwork;
 extern struct lp_wqueue_s g_lpwork;
 #endif
 
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+/* The statistics of the work functions, protected by g_work_stats_lock */
+
+extern struct work_stats_s g_work_stats[CONFIG_SCHED_WORKQUEUE_STATS_NFUNCS];
+extern spinlock_t g_work_stats_lock;
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -338,5 +376,22 @@ int work_start_lowpri(void);
 void work_initialize_notifier(void);
 #endif
 
+/****************************************************************************
+ * Name: work_stats_update
+ *
+ * Description:
+ *   Account one run of a work function.
+ *
+ * Input Parameters:
+ *   worker  - The work function
+ *   latency - Ticks from the due time of the work until it started
+ *   runtime - Perf counts the work function ran
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+void work_stats_update(worker_t worker, clock_t latency, clock_t runtime);
+#endif
+
 #endif /* CONFIG_SCHED_WORKQUEUE */
 #endif /* __SCHED_WQUEUE_WQUEUE_H */
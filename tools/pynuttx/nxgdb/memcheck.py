@@ -88,25 +88,11 @@ class MMCheck(gdb.Command):
                         f"flink not intact: {hex(node.flink.blink)}, node: {hex(node.address)}",
                     )
 
-                if node.blink.flink != node:
+                if node.blink and node.blink.flink != node:
                     return (
                         True,
                         f"blink not intact: {hex(node.blink.flink)}, node: {hex(node.address)}",
                     )
-
-                # Node should be in correctly sorted order
-                if (blinksize := mm.MMNode(node.blink).nodesize) > node.nodesize:
-                    return (
-                        True,
-                        f"blink node not in sorted order: {blinksize} > {node.nodesize}",
-                    )
-
-                fnode = mm.MMNode(node.flink) if node.flink else None
-                if fnode and fnode.nodesize and fnode.nodesize < node.nodesize:
-                    return (
-                        True,
-                        f"flink node not in sorted order: {fnode.nodesize} < {node.nodesize}",
-                    )
             else:
                 # Node is allocated.
                 if node.nodesize < node.MM_SIZEOF_ALLOCNODE:
@@ -122,9 +108,10 @@ class MMCheck(gdb.Command):
                     issues[node.address].append(reason)
 
             # Check free list
-            for node in utils.ArrayIterator(heap.mm_nodelist):
-                # node is in type of gdb.Value, struct mm_freenode_s
-                while node:
+            for head in utils.ArrayIterator(heap.mm_freelist):
+                # head is in type of gdb.Value, struct mm_freenode_s *
+                node = head.dereference() if head else None
+                while node is not None:
                     address = int(node.address)
                     if node["flink"] and not heap.contains(node["flink"]):
                         issues[address].append(
@@ -132,19 +119,15 @@ class MMCheck(gdb.Command):
                         )
                         break
 
-                    if address in issues or node["size"] == 0:
-                        # This node is already checked or size is 0, which is a node in node table
-                        node = node["flink"]
-                        continue
-
-                    # Check if this node is corrupted
-                    corrupted, reason = is_node_corrupted(mm.MMNode(node))
-                    if corrupted:
-                        issues[address].append(reason)
-                        break
+                    if address not in issues:
+                        # Check if this node is corrupted
+                        corrupted, reason = is_node_corrupted(mm.MMNode(node))
+                        if corrupted:
+                            issues[address].append(reason)
+                            break
 
                     # Continue to it's flink
-                    node = node["flink"]
+                    node = node["flink"].dereference() if node["flink"] else None
 
         except Exception as e:
             report(e, heap, node)
@@ -227,9 +227,16 @@ class MemPool(Value, p.MemPool):
             -int(self.waitsem.val.semcount) if self.wait and self.expandsize == 0 else 0
         )
 
+    @property
+    def ncached(self) -> int:
+        """Free blocks held by the per-CPU caches"""
+        if not utils.has_field(self, "cache"):
+            return 0
+        return sum(int(cache["nfree"]) for cache in utils.ArrayIterator(self.cache))
+
     @property
     def nused(self) -> int:
-        return int(self.nalloc)
+        return int(self.nalloc) - self.ncached
 
     @property
     def free(self) -> int:
@@ -238,7 +245,7 @@ class MemPool(Value, p.MemPool):
     @property
     def nfree(self) -> int:
         if not self._nfree:
-            self._nfree = lists.sq_count(self.queue)
+            self._nfree = lists.sq_count(self.queue) + self.ncached
         return self._nfree + self.nifree
 
     @property
@@ -332,6 +339,13 @@ class MemPool(Value, p.MemPool):
         for entry in lists.NxSQueue(self.queue):
             yield MemPoolBlock(int(entry), blocksize, self.overhead)
 
+        if utils.has_field(self, "cache"):
+            for cache in utils.ArrayIterator(self.cache):
+                entry = cache["head"]
+                while entry:
+                    yield MemPoolBlock(int(entry), blocksize, self.overhead)
+                    entry = entry["flink"]
+
     def blks_used(self) -> Generator[MemPoolBlock, None, None]:
         """Iterate over all used blocks in the pool"""
         return filter(lambda blk: not blk.is_free, self.blks)
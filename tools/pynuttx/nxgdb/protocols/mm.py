@@ -67,7 +67,9 @@ class MMHeap(Value):
     mm_heapstart: List[MMAllocNode]
     mm_heapend: List[MMAllocNode]
     mm_nregions: Value
-    mm_nodelist: Value
+    mm_flbitmap: Value
+    mm_slbitmap: Value
+    mm_freelist: List[MMFreeNode]
 
 
 class MemPool(Value):
@@ -88,6 +90,7 @@ class MemPool(Value):
     nalloc: Value
     lock: Value
     waitsem: Value
+    cache: Value
     procfs: Value
 
 
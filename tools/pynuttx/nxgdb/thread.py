@@ -423,6 +423,8 @@ class TaskSchedPolicy(Enum):
     FIFO = 0
     RR = 1
     SPORADIC = 2
+    DEADLINE = 3
+    FAIR = 4
 
 
 class TaskState(Enum):
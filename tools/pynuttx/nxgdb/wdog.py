@@ -49,11 +49,25 @@ class WDog(Value, p.WDog):
 
 def get_wdog_list() -> List[WDog]:
     wdogs = []
-    active = utils.parse_and_eval("g_wdactivelist")
-    for wdog in lists.NxList(active, "struct wdog_s", "node"):
-        wdogs.append(WDog(wdog))
+    active = utils.gdb_eval_or_none("g_wdactivelist")
+    if active is not None:
+        for wdog in lists.NxList(active, "struct wdog_s", "node"):
+            wdogs.append(WDog(wdog))
 
-    return wdogs
+        return wdogs
+
+    # CONFIG_WDOG_TIMER_WHEEL: walk the busy slots of every level
+
+    wheel = utils.parse_and_eval("g_wdwheel")
+    for level in range(utils.nitems(wheel["map"])):
+        busy = int(wheel["map"][level])
+        for index in range(utils.nitems(wheel["slot"][level])):
+            if busy & (1 << index):
+                slot = wheel["slot"][level][index]
+                for wdog in lists.NxList(slot, "struct wdog_s", "node"):
+                    wdogs.append(WDog(wdog))
+
+    return sorted(wdogs, key=lambda wdog: int(wdog.expired))
 
 
 class WDogDump(gdb.Command):